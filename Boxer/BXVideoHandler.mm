@@ -309,10 +309,29 @@
                 currentOffset += regionLength;
                 i++;
             }
+            
+            //DOSBox also tracks which tiles of those lines actually changed,
+            //so that partial updates can skip the parts of each line that didn't.
+            Bitu tilesAcross, tilesDown, tileSize;
+            const Bit8u *dirtyTiles = RENDER_GetDirtyTiles(&tilesAcross, &tilesDown, &tileSize);
+            if (dirtyTiles)
+            {
+                [self.currentFrame setNeedsDisplayInTiles: dirtyTiles
+                                                   across: tilesAcross
+                                                     down: tilesDown
+                                                 tileSize: tileSize];
+            }
         }
         
-        self.currentFrame.timestamp = CFAbsoluteTimeGetCurrent();
-        [self.emulator _didFinishFrame: self.currentFrame];
+        //Frames that DOSBox redrew without anything in them changing, e.g. after
+        //clearing its caches, don't need passing on: the last one still stands.
+        NSUInteger generation = RENDER_GetFrameGeneration(NULL);
+        if (!dirtyBlocks || generation != self.currentFrame.generation)
+        {
+            self.currentFrame.generation = generation;
+            self.currentFrame.timestamp = CFAbsoluteTimeGetCurrent();
+            [self.emulator _didFinishFrame: self.currentFrame];
+        }
 	}
     
 	_frameInProgress = NO;
@@ -63,12 +63,45 @@
         
         NSUInteger pitch = frame.pitch;
         GLsizei frameWidth = (GLsizei)frame.size.width;
-        NSUInteger i, numRegions = frame.numDirtyRegions;
+        NSUInteger i, numRegions = frame.numDirtyRegions, numRects = frame.numDirtyRects;
         
         CGLContextObj cgl_ctx = _context;
         
         glBindTexture(_type, _texture);
         
+        //If the frame knows which tiles of its dirty lines changed, upload just those:
+        //otherwise fall back on uploading each dirty line in its entirety.
+        if (numRects)
+        {
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, frameWidth);
+            
+            for (i=0; i < numRects; i++)
+            {
+                NSRect dirtyRect = [frame dirtyRectAtIndex: i];
+                NSUInteger rectOffset = (dirtyRect.origin.y * pitch) + (dirtyRect.origin.x * frame.bytesPerPixel);
+                
+                NSAssert2(rectOffset < frame.frameData.length,
+                          @"Dirty rect offset exceeded frame size: %lu (limit %lu)", (unsigned long)rectOffset, (unsigned long)frame.frameData.length);
+                
+                const void *rectBytes = frame.bytes + rectOffset;
+                
+                glTexSubImage2D(_type,
+                                0,                                  //Mipmap level
+                                (GLint)dirtyRect.origin.x,          //X offset
+                                (GLint)dirtyRect.origin.y,          //Y offset
+                                (GLsizei)dirtyRect.size.width,      //Width
+                                (GLsizei)dirtyRect.size.height,     //Height
+                                GL_BGRA,                            //Byte ordering
+                                GL_UNSIGNED_INT_8_8_8_8_REV,        //Byte packing
+                                rectBytes);                         //Texture data
+            }
+            
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            
+            //The rects already cover everything that changed in the dirty lines.
+            numRegions = 0;
+        }
+        
         for (i=0; i < numRegions; i++)
         {
             NSRange dirtyRegion = [frame dirtyRegionAtIndex: i];
@@ -22,6 +22,10 @@ extern const CGFloat BX4by3AspectRatio;
 //This is set to the maximum vertical resolution expected from a DOS game.
 #define MAX_DIRTY_REGIONS 1024
 
+//The maximum number of rectangles that can be flagged as dirty. If the dirty tiles
+//of a frame would need more than this, the whole frame is flagged as dirty instead.
+#define MAX_DIRTY_RECTS 1024
+
 @interface BXVideoFrame : NSObject
 {
 	NSMutableData *_frameData;
@@ -34,7 +38,11 @@ extern const CGFloat BX4by3AspectRatio;
     NSRange _dirtyRegions[MAX_DIRTY_REGIONS];
     NSUInteger _numDirtyRegions;
     
+    NSRect _dirtyRects[MAX_DIRTY_RECTS];
+    NSUInteger _numDirtyRects;
+    
     NSTimeInterval _timestamp;
+    NSUInteger _generation;
 }
 
 #pragma mark -
@@ -77,6 +85,12 @@ extern const CGFloat BX4by3AspectRatio;
 //The absolute time which this frame represents. Updated each time a frame update is completed by the emulator.
 @property (assign) CFAbsoluteTime timestamp;
 
+//The emulator's content generation for this frame. This only changes when a finished
+//frame actually looks different from the one before it, so consumers can skip any
+//frame whose generation they have already seen without comparing its pixels.
+//0 for a frame the emulator hasn't finished yet.
+@property (assign) NSUInteger generation;
+
 //Read-only/mutable pointers to the frame's data.
 @property (readonly) NSMutableData *frameData;
 @property (readonly) const void *bytes;
@@ -86,6 +100,10 @@ extern const CGFloat BX4by3AspectRatio;
 //and reset to 0 by clearDirtyRegions. See the dirty region functions below.
 @property (readonly, assign) NSUInteger numDirtyRegions;
 
+//The number of dirty rectangles. Set by setNeedsDisplayInTiles:across:down:tileSize:
+//and reset to 0 by clearDirtyRegions. See the dirty tile functions below.
+@property (readonly, assign) NSUInteger numDirtyRects;
+
 
 #pragma mark -
 #pragma mark Class helpers
@@ -120,4 +138,21 @@ extern const CGFloat BX4by3AspectRatio;
 
 - (NSRange) dirtyRegionAtIndex: (NSUInteger)region;
 
+
+#pragma mark -
+#pragma mark Flagging tiles of the frame as dirty.
+
+//Flags the dirty tiles in the specified grid as needing display. The grid has a byte
+//for each tile, nonzero if the tile is dirty, in rows of tilesAcross tiles starting
+//from the top left of the frame; each tile is tileSize pixels square. Runs of dirty
+//tiles are merged into rectangles, which are clipped to the size of the frame.
+- (void) setNeedsDisplayInTiles: (const uint8_t *)tiles
+                         across: (NSUInteger)tilesAcross
+                           down: (NSUInteger)tilesDown
+                       tileSize: (NSUInteger)tileSize;
+
+//Returns a dirty rectangle in pixels, measured from the top left of the frame
+//the same way as the lines of the dirty regions.
+- (NSRect) dirtyRectAtIndex: (NSUInteger)rectIndex;
+
 @end
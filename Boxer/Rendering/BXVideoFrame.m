@@ -13,6 +13,7 @@ const CGFloat BX4by3AspectRatio = (CGFloat)320.0 / (CGFloat)240.0;
 
 @interface BXVideoFrame ()
 @property (readwrite, assign) NSUInteger numDirtyRegions;
+@property (readwrite, assign) NSUInteger numDirtyRects;
 @end
 
 @implementation BXVideoFrame
@@ -22,8 +23,10 @@ const CGFloat BX4by3AspectRatio = (CGFloat)320.0 / (CGFloat)240.0;
 @synthesize bytesPerPixel = _bytesPerPixel;
 @synthesize intendedScale = _intendedScale;
 @synthesize numDirtyRegions = _numDirtyRegions;
+@synthesize numDirtyRects = _numDirtyRects;
 @synthesize containsText = _containsText;
 @synthesize timestamp = _timestamp;
+@synthesize generation = _generation;
 
 
 + (NSSize) scalingFactorForSize: (NSSize)frameSize toAspectRatio: (CGFloat)aspectRatio
@@ -142,6 +145,7 @@ const CGFloat BX4by3AspectRatio = (CGFloat)320.0 / (CGFloat)240.0;
 - (void) clearDirtyRegions
 {
     self.numDirtyRegions = 0;
+    self.numDirtyRects = 0;
 }
 
 - (NSRange) dirtyRegionAtIndex: (NSUInteger)regionIndex
@@ -152,4 +156,91 @@ const CGFloat BX4by3AspectRatio = (CGFloat)320.0 / (CGFloat)240.0;
     return _dirtyRegions[regionIndex];
 }
 
+#pragma mark Tile-dirtying
+
+- (void) setNeedsDisplayInTiles: (const uint8_t *)tiles
+                         across: (NSUInteger)tilesAcross
+                           down: (NSUInteger)tilesDown
+                       tileSize: (NSUInteger)tileSize
+{
+    NSUInteger frameWidth = self.size.width, frameHeight = self.size.height;
+    NSUInteger numRects = 0;
+    
+    //The rectangles added for the previous row of tiles, which a run of tiles
+    //in this row can extend downwards if it covers exactly the same columns.
+    NSUInteger previousRowStart = 0, previousRowEnd = 0;
+    
+    NSUInteger row, column;
+    for (row = 0; row < tilesDown && row * tileSize < frameHeight; row++)
+    {
+        NSUInteger top = row * tileSize;
+        NSUInteger height = MIN(tileSize, frameHeight - top);
+        NSUInteger rowStart = numRects;
+        
+        const uint8_t *rowTiles = tiles + (row * tilesAcross);
+        for (column = 0; column < tilesAcross; column++)
+        {
+            if (!rowTiles[column]) continue;
+            
+            NSUInteger firstColumn = column;
+            while (column + 1 < tilesAcross && rowTiles[column + 1]) column++;
+            
+            NSUInteger left = firstColumn * tileSize;
+            if (left >= frameWidth) break;
+            NSUInteger width = MIN((column + 1) * tileSize, frameWidth) - left;
+            
+            BOOL extended = NO;
+            NSUInteger i;
+            for (i = previousRowStart; i < previousRowEnd; i++)
+            {
+                NSRect *previous = &_dirtyRects[i];
+                if (previous->origin.x == left && previous->size.width == width)
+                {
+                    previous->size.height += height;
+                    extended = YES;
+                    break;
+                }
+            }
+            if (extended) continue;
+            
+            //If there are too many separate changes to track, just redraw everything.
+            if (numRects == MAX_DIRTY_RECTS)
+            {
+                _dirtyRects[0] = NSMakeRect(0, 0, frameWidth, frameHeight);
+                self.numDirtyRects = 1;
+                return;
+            }
+            
+            _dirtyRects[numRects++] = NSMakeRect(left, top, width, height);
+        }
+        
+        //Rectangles that were extended down into this row can be extended again by the next.
+        //Shuffle them to the end of the list alongside this row's new ones.
+        NSUInteger i, kept = rowStart;
+        for (i = previousRowEnd; i > previousRowStart; i--)
+        {
+            NSRect rect = _dirtyRects[i - 1];
+            if (NSMaxY(rect) == top + height)
+            {
+                //Swapping keeps the list complete: only the order changes.
+                kept--;
+                _dirtyRects[i - 1] = _dirtyRects[kept];
+                _dirtyRects[kept] = rect;
+            }
+        }
+        previousRowStart = kept;
+        previousRowEnd = numRects;
+    }
+    
+    self.numDirtyRects = numRects;
+}
+
+- (NSRect) dirtyRectAtIndex: (NSUInteger)rectIndex
+{
+    NSAssert1(rectIndex < self.numDirtyRects,
+              @"dirtyRectAtIndex: called with index out of range: %lu", (unsigned long)rectIndex);
+    
+    return _dirtyRects[rectIndex];
+}
+
 @end
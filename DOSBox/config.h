@@ -40,6 +40,12 @@ This means that this file has had too many modifications to be safely replaceabl
 /* #undef C_CORE_INLINE */
 #define C_CORE_INLINE 1
 
+//--Added 2026-10-17 for computed goto dispatch:
+/* Define to 1 to dispatch opcodes in the normal cpu core through a table of
+   computed gotos instead of a switch. Ignored by compilers that lack them. */
+/* #undef C_CORE_NORMAL_GOTO */
+//--End of modifications
+
 /* Define to 1 to enable internal debugger, requires libcurses */
 /* #undef C_DEBUG */
 
@@ -70,8 +76,10 @@ This means that this file has had too many modifications to be safely replaceabl
 
 /* Define to 1 to use a x86 assembly fpu core */
 //--Modified 2009-02-26 by Alun Bestor to force this on for Intel
+//--Modified 2026-10-17 to only force it on for 32-bit Intel: the assembly core's inline asm
+//doesn't assemble for x86-64, so 64-bit builds use the C FPU core instead.
 
-#if defined(__i386__) || defined(__x86_64__)
+#if defined(__i386__)
 	#define C_FPU_X86 1
 #endif
 
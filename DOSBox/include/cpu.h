@@ -60,6 +60,42 @@ extern bool CPU_CycleAutoAdjust;
 extern bool CPU_SkipCycleAutoAdjust;
 extern Bitu CPU_AutoDetermineMode;
 
+//--Added 2026-10-17 for the closed-loop cycle governor (cycles=governed).
+//When enabled, Normal_Loop paces emulated milliseconds against a high-resolution host clock
+//and, whenever CPU_CycleAutoAdjust is on, steers CPU_CycleMax so that emulation takes up
+//CPU_CyclePercUsed percent of host time.
+extern bool CPU_CycleGoverned;
+//Cycles skipped while the CPU was halted, which the governor doesn't count as work done.
+extern Bit64s CPU_HaltedCyclesSkipped;
+
+struct CPU_GovernorState {
+	bool active;		//Whether the governor is pacing and adjusting the cycles
+	double target;		//The share of host time we're aiming to spend emulating (0.0-1.0)
+	double measured;	//The smoothed share of host time we actually spent emulating
+	double error;		//The difference between the two, as log(target/measured)
+	Bit32s cycles;		//The current cycles per emulated millisecond
+	Bitu updates;		//How many times the governor has measured and adjusted so far
+};
+void CPU_GetGovernorState(CPU_GovernorState * state);
+//--End of modifications
+
+//--Added 2026-10-17 to report how well the dynamic core's code cache is coping with its workload.
+//When the cache is full, the least recently run code pages are evicted to make room; lots of
+//retranslations mean the cache is too small for the program being run (see [cpu] dynamic_cache).
+#if (C_DYNREC)
+struct CPU_DynamicCacheStats {
+	Bitu size;				//The size of the code cache in bytes, or 0 if it has not been allocated
+	Bitu pages;				//How many guest code pages the cache can hold at once
+	Bit64u translations;	//How many code blocks have been translated
+	Bit64u retranslations;	//How many of those had been translated before and were evicted
+	Bit64u evicted_blocks;	//How many translated code blocks have been evicted to make room
+	Bit64u evicted_pages;	//How many code pages have been evicted to make room
+	Bit64u superblocks;		//How many frequently-run blocks have been retranslated as superblocks
+};
+void CPU_GetDynamicCacheStats(CPU_DynamicCacheStats * stats);
+#endif
+//--End of modifications
+
 extern Bitu CPU_ArchitectureType;
 
 extern Bitu CPU_PrefetchQueueSize;
@@ -84,6 +120,24 @@ void CPU_Enable_SkipAutoAdjust(void);
 void CPU_Disable_SkipAutoAdjust(void);
 void CPU_Reset_AutoAdjust(void);
 
+//--Added 2026-10-17 for host-idle detection.
+//Whether [cpu] idleskip is on. When it is off, busy-waiting guests are left to spin as usual.
+extern bool CPU_IdleSkip;
+//Skips up to the specified number of cycles of the current slice (or all of them if 0),
+//for use when the guest is provably busy-waiting on something that cannot change before
+//then: i.e. the same loop is polling over and over with nothing else going on in it.
+//Emulated time fast-forwards to the next PIC event, leaving the host to sleep until
+//realtime catches up. Skipped cycles count towards CPU_IODelayRemoved, so that the cycle
+//auto-adjusters don't mistake them for cheap work.
+//Does nothing unless CPU_IdleSkip is on.
+void CPU_SkipIdleCycles(Bits cycles=0);
+//For guests that look like they are busy-waiting, but might be counting or doing anything
+//else in the loop (e.g. timing the CPU's speed). Emulated time runs on as usual, but the
+//host sleeps a little once per tick, which lets auto-adjusted cycles settle lower.
+//Does nothing unless CPU_IdleSkip is on.
+void CPU_IdleHost(void);
+//--End of modifications
+
 
 //CPU Stuff
 
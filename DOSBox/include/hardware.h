@@ -50,6 +50,9 @@ void CAPTURE_AddWave(Bit32u freq, Bit32u len, Bit16s * data);
 #define CAPTURE_FLAG_DBLW	0x1
 #define CAPTURE_FLAG_DBLH	0x2
 void CAPTURE_AddImage(Bitu width, Bitu height, Bitu bpp, Bitu pitch, Bitu flags, float fps, Bit8u * data, Bit8u * pal);
+//--Added 2026-10-17 for asynchronous capture encoding
+void CAPTURE_GetEncoderStats(Bitu *queued, Bitu *stalls, Bitu *dropped);
+//--End of modifications
 void CAPTURE_AddMidi(bool sysex, Bitu len, Bit8u * data);
 
 #endif
@@ -27,6 +27,9 @@
 
 typedef void (*MIXER_MixHandler)(Bit8u * sampdate,Bit32u len);
 typedef void (*MIXER_Handler)(Bitu len);
+//--Added 2026-10-17 for sleeping silent channels
+typedef void (*MIXER_IdleHandler)(void);
+//--End of modifications
 
 enum BlahModes {
 	MIXER_8MONO,MIXER_8STEREO,
@@ -45,6 +48,10 @@ extern Bit8u MixTemp[MIXER_BUFSIZE];
 #define MAX_AUDIO ((1<<(16-1))-1)
 #define MIN_AUDIO -(1<<(16-1))
 
+//--Added 2026-10-17 for polyphase resampling
+struct MixerFIR;
+//--End of modifications
+
 class MixerChannel {
 public:
 	void SetVolume(float _left,float _right);
@@ -77,6 +84,24 @@ public:
 	void AddStretched(Bitu len,Bit16s * data);		//Strech block up into needed data
 	void FillUp(void);
 	void Enable(bool _yesno);
+	//--Added 2026-10-17 for sleeping silent channels
+	/* A channel that has mixed nothing but silence for ms milliseconds goes to sleep: it stops
+	   calling its handler and just fills up with silence until it gets woken up. Devices that
+	   set this must call WakeUp from their port write handlers. 0, the default, never sleeps.
+	   Devices that switch their channel off after a longer idle timeout check it in idle,
+	   which gets called instead of the handler every time a sleeping channel is mixed. */
+	void SetSleepDelay(Bitu ms,MIXER_IdleHandler _idle=0);
+	void WakeUp(void) {
+		sleeping=false;
+		silent=0;
+	}
+	//--End of modifications
+	//--Added 2026-10-17 for polyphase resampling
+	/* Resample with a band-limited polyphase filter instead of interpolating linearly, which
+	   costs more but doesn't alias. The [mixer] polyphase setting picks the channels that do. */
+	void SetPolyphase(bool _yesno);
+	~MixerChannel();
+	//--End of modifications
 	MIXER_Handler handler;
 	float volmain[2];
 	float scale;
@@ -86,6 +111,15 @@ public:
 	Bits last[2];
 	const char * name;
 	bool enabled;
+	//--Added 2026-10-17 for sleeping silent channels
+	Bitu sleep_after;	//Samples of silence before going to sleep, 0 to never sleep
+	Bitu silent;		//Samples of silence mixed in a row
+	bool sleeping;
+	MIXER_IdleHandler idle;	//Called while sleeping, 0 for none
+	//--End of modifications
+	//--Added 2026-10-17 for polyphase resampling
+	MixerFIR * fir;		//0 when resampling linearly
+	//--End of modifications
 	MixerChannel * next;
 };
 
@@ -94,6 +128,10 @@ MixerChannel * MIXER_FindChannel(const char * name);
 /* Find the device you want to delete with findchannel "delchan gets deleted" */
 void MIXER_DelChannel(MixerChannel* delchan); 
 
+//--Added 2026-10-17 for a lock-free mixer output
+void MIXER_GetBufferStats(Bitu *underruns, Bitu *overruns);
+//--End of modifications
+
 /* Object to maintain a mixerchannel; As all objects it registers itself with create
  * and removes itself when destroyed. */
 class MixerObject{
@@ -28,6 +28,13 @@ extern Bit32s CPU_CycleMax;
 typedef void (PIC_EOIHandler) (void);
 typedef void (* PIC_EventHandler)(Bitu val);
 
+//--Added 2026-10-17 to allow scheduled events to be cancelled individually.
+//A handle goes stale once its event has fired or been removed. Handles that have not been
+//given an event yet must hold PIC_NOEVENT, as 0 may be a live event.
+typedef Bitu PIC_EventHandle;
+#define PIC_NOEVENT ((PIC_EventHandle)~0)
+//--End of modifications
+
 
 #define PIC_MAXIRQ 15
 #define PIC_NOIRQ 0xFF
@@ -59,7 +66,11 @@ void PIC_runIRQs(void);
 bool PIC_RunQueue(void);
 
 //Delay in milliseconds
-void PIC_AddEvent(PIC_EventHandler handler,float delay,Bitu val=0);
+//--Modified 2026-10-17: now returns a handle for PIC_RemoveEvent, or PIC_NOEVENT if the queue is full.
+PIC_EventHandle PIC_AddEvent(PIC_EventHandler handler,float delay,Bitu val=0);
+//Returns false if the event had already fired or been removed.
+bool PIC_RemoveEvent(PIC_EventHandle handle);
+//--End of modifications
 void PIC_RemoveEvents(PIC_EventHandler handler);
 void PIC_RemoveSpecificEvents(PIC_EventHandler handler, Bitu val);
 
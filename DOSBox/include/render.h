@@ -29,7 +29,9 @@
 
 #define RENDER_SKIP_CACHE	16
 //Enable this for scalers to support 0 input for empty lines
-//#define RENDER_NULL_INPUT
+//--Modified 2026-10-17 for VRAM write tracking: the VGA code passes 0 for lines it skipped
+#define RENDER_NULL_INPUT
+//--End of modifications
 
 typedef struct {
 	struct { 
@@ -93,6 +95,15 @@ void RENDER_SetSize(Bitu width,Bitu height,Bitu bpp,float fps,double ratio,bool
 bool RENDER_StartUpdate(void);
 void RENDER_EndUpdate(bool abort);
 void RENDER_SetPal(Bit8u entry,Bit8u red,Bit8u green,Bit8u blue);
+//--Added 2026-10-17 for off-thread scaling
+void RENDER_WaitForFrames(void);
+//--End of modifications
+//--Added 2026-10-17 for dirty-tile tracking
+const Bit8u *RENDER_GetDirtyTiles(Bitu *across, Bitu *down, Bitu *tileSize);
+//--End of modifications
+//--Added 2026-10-17 for frame hashing
+Bitu RENDER_GetFrameGeneration(Bit64u *hash);
+//--End of modifications
 
 
 #endif
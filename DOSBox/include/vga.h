@@ -24,10 +24,16 @@
 #ifndef DOSBOX_DOSBOX_H
 #include "dosbox.h"
 #endif
+//--Added 2026-10-17 for the drawing events' handles
+#include "pic.h"
+//--End of modifications
 
 //Don't enable keeping changes and mapping lfb probably...
 #define VGA_LFB_MAPPED
-//#define VGA_KEEP_CHANGES
+//--Modified 2026-10-17 for VRAM write tracking: lines nothing has written to are skipped when
+//drawing. With the linear framebuffer mapped, the SVGA modes are still drawn completely.
+#define VGA_KEEP_CHANGES
+//--End of modifications
 #define VGA_CHANGE_SHIFT	9
 
 class PageHandler;
@@ -165,6 +171,19 @@ typedef struct {
 	} cursor;
 	Drawmode mode;
 	bool vret_triggered;
+	//--Added 2026-10-17 for per-cell text rendering
+	Bitu cell_changes;	/* counted up by every palette, font and text table change, to redraw text lines drawn before it */
+	//--End of modifications
+	//--Added 2026-10-17 to cancel the drawing events by handle. Each of these is only
+	//ever pending once at a time.
+	struct {
+		PIC_EventHandle setup;
+		PIC_EventHandle vertical_timer;
+		PIC_EventHandle display_start_latch,panning_latch;
+		PIC_EventHandle other_vert_interrupt[2];	/* at the end and the start of the retrace */
+		PIC_EventHandle draw;		/* VGA_DrawPart or VGA_DrawSingleLine */
+	} events;
+	//--End of modifications
 } VGA_Draw;
 
 typedef struct {
@@ -361,15 +380,18 @@ typedef struct {
 	Bit8u* linear_orgptr;
 } VGA_Memory;
 
+//--Modified 2026-10-17 for VRAM write tracking
 typedef struct {
-	//Add a few more just to be safe
-	Bit8u*	map; /* allocated dynamically: [(VGA_MEMORY >> VGA_CHANGE_SHIFT) + 32] */
-	Bit8u	checkMask, frame, writeMask;
-	bool	active;
-	Bit32u  clearMask;
-	Bit32u	start, last;
-	Bit32u	lastAddress;
+	Bit32u*	map;		/* allocated dynamically: the frame each block of video memory or fastmem was last written in */
+	Bit32u	mask;		/* offsets are wrapped to the blocks in the map with this */
+	Bit32u	frame;		/* the frame writes get marked with, counted up each frame drawn */
+	Bit32u	checkFrame;	/* lines with blocks written in this frame or since get drawn */
+	Bit32u	drawnFrame;	/* the last frame that got drawn completely */
+	bool	active;		/* whether the frame being drawn skips lines that weren't written */
+	bool	redraw;		/* set when something besides writes changes how lines look */
+	Bit32u	lastAddress, lastAddressLine, lastAddressAdd, lastSplit, lastMask;
 } VGA_Changes;
+//--End of modifications
 
 typedef struct {
 	Bit32u page;
@@ -449,6 +471,15 @@ void VGA_KillDrawing(void);
 
 extern VGA_Type vga;
 
+//--Added 2026-10-17 for VRAM write tracking
+#ifdef VGA_KEEP_CHANGES
+/* Marks the block of video memory or fastmem containing offset as written this frame */
+static INLINE void VGA_MarkChanged(Bitu offset) {
+	vga.changes.map[(offset & vga.changes.mask) >> VGA_CHANGE_SHIFT] = vga.changes.frame;
+}
+#endif
+//--End of modifications
+
 /* Support for modular SVGA implementation */
 /* Video mode extra data to be passed to FinishSetMode_SVGA().
    This structure will be in flux until all drivers (including S3)
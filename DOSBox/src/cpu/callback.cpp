@@ -70,8 +70,14 @@ void CALLBACK_Idle(void) {
 	reg_eip=oldeip;
 	SegSet16(cs,oldcs);
 	SETFLAGBIT(IF,oldIF);
-	if (!CPU_CycleAutoAdjust && CPU_Cycles>0) 
+	//--Modified 2026-10-17 to skip ahead to the next event under auto-adjusted cycles too when
+	//[cpu] idleskip is on: callers idle until an interrupt or a timeout, neither of which can
+	//happen before then. CPU_SkipIdleCycles keeps the skipped cycles from confusing the cycle
+	//auto-adjust.
+	if (CPU_IdleSkip) CPU_SkipIdleCycles();
+	else if (!CPU_CycleAutoAdjust && CPU_Cycles>0) 
 		CPU_Cycles=0;
+	//--End of modifications
 }
 
 static Bitu default_handler(void) {
@@ -53,14 +53,30 @@
 #include "lazyflags.h"
 #include "pic.h"
 
+//--Modified 2026-10-17 to make the size of the code cache configurable:
+//the number of code pages and cache blocks scale with it (512 and 128k for the default 8MB).
+static Bitu cache_size=1024*1024*8;
+
 #define CACHE_MAXSIZE	(4096*2)
-#define CACHE_TOTAL		(1024*1024*8)
-#define CACHE_PAGES		(512)
-#define CACHE_BLOCKS	(128*1024)
+#define CACHE_TOTAL		(cache_size)
+#define CACHE_PAGES		(cache_size/(16*1024))
+#define CACHE_BLOCKS	(cache_size/64)
+//--End of modifications
 #define CACHE_ALIGN		(16)
 #define DYN_HASH_SHIFT	(4)
 #define DYN_PAGE_HASH	(4096>>DYN_HASH_SHIFT)
 #define DYN_LINKS		(16)
+//--Added 2026-10-17 for superblock formation:
+//regular blocks use two links, superblocks use the other two for side exits
+#define DYN_BLOCK_LINKS	(4)
+//the number of times a block must be entered from the dispatcher before it is
+//retranslated as a superblock, and the maximal number of instructions in one
+#define DYN_SUPERBLOCK_THRESHOLD	(16)
+#define DYN_SUPERBLOCK_OPCODES		(48)
+
+//superblock formation can be turned off with the dynamic_superblocks setting
+static bool dyn_superblocks=true;
+//--End of modifications
 
 #if 0
 #define DYN_LOG	LOG_MSG
@@ -109,6 +125,9 @@ enum BlockReturn {
 	BR_Normal=0,
 	BR_Cycles,
 	BR_Link1,BR_Link2,
+	//--Added 2026-10-17 for the side exits of superblocks
+	BR_Link3,BR_Link4,
+	//--End of modifications
 	BR_Opcode,
 #if (C_DEBUG)
 	BR_OpcodeFull,
@@ -167,7 +186,12 @@ CacheBlockDynRec * LinkBlocks(BlockReturn ret) {
 		if (!block) return NULL;
 
 		// found it, link the current block to 
-		cache.block.running->LinkTo(ret==BR_Link2,block);
+		//--Modified 2026-10-17 for the side exits of superblocks
+		cache.block.running->LinkTo(ret-BR_Link1,block);
+		//--End of modifications
+		//--Added 2026-10-17 to keep track of recently used code pages
+		cache_touchpage(temp_handler);
+		//--End of modifications
 		return block;
 	}
 	return NULL;
@@ -224,7 +248,14 @@ Bits CPU_Core_Dynrec_Run(void) {
 				CPU_CycleLeft+=old_cycles;
 				return nc_retcode; 
 			}
+		//--Added 2026-10-17 to retranslate blocks that are entered often as superblocks
+		} else if (GCC_UNLIKELY(!block->profile.done) && (++block->profile.entries>=DYN_SUPERBLOCK_THRESHOLD)) {
+			block=CreateSuperBlock(chandler,ip_point,block);
+		//--End of modifications
 		}
+		//--Added 2026-10-17 to keep track of recently used code pages
+		cache_touchpage(chandler);
+		//--End of modifications
 
 run_block:
 		cache.block.running=0;
@@ -289,6 +320,10 @@ run_block:
 
 		case BR_Link1:
 		case BR_Link2:
+		//--Added 2026-10-17 for the side exits of superblocks
+		case BR_Link3:
+		case BR_Link4:
+		//--End of modifications
 			block=LinkBlocks(ret);
 			if (block) goto run_block;
 			break;
@@ -331,4 +366,21 @@ void CPU_Core_Dynrec_Cache_Close(void) {
 	cache_close();
 }
 
+//--Added 2026-10-17 to make the size of the code cache configurable and report on its use
+void CPU_Core_Dynrec_SetCacheSize(Bitu megabytes) {
+	// the cache can only be resized before it has been allocated
+	if (cache_code_start_ptr==NULL) cache_size=megabytes*1024*1024;
+}
+
+void CPU_Core_Dynrec_SetSuperblocks(bool enabled) {
+	dyn_superblocks=enabled;
+}
+
+void CPU_GetDynamicCacheStats(CPU_DynamicCacheStats * stats) {
+	*stats=cache_stats;
+	stats->size=(cache_code_start_ptr!=NULL) ? CACHE_TOTAL : 0;
+	stats->pages=(cache_code_start_ptr!=NULL) ? CACHE_PAGES : 0;
+}
+//--End of modifications
+
 #endif
@@ -53,8 +53,16 @@ public:
 		CacheBlockDynRec * to;		// this block can transfer control to the to-block
 		CacheBlockDynRec * next;
 		CacheBlockDynRec * from;	// the from-block can transfer control to this block
-	} link[2];	// maximal two links (conditional jumps)
+	//--Modified 2026-10-17 to give superblocks two more links for their side exits
+	} link[DYN_BLOCK_LINKS];	// maximal two links (conditional jumps) for regular blocks
+	//--End of modifications
 	CacheBlockDynRec * crossblock;
+	//--Added 2026-10-17 for superblock formation
+	struct {
+		Bitu entries;		// how often the block was entered from the dispatcher
+		bool done;			// the block is a superblock, or has been turned down as one
+	} profile;
+	//--End of modifications
 };
 
 static struct {
@@ -77,7 +85,30 @@ static Bit8u * cache_code=NULL;
 static Bit8u * cache_code_link_blocks=NULL;
 
 static CacheBlockDynRec * cache_blocks=NULL;
-static CacheBlockDynRec link_blocks[2];		// default linking (specially marked)
+static CacheBlockDynRec link_blocks[DYN_BLOCK_LINKS];		// default linking (specially marked)
+
+//--Added 2026-10-17 to count translations and evictions, so that the cache can be sized sensibly.
+static CPU_DynamicCacheStats cache_stats;
+
+// one bit for each DYN_HASH_SHIFT-sized chunk of physical memory, set when a block
+// starting in that chunk is evicted so that its retranslation can be counted
+static Bit8u * cache_evicted_map=NULL;
+static Bitu cache_evicted_map_size=0;
+
+static void cache_markevicted(Bitu phys_addr) {
+	Bitu chunk=phys_addr>>DYN_HASH_SHIFT;
+	if ((chunk>>3)<cache_evicted_map_size) cache_evicted_map[chunk>>3]|=(1<<(chunk&7));
+}
+
+static void cache_counttranslation(Bitu phys_addr) {
+	cache_stats.translations++;
+	Bitu chunk=phys_addr>>DYN_HASH_SHIFT;
+	if ((chunk>>3)<cache_evicted_map_size && (cache_evicted_map[chunk>>3]&(1<<(chunk&7)))) {
+		cache_evicted_map[chunk>>3]&=~(1<<(chunk&7));
+		cache_stats.retranslations++;
+	}
+}
+//--End of modifications
 
 
 // the CodePageHandlerDynRec class provides access to the contained
@@ -348,6 +379,22 @@ public:
 		cache.free_pages=this;
 		prev=0;
 	}
+	//--Added 2026-10-17 for LRU eviction of code pages
+	// clear out all cache blocks in this page to make room for other code
+	void Evict(void) {
+		for (Bitu index=1;index<(1+DYN_PAGE_HASH);index++) {
+			for (CacheBlockDynRec * block=hash_map[index];block;block=block->hash.next) {
+				cache_markevicted((phys_page<<12)+block->page.start);
+				cache_stats.evicted_blocks++;
+			}
+		}
+		cache_stats.evicted_pages++;
+		ClearRelease();
+	}
+	Bitu GetPhysPage(void) {
+		return phys_page;
+	}
+	//--End of modifications
 	void ClearRelease(void) {
 		// clear out all cache blocks in this page
 		for (Bitu index=0;index<(1+DYN_PAGE_HASH);index++) {
@@ -397,6 +444,30 @@ private:
 };
 
 
+//--Added 2026-10-17 for LRU eviction of code pages:
+//moves a page that has just run to the end of the used pages list,
+//so that the list head is always the page that was run least recently.
+static INLINE void cache_touchpage(CodePageHandlerDynRec * page) {
+	if (page==cache.last_page) return;
+	// unlink the page (it can't be the last one, so there is always a next page)
+	if (page->prev) page->prev->next=page->next;
+	else cache.used_pages=page->next;
+	page->next->prev=page->prev;
+	// and append it to the end of the list
+	page->prev=cache.last_page;
+	page->next=0;
+	cache.last_page->next=page;
+	cache.last_page=page;
+}
+
+// a block whose code space is about to be reused gets evicted
+static void cache_evictblock(CacheBlockDynRec * block) {
+	cache_markevicted((block->page.handler->GetPhysPage()<<12)+block->page.start);
+	cache_stats.evicted_blocks++;
+	block->Clear();
+}
+//--End of modifications
+
 static INLINE void cache_addunusedblock(CacheBlockDynRec * block) {
 	// block has become unused, add it to the freelist
 	block->cache.next=cache.block.free;
@@ -415,7 +486,7 @@ static CacheBlockDynRec * cache_getblock(void) {
 void CacheBlockDynRec::Clear(void) {
 	Bitu ind;
 	// check if this is not a cross page block
-	if (hash.index) for (ind=0;ind<2;ind++) {
+	if (hash.index) for (ind=0;ind<DYN_BLOCK_LINKS;ind++) {
 		CacheBlockDynRec * fromlink=link[ind].from;
 		link[ind].from=0;
 		while (fromlink) {
@@ -464,8 +535,10 @@ static CacheBlockDynRec * cache_openblock(void) {
 	// check for enough space in this block
 	Bitu size=block->cache.size;
 	CacheBlockDynRec * nextblock=block->cache.next;
+	//--Modified 2026-10-17 to count evictions
 	if (block->page.handler) 
-		block->Clear();
+		cache_evictblock(block);
+	//--End of modifications
 	// block size must be at least CACHE_MAXSIZE
 	while (size<CACHE_MAXSIZE) {
 		if (!nextblock)
@@ -473,8 +546,10 @@ static CacheBlockDynRec * cache_openblock(void) {
 		// merge blocks
 		size+=nextblock->cache.size;
 		CacheBlockDynRec * tempblock=nextblock->cache.next;
+		//--Modified 2026-10-17 to count evictions
 		if (nextblock->page.handler) 
-			nextblock->Clear();
+			cache_evictblock(nextblock);
+		//--End of modifications
 		// block is free now
 		cache_addunusedblock(nextblock);
 		nextblock=tempblock;
@@ -490,12 +565,13 @@ skipresize:
 static void cache_closeblock(void) {
 	CacheBlockDynRec * block=cache.block.active;
 	// links point to the default linking code
-	block->link[0].to=&link_blocks[0];
-	block->link[1].to=&link_blocks[1];
-	block->link[0].from=0;
-	block->link[1].from=0;
-	block->link[0].next=0;
-	block->link[1].next=0;
+	//--Modified 2026-10-17 to set up the extra superblock links too
+	for (Bitu ind=0;ind<DYN_BLOCK_LINKS;ind++) {
+		block->link[ind].to=&link_blocks[ind];
+		block->link[ind].from=0;
+		block->link[ind].next=0;
+	}
+	//--End of modifications
 	// close the block with correct alignment
 	Bitu written=(Bitu)(cache.pos-block->cache.start);
 	if (written>block->cache.size) {
@@ -577,9 +653,11 @@ static void cache_init(bool enable) {
 			memset(cache_blocks,0,sizeof(CacheBlockDynRec)*CACHE_BLOCKS);
 			cache.block.free=&cache_blocks[0];
 			// initialize the cache blocks
-			for (i=0;i<CACHE_BLOCKS-1;i++) {
-				cache_blocks[i].link[0].to=(CacheBlockDynRec *)1;
-				cache_blocks[i].link[1].to=(CacheBlockDynRec *)1;
+			for (i=0;i<(Bits)CACHE_BLOCKS-1;i++) {
+				//--Modified 2026-10-17 to set up the extra superblock links too
+				for (Bitu ind=0;ind<DYN_BLOCK_LINKS;ind++)
+					cache_blocks[i].link[ind].to=(CacheBlockDynRec *)1;
+				//--End of modifications
 				cache_blocks[i].cache.next=&cache_blocks[i+1];
 			}
 		}
@@ -612,6 +690,14 @@ static void cache_init(bool enable) {
 			block->cache.size=CACHE_TOTAL;
 			block->cache.next=0;						// last block in the list
 		}
+		//--Added 2026-10-17 to count retranslations of evicted blocks
+		if (cache_evicted_map == NULL) {
+			cache_evicted_map_size=(MEM_TotalPages()<<(12-DYN_HASH_SHIFT))>>3;
+			cache_evicted_map=(Bit8u*)malloc(cache_evicted_map_size);
+			if (!cache_evicted_map) E_Exit("Allocating the cache eviction map has failed");
+			memset(cache_evicted_map,0,cache_evicted_map_size);
+		}
+		//--End of modifications
 		// setup the default blocks for block linkage returns
 		cache.pos=&cache_code_link_blocks[0];
 		link_blocks[0].cache.start=cache.pos;
@@ -621,8 +707,18 @@ static void cache_init(bool enable) {
 		link_blocks[1].cache.start=cache.pos;
 		// link code that returns with a special return code
 		dyn_return(BR_Link2,false);
-
+		//--Added 2026-10-17 for the side exits of superblocks
 		cache.pos=&cache_code_link_blocks[64];
+		link_blocks[2].cache.start=cache.pos;
+		dyn_return(BR_Link3,false);
+		cache.pos=&cache_code_link_blocks[96];
+		link_blocks[3].cache.start=cache.pos;
+		dyn_return(BR_Link4,false);
+		//--End of modifications
+
+		//--Modified 2026-10-17 to make room for the extra link blocks
+		cache.pos=&cache_code_link_blocks[128];
+		//--End of modifications
 		core_dynrec.runcode=(BlockReturn (*)(Bit8u*))cache.pos;
 //		link_blocks[1].cache.start=cache.pos;
 		dyn_run_code();
@@ -44,7 +44,17 @@ static CacheBlockDynRec * CreateCacheBlock(CodePageHandlerDynRec * codepage,Phys
 	decode.active_block=decode.block=cache_openblock();
 	decode.block->page.start=(Bit16u)decode.page.index;
 	codepage->AddCacheBlock(decode.block);
-
+	//--Added 2026-10-17 to count translations and retranslations
+	cache_counttranslation((codepage->GetPhysPage()<<12)+decode.page.index);
+	//--End of modifications
+	//--Added 2026-10-17 for superblock formation
+	decode.block->profile.entries=0;
+	decode.block->profile.done=dyn_trace.active;
+	//--End of modifications
+
+	//--Added 2026-10-17 for guest register caching
+	gen_regcache_reset();
+	//--End of modifications
 	InitFlagsOptimization();
 
 	// every codeblock that is run sets cache.block.running to itself
@@ -55,10 +65,16 @@ static CacheBlockDynRec * CreateCacheBlock(CodePageHandlerDynRec * codepage,Phys
 	gen_mov_word_to_reg(FC_RETOP,&CPU_Cycles,true);
 	save_info_dynrec[used_save_info_dynrec].branch_pos=gen_create_branch_long_leqzero(FC_RETOP);
 	save_info_dynrec[used_save_info_dynrec].type=cycle_check;
+	//--Added 2026-10-17 for guest register caching
+	save_info_dynrec[used_save_info_dynrec].regcache=gen_regcache_state();
+	//--End of modifications
 	used_save_info_dynrec++;
 
 	decode.cycles=0;
 	while (max_opcodes--) {
+		//--Added 2026-10-17 to keep superblocks from outgrowing their cache block
+		if (dyn_trace.active && ((Bitu)(cache.pos-decode.block->cache.start)>CACHE_MAXSIZE/2)) break;
+		//--End of modifications
 		// Init prefixes
 		decode.big_addr=cpu.code.big;
 		decode.big_op=cpu.code.big;
@@ -195,9 +211,14 @@ restart_prefix:
 				// short conditional jumps
 				case 0x80:case 0x81:case 0x82:case 0x83:case 0x84:case 0x85:case 0x86:case 0x87:	
 				case 0x88:case 0x89:case 0x8a:case 0x8b:case 0x8c:case 0x8d:case 0x8e:case 0x8f:	
-					dyn_branched_exit((BranchTypes)(dual_code&0xf),
-						decode.big_op ? (Bit32s)decode_fetchd() : (Bit16s)decode_fetchw());
+				{
+					//--Modified 2026-10-17 to follow the likely path when translating a superblock
+					Bit32s eip_add=decode.big_op ? (Bit32s)decode_fetchd() : (Bit16s)decode_fetchw();
+					if (dyn_trace_branch((BranchTypes)(dual_code&0xf),eip_add)) break;
+					dyn_branched_exit((BranchTypes)(dual_code&0xf),eip_add);
+					//--End of modifications
 					goto finish_block;
+				}
 
 				// conditional byte set instructions
 /*				case 0x90:case 0x91:case 0x92:case 0x93:case 0x94:case 0x95:case 0x96:case 0x97:	
@@ -265,12 +286,16 @@ restart_prefix:
 			break;
 
 		case 0x60:
-			if (decode.big_op) gen_call_function_raw((void *)&dynrec_pusha_dword);
-			else gen_call_function_raw((void *)&dynrec_pusha_word);
+			//--Modified 2026-10-17 for guest register caching
+			if (decode.big_op) dyn_call_function_regs((void*)&dynrec_pusha_dword);
+			else dyn_call_function_regs((void*)&dynrec_pusha_word);
+			//--End of modifications
 			break;
 		case 0x61:
-			if (decode.big_op) gen_call_function_raw((void *)&dynrec_popa_dword);
-			else gen_call_function_raw((void *)&dynrec_popa_word);
+			//--Modified 2026-10-17 for guest register caching
+			if (decode.big_op) dyn_call_function_regs((void*)&dynrec_popa_dword);
+			else dyn_call_function_regs((void*)&dynrec_popa_word);
+			//--End of modifications
 			break;
 
 //		case 0x62: BOUND missing
@@ -296,8 +321,14 @@ restart_prefix:
 		// short conditional jumps
 		case 0x70:case 0x71:case 0x72:case 0x73:case 0x74:case 0x75:case 0x76:case 0x77:	
 		case 0x78:case 0x79:case 0x7a:case 0x7b:case 0x7c:case 0x7d:case 0x7e:case 0x7f:	
-			dyn_branched_exit((BranchTypes)(opcode&0xf),(Bit8s)decode_fetchb());	
+		{
+			//--Modified 2026-10-17 to follow the likely path when translating a superblock
+			Bit32s eip_add=(Bit8s)decode_fetchb();
+			if (dyn_trace_branch((BranchTypes)(opcode&0xf),eip_add)) break;
+			dyn_branched_exit((BranchTypes)(opcode&0xf),eip_add);
+			//--End of modifications
 			goto finish_block;
+		}
 
 		// 'op []/reg8,imm8'
 		case 0x80:
@@ -512,16 +543,28 @@ restart_prefix:
 			goto finish_block;
 		// 'jmp near imm16/32'
 		case 0xe9:
-			dyn_exit_link(decode.big_op ? (Bit32s)decode_fetchd() : (Bit16s)decode_fetchw());
+		{
+			//--Modified 2026-10-17 to follow the jump when translating a superblock
+			Bits eip_change=decode.big_op ? (Bit32s)decode_fetchd() : (Bit16s)decode_fetchw();
+			if (dyn_trace_jump(eip_change)) break;
+			dyn_exit_link(eip_change);
+			//--End of modifications
 			goto finish_block;
+		}
 		// 'jmp far'
 		case 0xea:
 			dyn_jmp_far_imm();
 			goto finish_block;
 		// 'jmp short imm8'
 		case 0xeb:
-			dyn_exit_link((Bit8s)decode_fetchb());
+		{
+			//--Modified 2026-10-17 to follow the jump when translating a superblock
+			Bits eip_change=(Bit8s)decode_fetchb();
+			if (dyn_trace_jump(eip_change)) break;
+			dyn_exit_link(eip_change);
+			//--End of modifications
 			goto finish_block;
+		}
 
 
 		// repeat prefixes
@@ -610,3 +653,25 @@ finish_block:
 
 	return decode.block;
 }
+
+//--Added 2026-10-17 for superblock formation:
+//retranslates a block that is entered often as a superblock (see dyn_trace_branch)
+static CacheBlockDynRec * CreateSuperBlock(CodePageHandlerDynRec * codepage,PhysPt start,CacheBlockDynRec * head) {
+	head->profile.done=true;
+	// code that has been modified would probably just get invalidated again
+	if (!dyn_superblocks || (codepage->invalidation_map && codepage->invalidation_map[start&4095])) return head;
+
+	// the regular block tells which way its branch usually goes, so look before clearing it
+	dyn_trace_setsegment(head);
+	head->Clear();
+
+	dyn_trace.active=true;
+	dyn_trace.exits=0;
+	dyn_trace.entry_eip=reg_eip;
+	CacheBlockDynRec * block=CreateCacheBlock(codepage,start,DYN_SUPERBLOCK_OPCODES);
+	dyn_trace.active=false;
+
+	cache_stats.superblocks++;
+	return block;
+}
+//--End of modifications
@@ -128,6 +128,24 @@ static struct DynDecode {
 	} modrm;
 } decode;
 
+//--Added 2026-10-17 for superblock formation
+// state of the superblock being translated, if any
+static struct {
+	bool active;			// a superblock is being translated
+	Bitu exits;				// number of side exits generated so far
+	Bitu entry_eip;			// instruction pointer at the start of the superblock
+
+	// the regular block that starts where the current straight run of code
+	// starts, used to guess which way conditional branches usually go
+	struct {
+		bool valid;
+		Bitu end;			// where in the page its code ends
+		bool taken;			// its conditional branch has been linked when taken
+		bool not_taken;		// ... and when not taken
+	} segment;
+} dyn_trace;
+//--End of modifications
+
 
 static bool MakeCodePage(Bitu lin_addr,CodePageHandlerDynRec * &cph) {
 	Bit8u rdval;
@@ -163,18 +181,21 @@ static bool MakeCodePage(Bitu lin_addr,CodePageHandlerDynRec * &cph) {
 		return false;
 	}
 	// find a free CodePage
+	//--Modified 2026-10-17 for LRU eviction: the used pages list is kept in order of
+	//when each page last ran, so the first page is the least recently used one
 	if (!cache.free_pages) {
-		if (cache.used_pages!=decode.page.code) cache.used_pages->ClearRelease();
+		if (cache.used_pages!=decode.page.code) cache.used_pages->Evict();
 		else {
 			// try another page to avoid clearing our source-crosspage
 			if ((cache.used_pages->next) && (cache.used_pages->next!=decode.page.code))
-				cache.used_pages->next->ClearRelease();
+				cache.used_pages->next->Evict();
 			else {
 				LOG_MSG("DYNREC:Invalid cache links");
-				cache.used_pages->ClearRelease();
+				cache.used_pages->Evict();
 			}
 		}
 	}
+	//--End of modifications
 	CodePageHandlerDynRec * cpagehandler=cache.free_pages;
 	cache.free_pages=cache.free_pages->next;
 
@@ -610,6 +631,25 @@ static BlockReturn DynRunException(Bit32u eip_add,Bit32u cycle_sub) {
 }
 
 
+//--Added 2026-10-17 for guest register caching:
+//backends that keep guest registers in host registers define DRC_REGCACHE
+//and write them back before exits and calls, the others need nothing
+#ifndef DRC_REGCACHE
+static void INLINE gen_regcache_reset(void) {}
+static void INLINE gen_regcache_writeback(void) {}
+static void INLINE gen_regcache_invalidate(void) {}
+static Bitu INLINE gen_regcache_state(void) { return 0; }
+static void INLINE gen_regcache_writeback_state(Bitu state) {}
+#endif
+
+// call a parameterless function that uses cpu_regs (like push/pop or div)
+static void dyn_call_function_regs(void * func) {
+	gen_regcache_writeback();
+	gen_call_function_raw(func);
+	gen_regcache_invalidate();
+}
+//--End of modifications
+
 // array with information about code that is generated at the
 // end of a cache block because it is rarely reached (like exceptions)
 static struct {
@@ -617,6 +657,9 @@ static struct {
 	DRC_PTR_SIZE_IM branch_pos;
 	Bit32u eip_change;
 	Bitu cycles;
+	//--Added 2026-10-17 for guest register caching: cached registers at the branch
+	Bitu regcache;
+	//--End of modifications
 } save_info_dynrec[512];
 
 Bitu used_save_info_dynrec=0;
@@ -638,8 +681,14 @@ static void dyn_run_code(void) {
 // fill in code at the end of the block that contains rarely-executed code
 // which is executed conditionally (like exceptions)
 static void dyn_fill_blocks(void) {
+	//--Added 2026-10-17 for guest register caching: nothing is cached in this code
+	gen_regcache_reset();
+	//--End of modifications
 	for (Bitu sct=0; sct<used_save_info_dynrec; sct++) {
 		gen_fill_branch_long(save_info_dynrec[sct].branch_pos);
+		//--Added 2026-10-17 for guest register caching
+		gen_regcache_writeback_state(save_info_dynrec[sct].regcache);
+		//--End of modifications
 		switch (save_info_dynrec[sct].type) {
 			case db_exception:
 				// code for exception handling, load cycles and call DynRunException
@@ -681,6 +730,9 @@ static void dyn_check_exception(HostReg reg) {
 	save_info_dynrec[used_save_info_dynrec].eip_change=decode.op_start-decode.code_start;
 	if (!cpu.code.big) save_info_dynrec[used_save_info_dynrec].eip_change&=0xffff;
 	save_info_dynrec[used_save_info_dynrec].type=db_exception;
+	//--Added 2026-10-17 for guest register caching
+	save_info_dynrec[used_save_info_dynrec].regcache=gen_regcache_state();
+	//--End of modifications
 	used_save_info_dynrec++;
 }
 
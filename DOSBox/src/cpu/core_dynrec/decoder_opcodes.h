@@ -401,12 +401,14 @@ static void dyn_lea(void) {
 
 static void dyn_push_seg(Bit8u seg) {
 	MOV_SEG_VAL_TO_HOST_REG(FC_OP1,seg);
+	//--Modified 2026-10-17 for guest register caching
 	if (decode.big_op) {
 		gen_extend_word(false,FC_OP1);
-		gen_call_function_raw((void*)&dynrec_push_dword);
+		dyn_call_function_regs((void*)&dynrec_push_dword);
 	} else {
-		gen_call_function_raw((void*)&dynrec_push_word);
+		dyn_call_function_regs((void*)&dynrec_push_word);
 	}
+	//--End of modifications
 }
 
 static void dyn_pop_seg(Bit8u seg) {
@@ -416,30 +418,38 @@ static void dyn_pop_seg(Bit8u seg) {
 
 static void dyn_push_reg(Bit8u reg) {
 	MOV_REG_WORD_TO_HOST_REG(FC_OP1,reg,decode.big_op);
-	if (decode.big_op) gen_call_function_raw((void*)&dynrec_push_dword);
-	else gen_call_function_raw((void*)&dynrec_push_word);
+	//--Modified 2026-10-17 for guest register caching
+	if (decode.big_op) dyn_call_function_regs((void*)&dynrec_push_dword);
+	else dyn_call_function_regs((void*)&dynrec_push_word);
+	//--End of modifications
 }
 
 static void dyn_pop_reg(Bit8u reg) {
-	if (decode.big_op) gen_call_function_raw((void*)&dynrec_pop_dword);
-	else gen_call_function_raw((void*)&dynrec_pop_word);
+	//--Modified 2026-10-17 for guest register caching
+	if (decode.big_op) dyn_call_function_regs((void*)&dynrec_pop_dword);
+	else dyn_call_function_regs((void*)&dynrec_pop_word);
+	//--End of modifications
 	MOV_REG_WORD_FROM_HOST_REG(FC_RETOP,reg,decode.big_op);
 }
 
 static void dyn_push_byte_imm(Bit8s imm) {
 	gen_mov_dword_to_reg_imm(FC_OP1,(Bit32u)imm);
-	if (decode.big_op) gen_call_function_raw((void*)&dynrec_push_dword);
-	else gen_call_function_raw((void*)&dynrec_push_word);
+	//--Modified 2026-10-17 for guest register caching
+	if (decode.big_op) dyn_call_function_regs((void*)&dynrec_push_dword);
+	else dyn_call_function_regs((void*)&dynrec_push_word);
+	//--End of modifications
 }
 
 static void dyn_push_word_imm(Bitu imm) {
+	//--Modified 2026-10-17 for guest register caching
 	if (decode.big_op) {
 		gen_mov_dword_to_reg_imm(FC_OP1,imm);
-		gen_call_function_raw((void*)&dynrec_push_dword);
+		dyn_call_function_regs((void*)&dynrec_push_dword);
 	} else {
 		gen_mov_word_to_reg_imm(FC_OP1,(Bit16u)imm);
-		gen_call_function_raw((void*)&dynrec_push_word);
+		dyn_call_function_regs((void*)&dynrec_push_word);
 	}
+	//--End of modifications
 }
 
 static void dyn_pop_ev(void) {
@@ -448,14 +458,18 @@ static void dyn_pop_ev(void) {
 /*		dyn_fill_ea(FC_ADDR);
 		gen_protect_addr_reg();
 		dyn_read_word(FC_ADDR,FC_OP1,decode.big_op);	// dummy read to trigger possible page faults */
-		if (decode.big_op) gen_call_function_raw((void*)&dynrec_pop_dword);
-		else gen_call_function_raw((void*)&dynrec_pop_word);
+		//--Modified 2026-10-17 for guest register caching
+		if (decode.big_op) dyn_call_function_regs((void*)&dynrec_pop_dword);
+		else dyn_call_function_regs((void*)&dynrec_pop_word);
+		//--End of modifications
 		dyn_fill_ea(FC_ADDR);
 //		gen_restore_addr_reg();
 		dyn_write_word(FC_ADDR,FC_RETOP,decode.big_op);
 	} else {
-		if (decode.big_op) gen_call_function_raw((void*)&dynrec_pop_dword);
-		else gen_call_function_raw((void*)&dynrec_pop_word);
+		//--Modified 2026-10-17 for guest register caching
+		if (decode.big_op) dyn_call_function_regs((void*)&dynrec_pop_dword);
+		else dyn_call_function_regs((void*)&dynrec_pop_word);
+		//--End of modifications
 		MOV_REG_WORD_FROM_HOST_REG(FC_RETOP,decode.modrm.rm,decode.big_op);
 	}
 }
@@ -530,8 +544,15 @@ static void dyn_imul_gvev(Bitu immsize) {
 			break;
 	}
 
-	if (decode.big_op) gen_call_function_raw((void*)dynrec_dimul_dword);
-	else gen_call_function_raw((void*)dynrec_dimul_word);
+	//--Modified 2026-10-17 for dead flag elimination
+	if (decode.big_op) {
+		InvalidateFlagsPartially((void*)&dynrec_dimul_dword_simple,t_UNKNOWN);
+		gen_call_function_raw((void*)dynrec_dimul_dword);
+	} else {
+		InvalidateFlagsPartially((void*)&dynrec_dimul_word_simple,t_UNKNOWN);
+		gen_call_function_raw((void*)dynrec_dimul_word);
+	}
+	//--End of modifications
 
 	MOV_REG_WORD_FROM_HOST_REG(FC_RETOP,decode.modrm.reg,decode.big_op);
 }
@@ -712,18 +733,30 @@ static void dyn_grp3_eb(void) {
 	case 0x3:	// NEG Eb
 		dyn_sop_byte_gencall(SOP_NEG);
 		break;
+	//--Modified 2026-10-17 for dead flag elimination and guest register caching
 	case 0x4:	// mul Eb
+		gen_regcache_writeback();
+		InvalidateFlagsPartially((void*)&dynrec_mul_byte_simple,t_UNKNOWN);
 		gen_call_function_raw((void*)&dynrec_mul_byte);
+		gen_regcache_invalidate();
 		return;
 	case 0x5:	// imul Eb
+		gen_regcache_writeback();
+		InvalidateFlagsPartially((void*)&dynrec_imul_byte_simple,t_UNKNOWN);
 		gen_call_function_raw((void*)&dynrec_imul_byte);
+		gen_regcache_invalidate();
 		return;
+	//--End of modifications
 	case 0x6:	// div Eb
-		gen_call_function_raw((void*)&dynrec_div_byte);
+		//--Modified 2026-10-17 for guest register caching
+		dyn_call_function_regs((void*)&dynrec_div_byte);
+		//--End of modifications
 		dyn_check_exception(FC_RETOP);
 		return;
 	case 0x7:	// idiv Eb
-		gen_call_function_raw((void*)&dynrec_idiv_byte);
+		//--Modified 2026-10-17 for guest register caching
+		dyn_call_function_regs((void*)&dynrec_idiv_byte);
+		//--End of modifications
 		dyn_check_exception(FC_RETOP);
 		return;
 	}
@@ -757,22 +790,42 @@ static void dyn_grp3_ev(void) {
 	case 0x3:	// NEG Eb
 		dyn_sop_word_gencall(SOP_NEG,decode.big_op);
 		break;
+	//--Modified 2026-10-17 for dead flag elimination and guest register caching
 	case 0x4:	// mul Eb
-		if (decode.big_op) gen_call_function_raw((void*)&dynrec_mul_dword);
-		else gen_call_function_raw((void*)&dynrec_mul_word);
+		gen_regcache_writeback();
+		if (decode.big_op) {
+			InvalidateFlagsPartially((void*)&dynrec_mul_dword_simple,t_UNKNOWN);
+			gen_call_function_raw((void*)&dynrec_mul_dword);
+		} else {
+			InvalidateFlagsPartially((void*)&dynrec_mul_word_simple,t_UNKNOWN);
+			gen_call_function_raw((void*)&dynrec_mul_word);
+		}
+		gen_regcache_invalidate();
 		return;
 	case 0x5:	// imul Eb
-		if (decode.big_op) gen_call_function_raw((void*)&dynrec_imul_dword);
-		else gen_call_function_raw((void*)&dynrec_imul_word);
+		gen_regcache_writeback();
+		if (decode.big_op) {
+			InvalidateFlagsPartially((void*)&dynrec_imul_dword_simple,t_UNKNOWN);
+			gen_call_function_raw((void*)&dynrec_imul_dword);
+		} else {
+			InvalidateFlagsPartially((void*)&dynrec_imul_word_simple,t_UNKNOWN);
+			gen_call_function_raw((void*)&dynrec_imul_word);
+		}
+		gen_regcache_invalidate();
 		return;
+	//--End of modifications
 	case 0x6:	// div Eb
-		if (decode.big_op) gen_call_function_raw((void*)&dynrec_div_dword);
-		else gen_call_function_raw((void*)&dynrec_div_word);
+		//--Modified 2026-10-17 for guest register caching
+		if (decode.big_op) dyn_call_function_regs((void*)&dynrec_div_dword);
+		else dyn_call_function_regs((void*)&dynrec_div_word);
+		//--End of modifications
 		dyn_check_exception(FC_RETOP);
 		return;
 	case 0x7:	// idiv Eb
-		if (decode.big_op) gen_call_function_raw((void*)&dynrec_idiv_dword);
-		else gen_call_function_raw((void*)&dynrec_idiv_word);
+		//--Modified 2026-10-17 for guest register caching
+		if (decode.big_op) dyn_call_function_regs((void*)&dynrec_idiv_dword);
+		else dyn_call_function_regs((void*)&dynrec_idiv_word);
+		//--End of modifications
 		dyn_check_exception(FC_RETOP);
 		return;
 	}
@@ -843,8 +896,10 @@ static Bitu dyn_grp4_ev(void) {
 		gen_protect_addr_reg();
 		gen_mov_word_to_reg(FC_OP1,decode.big_op?(void*)(&reg_eip):(void*)(&reg_ip),decode.big_op);
 		gen_add_imm(FC_OP1,(Bit32u)(decode.code-decode.code_start));
-		if (decode.big_op) gen_call_function_raw((void*)&dynrec_push_dword);
-		else gen_call_function_raw((void*)&dynrec_push_word);
+		//--Modified 2026-10-17 for guest register caching
+		if (decode.big_op) dyn_call_function_regs((void*)&dynrec_push_dword);
+		else dyn_call_function_regs((void*)&dynrec_push_word);
+		//--End of modifications
 
 		gen_restore_addr_reg();
 		gen_mov_word_from_reg(FC_ADDR,decode.big_op?(void*)(&reg_eip):(void*)(&reg_ip),decode.big_op);
@@ -867,8 +922,10 @@ static Bitu dyn_grp4_ev(void) {
 			decode.big_op,FC_OP2,FC_ADDR,FC_RETOP);
 		return 1;
 	case 0x6:		// PUSH Ev
-		if (decode.big_op) gen_call_function_raw((void*)&dynrec_push_dword);
-		else gen_call_function_raw((void*)&dynrec_push_word);
+		//--Modified 2026-10-17 for guest register caching
+		if (decode.big_op) dyn_call_function_regs((void*)&dynrec_push_dword);
+		else dyn_call_function_regs((void*)&dynrec_push_word);
+		//--End of modifications
 		break;
 	default:
 //		IllegalOptionDynrec("dyn_grp4_ev");
@@ -1112,6 +1169,91 @@ static void dyn_branched_exit(BranchTypes btype,Bit32s eip_add) {
  	dyn_closeblock();
 }
 
+//--Added 2026-10-17 for superblock formation:
+//a superblock follows the likely path through jumps and conditional branches
+//within its page, so that a chain of tiny blocks runs without dispatching
+//between them. The unlikely paths leave through side exits, which are linked
+//to the regular blocks there like any other exit.
+
+// remember the regular block at the start of a straight run of code
+static void dyn_trace_setsegment(CacheBlockDynRec * block) {
+	dyn_trace.segment.valid=(block!=NULL);
+	if (block) {
+		dyn_trace.segment.end=block->page.end;
+		dyn_trace.segment.taken=(block->link[1].to!=&link_blocks[1]);
+		dyn_trace.segment.not_taken=(block->link[0].to!=&link_blocks[0]);
+	}
+}
+
+// see if the superblock can carry on translating at target
+static bool dyn_trace_cancontinue(PhysPt target) {
+	// stay within the page the superblock started in, and only move forward
+	if (decode.active_block!=decode.block) return false;
+	if ((target>>12)!=(decode.code_start>>12) || target<decode.code) return false;
+	// the instruction pointer must not wrap around
+	if ((!decode.big_op || !cpu.code.big) && (dyn_trace.entry_eip+(target-decode.code_start)>0xffff)) return false;
+	// leave room for the rest of the translated code
+	if ((Bitu)(cache.pos-decode.block->cache.start)>CACHE_MAXSIZE/2) return false;
+	// don't carry on into code that is modified a lot
+	if (decode.page.invmap && (decode.page.invmap[target&4095]>=4)) return false;
+	return true;
+}
+
+// carry on translating at target, skipping the code in between
+static void dyn_trace_continue(PhysPt target) {
+	// the skipped bytes are not part of this block, so keep them out of its write map
+	while (decode.page.index<(target&4095)) {
+		decode_increase_wmapmask(1);
+		decode.page.index++;
+	}
+	decode.code=target;
+	dyn_trace_setsegment(decode.page.code->FindCacheBlock(target&4095));
+}
+
+// follow an unconditional jump if translating a superblock,
+// returns false if the block has to end with the jump instead
+static bool dyn_trace_jump(Bits eip_change) {
+	if (!dyn_trace.active) return false;
+	PhysPt target=decode.code+eip_change;
+	if (!dyn_trace_cancontinue(target)) return false;
+	dyn_trace_continue(target);
+	return true;
+}
+
+// follow the likely path of a conditional branch if translating a superblock,
+// returns false if the block has to end with the branch instead
+static bool dyn_trace_branch(BranchTypes btype,Bit32s eip_add) {
+	if (!dyn_trace.active || (dyn_trace.exits>=DYN_BLOCK_LINKS-2)) return false;
+
+	// prefer the only direction the regular block has taken so far,
+	// otherwise assume that backward branches are taken (which ends the superblock)
+	bool hot_taken=(eip_add<0);
+	if (dyn_trace.segment.valid && (dyn_trace.segment.end==decode.page.index-1) &&
+		(dyn_trace.segment.taken!=dyn_trace.segment.not_taken)) hot_taken=dyn_trace.segment.taken;
+	PhysPt target=hot_taken ? (decode.code+eip_add) : decode.code;
+	if (!dyn_trace_cancontinue(target)) return false;
+
+	// the cycles so far are accounted for on both paths
+	Bitu eip_base=decode.code-decode.code_start;
+	dyn_reduce_cycles();
+	decode.cycles=0;
+
+	dyn_branchflag_to_reg(btype);
+	DRC_PTR_SIZE_IM data=hot_taken ? gen_create_branch_on_nonzero(FC_RETOP,true) : gen_create_branch_on_zero(FC_RETOP,true);
+
+	// side exit for the unlikely path
+	gen_add_direct_word(&reg_eip,hot_taken ? eip_base : eip_base+eip_add,decode.big_op);
+	gen_jmp_ptr(&decode.block->link[2+dyn_trace.exits].to,offsetof(CacheBlockDynRec,cache.start));
+	gen_fill_branch(data);
+	dyn_trace.exits++;
+
+	// the side exit needs the condition flags as they are now
+	AcquireFlags(FMASK_TEST);
+	dyn_trace_continue(target);
+	return true;
+}
+//--End of modifications
+
 /*
 static void dyn_set_byte_on_condition(BranchTypes btype) {
 	dyn_get_modrm();
@@ -1175,9 +1317,13 @@ static void dyn_loop(LoopTypes type) {
 static void dyn_ret_near(Bitu bytes) {
 	dyn_reduce_cycles();
 
-	if (decode.big_op) gen_call_function_raw((void*)&dynrec_pop_dword);
+	//--Modified 2026-10-17 for guest register caching
+	if (decode.big_op) dyn_call_function_regs((void*)&dynrec_pop_dword);
+	//--End of modifications
 	else {
-		gen_call_function_raw((void*)&dynrec_pop_word);
+		//--Modified 2026-10-17 for guest register caching
+		dyn_call_function_regs((void*)&dynrec_pop_word);
+		//--End of modifications
 		gen_extend_word(false,FC_RETOP);
 	}
 	gen_mov_word_from_reg(FC_RETOP,decode.big_op?(void*)(&reg_eip):(void*)(&reg_ip),true);
@@ -1192,8 +1338,10 @@ static void dyn_call_near_imm(void) {
 	if (decode.big_op) imm=(Bit32s)decode_fetchd();
 	else imm=(Bit16s)decode_fetchw();
 	dyn_set_eip_end(FC_OP1);
-	if (decode.big_op) gen_call_function_raw((void*)&dynrec_push_dword);
-	else gen_call_function_raw((void*)&dynrec_push_word);
+	//--Modified 2026-10-17 for guest register caching
+	if (decode.big_op) dyn_call_function_regs((void*)&dynrec_push_dword);
+	else dyn_call_function_regs((void*)&dynrec_push_word);
+	//--End of modifications
 
 	dyn_set_eip_end(FC_OP1,imm);
 	gen_mov_word_from_reg(FC_OP1,decode.big_op?(void*)(&reg_eip):(void*)(&reg_ip),decode.big_op);
@@ -1306,6 +1454,9 @@ static void dyn_string(StringOps op) {
 		save_info_dynrec[used_save_info_dynrec].branch_pos=gen_create_branch_long_nonzero(FC_RETOP,true);
 		save_info_dynrec[used_save_info_dynrec].eip_change=decode.op_start-decode.code_start;
 		save_info_dynrec[used_save_info_dynrec].type=string_break;
+		//--Added 2026-10-17 for guest register caching
+		save_info_dynrec[used_save_info_dynrec].regcache=gen_regcache_state();
+		//--End of modifications
 		used_save_info_dynrec++;
 	}
 }
@@ -1400,8 +1551,10 @@ static void dynrec_leave_dword(void) {
 }
 
 static void dyn_leave(void) {
-	if (decode.big_op) gen_call_function_raw((void *)dynrec_leave_dword);
-	else gen_call_function_raw((void *)dynrec_leave_word);
+	//--Modified 2026-10-17 for guest register caching
+	if (decode.big_op) dyn_call_function_regs((void*)&dynrec_leave_dword);
+	else dyn_call_function_regs((void*)&dynrec_leave_word);
+	//--End of modifications
 }
 
 
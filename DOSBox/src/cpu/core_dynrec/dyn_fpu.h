@@ -53,6 +53,36 @@ static void FPU_FFREE(Bitu st) {
 #include "../../fpu/fpu_instructions.h"
 #endif
 
+//--Added 2026-10-17 for inline FPU arithmetic:
+// the arithmetic functions are selected by the reg field of the esc 0 opcode
+// fpu.regs[st]=fpu.regs[st] op fpu.regs[other], st is in FC_OP1 and other in FC_OP2
+static void dyn_fpu_arith(Bitu op) {
+#if defined(DRC_FPU_INLINE) && !C_FPU_X86
+	gen_fpu_arith(op,FC_OP1,FC_OP2,(void*)&fpu.regs[0]);
+#else
+	static void * const arith_functions[8]={
+		(void*)&FPU_FADD,(void*)&FPU_FMUL,NULL,NULL,
+		(void*)&FPU_FSUB,(void*)&FPU_FSUBR,(void*)&FPU_FDIV,(void*)&FPU_FDIVR
+	};
+	gen_call_function_RR(arith_functions[op],FC_OP1,FC_OP2);
+#endif
+}
+
+// fpu.regs[st]=fpu.regs[st] op memory operand (which is in fpu.regs[8]), st is in FC_OP1
+static void dyn_fpu_arith_ea(Bitu op) {
+#if defined(DRC_FPU_INLINE) && !C_FPU_X86
+	gen_mov_dword_to_reg_imm(FC_OP2,8);
+	gen_fpu_arith(op,FC_OP1,FC_OP2,(void*)&fpu.regs[0]);
+#else
+	static void * const arith_ea_functions[8]={
+		(void*)&FPU_FADD_EA,(void*)&FPU_FMUL_EA,NULL,NULL,
+		(void*)&FPU_FSUB_EA,(void*)&FPU_FSUBR_EA,(void*)&FPU_FDIV_EA,(void*)&FPU_FDIVR_EA
+	};
+	gen_call_function_R(arith_ea_functions[op],FC_OP1);
+#endif
+}
+//--End of modifications
+
 
 static INLINE void dyn_fpu_top() {
 	gen_mov_word_to_reg(FC_OP2,(void*)(&TOP),true);
@@ -72,10 +102,14 @@ static void dyn_eatree() {
 	Bitu group=(decode.modrm.val >> 3) & 7;
 	switch (group){
 	case 0x00:		// FADD ST,STi
-		gen_call_function_R((void*)&FPU_FADD_EA,FC_OP1);
+		//--Modified 2026-10-17 for inline FPU arithmetic
+		dyn_fpu_arith_ea(0);
+		//--End of modifications
 		break;
 	case 0x01:		// FMUL  ST,STi
-		gen_call_function_R((void*)&FPU_FMUL_EA,FC_OP1);
+		//--Modified 2026-10-17 for inline FPU arithmetic
+		dyn_fpu_arith_ea(1);
+		//--End of modifications
 		break;
 	case 0x02:		// FCOM  STi
 		gen_call_function_R((void*)&FPU_FCOM_EA,FC_OP1);
@@ -85,16 +119,24 @@ static void dyn_eatree() {
 		gen_call_function_raw((void*)&FPU_FPOP);
 		break;
 	case 0x04:		// FSUB  ST,STi
-		gen_call_function_R((void*)&FPU_FSUB_EA,FC_OP1);
+		//--Modified 2026-10-17 for inline FPU arithmetic
+		dyn_fpu_arith_ea(4);
+		//--End of modifications
 		break;	
 	case 0x05:		// FSUBR ST,STi
-		gen_call_function_R((void*)&FPU_FSUBR_EA,FC_OP1);
+		//--Modified 2026-10-17 for inline FPU arithmetic
+		dyn_fpu_arith_ea(5);
+		//--End of modifications
 		break;
 	case 0x06:		// FDIV  ST,STi
-		gen_call_function_R((void*)&FPU_FDIV_EA,FC_OP1);
+		//--Modified 2026-10-17 for inline FPU arithmetic
+		dyn_fpu_arith_ea(6);
+		//--End of modifications
 		break;
 	case 0x07:		// FDIVR ST,STi
-		gen_call_function_R((void*)&FPU_FDIVR_EA,FC_OP1);
+		//--Modified 2026-10-17 for inline FPU arithmetic
+		dyn_fpu_arith_ea(7);
+		//--End of modifications
 		break;
 	default:
 		break;
@@ -107,10 +149,14 @@ static void dyn_fpu_esc0(){
 		dyn_fpu_top();
 		switch (decode.modrm.reg){
 		case 0x00:		//FADD ST,STi
-			gen_call_function_RR((void*)&FPU_FADD,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(0);
+			//--End of modifications
 			break;
 		case 0x01:		// FMUL  ST,STi
-			gen_call_function_RR((void*)&FPU_FMUL,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(1);
+			//--End of modifications
 			break;
 		case 0x02:		// FCOM  STi
 			gen_call_function_RR((void*)&FPU_FCOM,FC_OP1,FC_OP2);
@@ -120,16 +166,24 @@ static void dyn_fpu_esc0(){
 			gen_call_function_raw((void*)&FPU_FPOP);
 			break;
 		case 0x04:		// FSUB  ST,STi
-			gen_call_function_RR((void*)&FPU_FSUB,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(4);
+			//--End of modifications
 			break;	
 		case 0x05:		// FSUBR ST,STi
-			gen_call_function_RR((void*)&FPU_FSUBR,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(5);
+			//--End of modifications
 			break;
 		case 0x06:		// FDIV  ST,STi
-			gen_call_function_RR((void*)&FPU_FDIV,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(6);
+			//--End of modifications
 			break;
 		case 0x07:		// FDIVR ST,STi
-			gen_call_function_RR((void*)&FPU_FDIVR,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(7);
+			//--End of modifications
 			break;
 		default:
 			break;
@@ -432,11 +486,15 @@ static void dyn_fpu_esc4(){
 		switch(decode.modrm.reg){
 		case 0x00:	/* FADD STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FADD,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(0);
+			//--End of modifications
 			break;
 		case 0x01:	/* FMUL STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FMUL,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(1);
+			//--End of modifications
 			break;
 		case 0x02:  /* FCOM*/
 			dyn_fpu_top();
@@ -449,19 +507,27 @@ static void dyn_fpu_esc4(){
 			break;
 		case 0x04:  /* FSUBR STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FSUBR,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(5);
+			//--End of modifications
 			break;
 		case 0x05:  /* FSUB  STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FSUB,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(4);
+			//--End of modifications
 			break;
 		case 0x06:  /* FDIVR STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FDIVR,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(7);
+			//--End of modifications
 			break;
 		case 0x07:  /* FDIV STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FDIV,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(6);
+			//--End of modifications
 			break;
 		default:
 			break;
@@ -550,11 +616,15 @@ static void dyn_fpu_esc6(){
 		switch(decode.modrm.reg){
 		case 0x00:	/*FADDP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FADD,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(0);
+			//--End of modifications
 			break;
 		case 0x01:	/* FMULP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FMUL,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(1);
+			//--End of modifications
 			break;
 		case 0x02:  /* FCOMP5*/
 			dyn_fpu_top();
@@ -574,19 +644,27 @@ static void dyn_fpu_esc6(){
 			break;
 		case 0x04:  /* FSUBRP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FSUBR,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(5);
+			//--End of modifications
 			break;
 		case 0x05:  /* FSUBP  STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FSUB,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(4);
+			//--End of modifications
 			break;
 		case 0x06:	/* FDIVRP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FDIVR,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(7);
+			//--End of modifications
 			break;
 		case 0x07:  /* FDIVP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FDIV,FC_OP1,FC_OP2);
+			//--Modified 2026-10-17 for inline FPU arithmetic
+			dyn_fpu_arith(6);
+			//--End of modifications
 			break;
 		default:
 			break;
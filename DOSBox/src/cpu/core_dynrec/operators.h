@@ -1581,6 +1581,59 @@ static Bit32u DRC_CALL_CONV dynrec_dimul_dword(Bit32u op1,Bit32u op2) {
 	return (Bit32s)res;
 }
 
+//--Added 2026-10-17 for dead flag elimination:
+//multiplications that leave the flags alone, for when a later instruction
+//overwrites all of them before they are read (see InvalidateFlagsPartially)
+
+static void DRC_CALL_CONV dynrec_mul_byte_simple(Bit8u op) DRC_FC;
+static void DRC_CALL_CONV dynrec_mul_byte_simple(Bit8u op) {
+	reg_ax=reg_al*op;
+}
+
+static void DRC_CALL_CONV dynrec_imul_byte_simple(Bit8u op) DRC_FC;
+static void DRC_CALL_CONV dynrec_imul_byte_simple(Bit8u op) {
+	reg_ax=((Bit8s)reg_al) * ((Bit8s)op);
+}
+
+static void DRC_CALL_CONV dynrec_mul_word_simple(Bit16u op) DRC_FC;
+static void DRC_CALL_CONV dynrec_mul_word_simple(Bit16u op) {
+	Bitu tempu=(Bitu)reg_ax*(Bitu)op;
+	reg_ax=(Bit16u)(tempu);
+	reg_dx=(Bit16u)(tempu >> 16);
+}
+
+static void DRC_CALL_CONV dynrec_imul_word_simple(Bit16u op) DRC_FC;
+static void DRC_CALL_CONV dynrec_imul_word_simple(Bit16u op) {
+	Bits temps=((Bit16s)reg_ax)*((Bit16s)op);
+	reg_ax=(Bit16s)(temps);
+	reg_dx=(Bit16s)(temps >> 16);
+}
+
+static void DRC_CALL_CONV dynrec_mul_dword_simple(Bit32u op) DRC_FC;
+static void DRC_CALL_CONV dynrec_mul_dword_simple(Bit32u op) {
+	Bit64u tempu=(Bit64u)reg_eax*(Bit64u)op;
+	reg_eax=(Bit32u)(tempu);
+	reg_edx=(Bit32u)(tempu >> 32);
+}
+
+static void DRC_CALL_CONV dynrec_imul_dword_simple(Bit32u op) DRC_FC;
+static void DRC_CALL_CONV dynrec_imul_dword_simple(Bit32u op) {
+	Bit64s temps=((Bit64s)((Bit32s)reg_eax))*((Bit64s)((Bit32s)op));
+	reg_eax=(Bit32u)(temps);
+	reg_edx=(Bit32u)(temps >> 32);
+}
+
+static Bit16u DRC_CALL_CONV dynrec_dimul_word_simple(Bit16u op1,Bit16u op2) DRC_FC;
+static Bit16u DRC_CALL_CONV dynrec_dimul_word_simple(Bit16u op1,Bit16u op2) {
+	return (Bit16u)(((Bit16s)op1) * ((Bit16s)op2));
+}
+
+static Bit32u DRC_CALL_CONV dynrec_dimul_dword_simple(Bit32u op1,Bit32u op2) DRC_FC;
+static Bit32u DRC_CALL_CONV dynrec_dimul_dword_simple(Bit32u op1,Bit32u op2) {
+	return op1*op2;
+}
+//--End of modifications
+
 
 
 static Bit16u DRC_CALL_CONV dynrec_cbw(Bit8u op) DRC_FC;
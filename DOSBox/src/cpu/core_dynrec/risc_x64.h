@@ -33,6 +33,21 @@
 // type with the same size as a pointer
 #define DRC_PTR_SIZE_IM Bit64u
 
+//--Added 2026-10-17 for guest register caching:
+// access the guest registers through the gen_mov_regval_ functions,
+// which keep the most used ones in host registers for a block
+#define DRC_USE_REGS_ADDR
+#define DRC_REGCACHE
+//--End of modifications
+
+//--Added 2026-10-17 for inline FPU arithmetic:
+// generate the basic FPU arithmetic with SSE2 instead of calling the FPU functions.
+// This works on the double precision registers of the C FPU core, which is what
+// every x86-64 build uses (config.h only enables the x87 core for 32-bit Intel,
+// so Boxer's own i386 builds keep its 80-bit precision and never get here)
+#define DRC_FPU_INLINE
+//--End of modifications
+
 // calling convention modifier
 #define DRC_CALL_CONV	/* nothing */
 #define DRC_FC			/* nothing */
@@ -233,12 +248,239 @@ static void INLINE gen_mov_direct_ptr(void* dest,DRC_PTR_SIZE_IM imm) {
 }
 
 
+//--Added 2026-10-17 for guest register caching:
+//the guest registers are cached in r12-r15 (slots 0-3) while a block is translated.
+//A slot is loaded on the first access to its register and then used in place of
+//cpu_regs, changed registers are written back before the block exits and before
+//calling functions that use cpu_regs (see gen_regcache_writeback). r12-r15 are
+//callee-saved, so the C functions the block calls leave them alone.
+//Code that is conditionally skipped by a short branch must leave the slots in the
+//same state on both paths, so no slots are assigned while a short branch is open.
+
+#define DRC_REGCACHE_SLOTS 4
+
+static struct {
+	Bit8s guest[DRC_REGCACHE_SLOTS];	// guest register held by each slot, -1 if none
+	Bitu used[DRC_REGCACHE_SLOTS];		// when each slot was used last
+	Bitu clock;
+	Bit8u dirty;						// slots that may differ from cpu_regs
+	Bitu frozen;						// short branches that have not been filled yet
+} regcache;
+
+// forget all slots, used when starting and finishing to translate a block
+static void gen_regcache_reset(void) {
+	for (Bitu slot=0;slot<DRC_REGCACHE_SLOTS;slot++) regcache.guest[slot]=-1;
+	regcache.dirty=0;
+	regcache.frozen=0;
+}
+
+// write a slot back to cpu_regs
+static void gen_regcache_store(Bitu slot,Bitu guest) {
+	cache_addb(0x44);
+	cache_addb(0x89);		// mov [cpu_regs],r12d-r15d
+	gen_memaddr((HostReg)(4+slot),&cpu_regs.regs[guest].dword);
+}
+
+// load a slot from cpu_regs
+static void gen_regcache_load(Bitu slot) {
+	cache_addb(0x44);
+	cache_addb(0x8b);		// mov r12d-r15d,[cpu_regs]
+	gen_memaddr((HostReg)(4+slot),&cpu_regs.regs[regcache.guest[slot]].dword);
+}
+
+// returns the slot that holds guest register guest, or -1 if there is none
+// and no slot can be assigned to it (load==true loads the slot if it is assigned)
+static Bits gen_regcache_slot(Bitu guest,bool assign,bool load) {
+	if (guest>=8) return -1;
+	Bitu slot;
+	for (slot=0;slot<DRC_REGCACHE_SLOTS;slot++) {
+		if (regcache.guest[slot]==(Bit8s)guest) {
+			regcache.used[slot]=++regcache.clock;
+			return (Bits)slot;
+		}
+	}
+	if (!assign || regcache.frozen) return -1;
+
+	// take a free slot, or the one that was used least recently
+	Bitu victim=0;
+	for (slot=0;slot<DRC_REGCACHE_SLOTS;slot++) {
+		if (regcache.guest[slot]<0) {
+			victim=slot;
+			break;
+		}
+		if (regcache.used[slot]<regcache.used[victim]) victim=slot;
+	}
+	if ((regcache.guest[victim]>=0) && (regcache.dirty&(1<<victim))) gen_regcache_store(victim,regcache.guest[victim]);
+	regcache.dirty&=~(1<<victim);
+	regcache.guest[victim]=(Bit8s)guest;
+	regcache.used[victim]=++regcache.clock;
+	if (load) gen_regcache_load(victim);
+	return (Bits)victim;
+}
+
+// returns the slot that holds the guest register at address data, or -1
+static Bits gen_regcache_slot_at(void* data) {
+	Bitu offset=(Bitu)((Bit8u*)data-(Bit8u*)&cpu_regs.regs[0]);
+	if (offset>=sizeof(cpu_regs.regs)) return -1;
+	return gen_regcache_slot(offset/sizeof(GenReg32),false,false);
+}
+
+// write all changed slots back to cpu_regs, the slots keep their values
+static void gen_regcache_writeback(void) {
+	for (Bitu slot=0;slot<DRC_REGCACHE_SLOTS;slot++) {
+		if ((regcache.guest[slot]>=0) && (regcache.dirty&(1<<slot))) gen_regcache_store(slot,regcache.guest[slot]);
+	}
+}
+
+// cpu_regs may have been changed by the code before, so the slots are stale
+static void gen_regcache_invalidate(void) {
+	for (Bitu slot=0;slot<DRC_REGCACHE_SLOTS;slot++) {
+		if (regcache.guest[slot]<0) continue;
+		// the slots have to stay as they are while a short branch is open
+		if (regcache.frozen) gen_regcache_load(slot);
+		else regcache.guest[slot]=-1;
+	}
+	if (!regcache.frozen) regcache.dirty=0;
+}
+
+// returns the current state of the slots for gen_regcache_writeback_state
+static Bitu gen_regcache_state(void) {
+	Bitu state=(Bitu)regcache.dirty<<(4*DRC_REGCACHE_SLOTS);
+	for (Bitu slot=0;slot<DRC_REGCACHE_SLOTS;slot++) {
+		if (regcache.guest[slot]>=0) state|=(Bitu)(8|regcache.guest[slot])<<(4*slot);
+	}
+	return state;
+}
+
+// write the changed slots of an earlier state back to cpu_regs,
+// used by code at the end of the block that is branched to from earlier on
+static void gen_regcache_writeback_state(Bitu state) {
+	for (Bitu slot=0;slot<DRC_REGCACHE_SLOTS;slot++) {
+		Bitu entry=(state>>(4*slot))&0xf;
+		if ((entry&8) && ((state>>(4*DRC_REGCACHE_SLOTS+slot))&1)) gen_regcache_store(slot,entry&7);
+	}
+}
+
+// encode an operation between a host register and slot
+static void INLINE gen_regcache_op(Bit8u opcode,HostReg reg,Bitu slot,bool dword=true) {
+	if (!dword) cache_addb(0x66);
+	cache_addb(0x41);
+	cache_addb(opcode);
+	cache_addb(0xc0+(reg<<3)+4+slot);
+}
+
+// mov 16bit value from cpu_regs[index] into dest_reg
+// 16bit moves may destroy the upper 16bit of the destination register
+static void gen_mov_regval16_to_reg(HostReg dest_reg,Bitu index) {
+	Bits slot=gen_regcache_slot(index/sizeof(GenReg32),true,true);
+	if (slot>=0) gen_regcache_op(0x8b,dest_reg,slot,false);	// mov dest_reg,r12w-r15w
+	else gen_mov_word_to_reg(dest_reg,(Bit8u*)&cpu_regs+index,false);
+}
+
+// mov 32bit value from cpu_regs[index] into dest_reg
+static void gen_mov_regval32_to_reg(HostReg dest_reg,Bitu index) {
+	Bits slot=gen_regcache_slot(index/sizeof(GenReg32),true,true);
+	if (slot>=0) gen_regcache_op(0x8b,dest_reg,slot);			// mov dest_reg,r12d-r15d
+	else gen_mov_word_to_reg(dest_reg,(Bit8u*)&cpu_regs+index,true);
+}
+
+// move a 32bit (dword==true) or 16bit (dword==false) value from cpu_regs[index] into dest_reg
+// 16bit moves may destroy the upper 16bit of the destination register
+static void gen_mov_regword_to_reg(HostReg dest_reg,Bitu index,bool dword) {
+	if (dword) gen_mov_regval32_to_reg(dest_reg,index);
+	else gen_mov_regval16_to_reg(dest_reg,index);
+}
+
+// move an 8bit value from cpu_regs[index] into dest_reg
+// the upper 24bit of the destination register can be destroyed
+// this function does not use FC_OP1/FC_OP2 as dest_reg as these
+// registers might not be directly byte-accessible on some architectures
+static void gen_mov_regbyte_to_reg_low(HostReg dest_reg,Bitu index) {
+	Bits slot=gen_regcache_slot(index/sizeof(GenReg32),true,true);
+	if (slot>=0) {
+		gen_regcache_op(0x8b,dest_reg,slot);					// mov dest_reg,r12d-r15d
+		if (index&1) {
+			cache_addw(0xe8c1+(dest_reg<<8));					// shr dest_reg,8
+			cache_addb(0x08);
+		}
+	} else gen_mov_byte_to_reg_low(dest_reg,(Bit8u*)&cpu_regs+index);
+}
+
+// move an 8bit value from cpu_regs[index] into dest_reg
+// the upper 24bit of the destination register can be destroyed
+// this function can use FC_OP1/FC_OP2 as dest_reg which are
+// not directly byte-accessible on some architectures
+static void INLINE gen_mov_regbyte_to_reg_low_canuseword(HostReg dest_reg,Bitu index) {
+	if (gen_regcache_slot(index/sizeof(GenReg32),false,false)>=0) gen_mov_regbyte_to_reg_low(dest_reg,index);
+	else gen_mov_byte_to_reg_low_canuseword(dest_reg,(Bit8u*)&cpu_regs+index);
+}
+
+// add a 32bit value from cpu_regs[index] to a full register
+static void gen_add_regval32_to_reg(HostReg reg,Bitu index) {
+	Bits slot=gen_regcache_slot(index/sizeof(GenReg32),true,true);
+	if (slot>=0) gen_regcache_op(0x03,reg,slot);				// add reg,r12d-r15d
+	else gen_add(reg,(Bit8u*)&cpu_regs+index);
+}
+
+// move 16bit of register into cpu_regs[index]
+static void gen_mov_regval16_from_reg(HostReg src_reg,Bitu index) {
+	Bits slot=gen_regcache_slot(index/sizeof(GenReg32),true,true);
+	if (slot>=0) {
+		gen_regcache_op(0x89,src_reg,slot,false);				// mov r12w-r15w,src_reg
+		regcache.dirty|=1<<slot;
+	} else gen_mov_word_from_reg(src_reg,(Bit8u*)&cpu_regs+index,false);
+}
+
+// move 32bit of register into cpu_regs[index]
+static void gen_mov_regval32_from_reg(HostReg src_reg,Bitu index) {
+	// the whole register is overwritten, so there is no need to load it first
+	Bits slot=gen_regcache_slot(index/sizeof(GenReg32),true,false);
+	if (slot>=0) {
+		gen_regcache_op(0x89,src_reg,slot);						// mov r12d-r15d,src_reg
+		regcache.dirty|=1<<slot;
+	} else gen_mov_word_from_reg(src_reg,(Bit8u*)&cpu_regs+index,true);
+}
+
+// move 32bit (dword==true) or 16bit (dword==false) of a register into cpu_regs[index]
+static void gen_mov_regword_from_reg(HostReg src_reg,Bitu index,bool dword) {
+	if (dword) gen_mov_regval32_from_reg(src_reg,index);
+	else gen_mov_regval16_from_reg(src_reg,index);
+}
+
+// move the lowest 8bit of a register into cpu_regs[index]
+static void gen_mov_regbyte_from_reg_low(HostReg src_reg,Bitu index) {
+	Bits slot=gen_regcache_slot(index/sizeof(GenReg32),true,true);
+	if (slot>=0) {
+		if (index&1) {
+			cache_addw(0xc141);									// ror r12d-r15d,8
+			cache_addb(0xcc+slot);
+			cache_addb(0x08);
+		}
+		gen_regcache_op(0x88,src_reg,slot);						// mov r12b-r15b,src_reg
+		if (index&1) {
+			cache_addw(0xc141);									// rol r12d-r15d,8
+			cache_addb(0xc4+slot);
+			cache_addb(0x08);
+		}
+		regcache.dirty|=1<<slot;
+	} else gen_mov_byte_from_reg_low(src_reg,(Bit8u*)&cpu_regs+index);
+}
+//--End of modifications
+
+
 // add an 8bit constant value to a memory value
 static void gen_add_direct_byte(void* dest,Bit8s imm) {
+	//--Added 2026-10-17 for guest register caching
+	Bits slot=gen_regcache_slot_at(dest);
+	if (slot>=0) gen_regcache_store(slot,regcache.guest[slot]);
+	//--End of modifications
 	cache_addw(0x0483);					// add [data],imm
 	cache_addb(0x25);
 	cache_addd((Bit32u)(((Bit64u)dest)&0xffffffffLL));
 	cache_addb(imm);
+	//--Added 2026-10-17 for guest register caching
+	if (slot>=0) gen_regcache_load(slot);
+	//--End of modifications
 }
 
 // add a 32bit (dword==true) or 16bit (dword==false) constant value to a memory value
@@ -247,20 +489,34 @@ static void gen_add_direct_word(void* dest,Bit32u imm,bool dword) {
 		gen_add_direct_byte(dest,(Bit8s)imm);
 		return;
 	}
+	//--Added 2026-10-17 for guest register caching
+	Bits slot=gen_regcache_slot_at(dest);
+	if (slot>=0) gen_regcache_store(slot,regcache.guest[slot]);
+	//--End of modifications
 	if (!dword) cache_addb(0x66);
 	cache_addw(0x0481);					// add [data],imm
 	cache_addb(0x25);
 	cache_addd((Bit32u)(((Bit64u)dest)&0xffffffffLL));
 	if (dword) cache_addd((Bit32u)imm);
 	else cache_addw((Bit16u)imm);
+	//--Added 2026-10-17 for guest register caching
+	if (slot>=0) gen_regcache_load(slot);
+	//--End of modifications
 }
 
 // subtract an 8bit constant value from a memory value
 static void gen_sub_direct_byte(void* dest,Bit8s imm) {
+	//--Added 2026-10-17 for guest register caching
+	Bits slot=gen_regcache_slot_at(dest);
+	if (slot>=0) gen_regcache_store(slot,regcache.guest[slot]);
+	//--End of modifications
 	cache_addw(0x2c83);					// sub [data],imm
 	cache_addb(0x25);
 	cache_addd((Bit32u)(((Bit64u)dest)&0xffffffffLL));
 	cache_addb(imm);
+	//--Added 2026-10-17 for guest register caching
+	if (slot>=0) gen_regcache_load(slot);
+	//--End of modifications
 }
 
 // subtract a 32bit (dword==true) or 16bit (dword==false) constant value from a memory value
@@ -269,12 +525,19 @@ static void gen_sub_direct_word(void* dest,Bit32u imm,bool dword) {
 		gen_sub_direct_byte(dest,(Bit8s)imm);
 		return;
 	}
+	//--Added 2026-10-17 for guest register caching
+	Bits slot=gen_regcache_slot_at(dest);
+	if (slot>=0) gen_regcache_store(slot,regcache.guest[slot]);
+	//--End of modifications
 	if (!dword) cache_addb(0x66);
 	cache_addw(0x2c81);					// sub [data],imm
 	cache_addb(0x25);
 	cache_addd((Bit32u)(((Bit64u)dest)&0xffffffffLL));
 	if (dword) cache_addd((Bit32u)imm);
 	else cache_addw((Bit16u)imm);
+	//--Added 2026-10-17 for guest register caching
+	if (slot>=0) gen_regcache_load(slot);
+	//--End of modifications
 }
 
 
@@ -334,6 +597,10 @@ static void INLINE gen_call_function_raw(void * func) {
 // note: the parameters are loaded in the architecture specific way
 // using the gen_load_param_ functions below
 static Bit64u INLINE gen_call_function_setup(void * func,Bitu paramcount,bool fastcall=false) {
+	//--Added 2026-10-17 for guest register caching: the function may use cpu_regs
+	gen_regcache_writeback();
+	//--End of modifications
+
 	// align the stack
 	cache_addb(0x48);
 	cache_addw(0xc48b);		// mov rax,rsp
@@ -364,6 +631,10 @@ static Bit64u INLINE gen_call_function_setup(void * func,Bitu paramcount,bool fa
 	// restore stack
 	cache_addb(0x5c);		// pop rsp
 
+	//--Added 2026-10-17 for guest register caching
+	gen_regcache_invalidate();
+	//--End of modifications
+
 	return proc_addr;
 }
 
@@ -504,6 +775,9 @@ static void INLINE gen_load_param_mem(Bitu mem,Bitu param) {
 
 // jump to an address pointed at by ptr, offset is in imm
 static void gen_jmp_ptr(void * ptr,Bits imm=0) {
+	//--Added 2026-10-17 for guest register caching
+	gen_regcache_writeback();
+	//--End of modifications
 	cache_addw(0xa148);		// mov rax,[data]
 	cache_addq((Bit64u)ptr);
 
@@ -523,6 +797,9 @@ static void gen_jmp_ptr(void * ptr,Bits imm=0) {
 // short conditional jump (+-127 bytes) if register is zero
 // the destination is set by gen_fill_branch() later
 static Bit64u gen_create_branch_on_zero(HostReg reg,bool dword) {
+	//--Added 2026-10-17 for guest register caching: both paths have to agree on the slots
+	regcache.frozen++;
+	//--End of modifications
 	if (!dword) cache_addb(0x66);
 	cache_addb(0x0b);					// or reg,reg
 	cache_addb(0xc0+reg+(reg<<3));
@@ -534,6 +811,9 @@ static Bit64u gen_create_branch_on_zero(HostReg reg,bool dword) {
 // short conditional jump (+-127 bytes) if register is nonzero
 // the destination is set by gen_fill_branch() later
 static Bit64u gen_create_branch_on_nonzero(HostReg reg,bool dword) {
+	//--Added 2026-10-17 for guest register caching: both paths have to agree on the slots
+	regcache.frozen++;
+	//--End of modifications
 	if (!dword) cache_addb(0x66);
 	cache_addb(0x0b);					// or reg,reg
 	cache_addb(0xc0+reg+(reg<<3));
@@ -550,6 +830,9 @@ static void gen_fill_branch(DRC_PTR_SIZE_IM data) {
 	if (len>126) LOG_MSG("Big jump %d",len);
 #endif
 	*(Bit8u*)data=(Bit8u)((Bit64u)cache.pos-data-1);
+	//--Added 2026-10-17 for guest register caching
+	if (regcache.frozen) regcache.frozen--;
+	//--End of modifications
 }
 
 // conditional jump if register is nonzero
@@ -584,15 +867,54 @@ static void gen_fill_branch_long(Bit64u data) {
 
 static void gen_run_code(void) {
 	cache_addb(0x53);					// push rbx
+	//--Added 2026-10-17 for guest register caching: the slots are callee-saved
+	cache_addw(0x5441);					// push r12
+	cache_addw(0x5541);					// push r13
+	cache_addw(0x5641);					// push r14
+	cache_addw(0x5741);					// push r15
+	//--End of modifications
 	cache_addw(0xd0ff+(FC_OP1<<8));		// call rdi
+	//--Added 2026-10-17 for guest register caching
+	cache_addw(0x5f41);					// pop  r15
+	cache_addw(0x5e41);					// pop  r14
+	cache_addw(0x5d41);					// pop  r13
+	cache_addw(0x5c41);					// pop  r12
+	//--End of modifications
 	cache_addb(0x5b);					// pop  rbx
 }
 
 // return from a function
 static void gen_return_function(void) {
+	//--Added 2026-10-17 for guest register caching
+	gen_regcache_writeback();
+	//--End of modifications
 	cache_addb(0xc3);		// ret
 }
 
+//--Added 2026-10-17 for inline FPU arithmetic:
+// regs[st]=regs[st] op regs[other] on double precision FPU registers,
+// op is the reg field of the esc 0 opcode (0:FADD 1:FMUL 4:FSUB 5:FSUBR 6:FDIV 7:FDIVR)
+// st and other contain the register indices, rax and xmm0 are destroyed
+static void gen_fpu_arith(Bitu op,HostReg st,HostReg other,void* regs) {
+	static const Bit8u sse_ops[8]={0x58,0x59,0,0,0x5c,0x5c,0x5e,0x5e};
+	bool reversed=(op==5) || (op==7);
+	HostReg first=reversed ? other : st;
+	HostReg second=reversed ? st : other;
+
+	cache_addw(0x8d48);					// lea rax,[regs]
+	gen_memaddr(HOST_EAX,regs);
+
+	cache_addd(0x04100ff2);				// movsd xmm0,[rax+first*8]
+	cache_addb(0xc0+(first<<3));
+	cache_addw(0x0ff2);					// addsd/mulsd/subsd/divsd xmm0,[rax+second*8]
+	cache_addb(sse_ops[op]);
+	cache_addb(0x04);
+	cache_addb(0xc0+(second<<3));
+	cache_addd(0x04110ff2);				// movsd [rax+st*8],xmm0
+	cache_addb(0xc0+(st<<3));
+}
+//--End of modifications
+
 #ifdef DRC_FLAGS_INVALIDATION
 // called when a call to a function can be replaced by a
 // call to a simpler function
@@ -85,6 +85,30 @@ extern Bitu cycle_count;
 	core.rep_zero=_ZERO;					\
 	goto restart_opcode;
 
+//--Added 2026-10-17 for computed goto dispatch:
+//With C_CORE_NORMAL_GOTO, every opcode also gets a label (see CASE_W in helpers.h)
+//and is dispatched through a table of label addresses, a GCC extension which gives
+//each opcode handler its own indirect jump instead of sharing the switch's one.
+//The table is filled by running the switch once for every opcode value while
+//opcode_labels.building is set: each case then stores its label and moves on.
+#if (C_CORE_NORMAL_GOTO) && defined(__GNUC__)
+#define CORE_NORMAL_GOTO 1
+
+static struct {
+	const void * labels[0x400];
+	Bitu index;
+	bool building,built;
+} opcode_labels;
+
+#define CORE_OPCODE_LABEL(_NAME)								\
+	if (GCC_UNLIKELY(opcode_labels.building)) {					\
+		opcode_labels.labels[opcode_labels.index]=&&_NAME;		\
+		goto next_opcode_label;									\
+	}															\
+	_NAME:
+#endif
+//--End of modifications
+
 typedef PhysPt (*GetEAHandler)(void);
 
 static const Bit32u AddrMaskTable[2]={0x0000ffff,0xffffffff};
@@ -137,6 +161,19 @@ static INLINE Bit32u Fetchd() {
 #define EALookupTable (core.ea_table)
 
 Bits CPU_Core_Normal_Run(void) {
+	//--Added 2026-10-17 for computed goto dispatch
+#if CORE_NORMAL_GOTO
+	if (GCC_UNLIKELY(!opcode_labels.built)) {
+		opcode_labels.building=true;
+		opcode_labels.index=0;
+		goto build_opcode_label;
+next_opcode_label:
+		if (++opcode_labels.index<0x400) goto build_opcode_label;
+		opcode_labels.building=false;
+		opcode_labels.built=true;
+	}
+#endif
+	//--End of modifications
 	while (CPU_Cycles-->0) {
 		LOADIP;
 		core.opcode_index=cpu.code.big*0x200;
@@ -155,13 +192,27 @@ Bits CPU_Core_Normal_Run(void) {
 		cycle_count++;
 #endif
 restart_opcode:
+		//--Modified 2026-10-17 for computed goto dispatch
+#if CORE_NORMAL_GOTO
+		goto *opcode_labels.labels[core.opcode_index+Fetchb()];
+build_opcode_label:
+		switch (opcode_labels.index) {
+#else
 		switch (core.opcode_index+Fetchb()) {
+#endif
+		//--End of modifications
 		#include "core_normal/prefix_none.h"
 		#include "core_normal/prefix_0f.h"
 		#include "core_normal/prefix_66.h"
 		#include "core_normal/prefix_66_0f.h"
 		default:
+		//--Modified 2026-10-17 for computed goto dispatch
+#if CORE_NORMAL_GOTO
+		CORE_OPCODE_LABEL(illegal_opcode)
+#else
 		illegal_opcode:
+#endif
+		//--End of modifications
 #if C_DEBUG	
 			{
 				Bitu len=(GETIP-reg_eip);
@@ -141,22 +141,36 @@
 	}																		\
 }
 
+//--Modified 2026-10-17 for computed goto dispatch:
+//cores that dispatch opcodes through a table of labels define CORE_OPCODE_LABEL
+//to place a uniquely named label after the case labels of each opcode
+#ifndef CORE_OPCODE_LABEL
+#define CORE_OPCODE_LABEL(_NAME)
+#endif
+
 #define CASE_W(_WHICH)							\
-	case (OPCODE_NONE+_WHICH):
+	case (OPCODE_NONE+_WHICH):					\
+	CORE_OPCODE_LABEL(opcode_w_ ## _WHICH)
 
 #define CASE_D(_WHICH)							\
-	case (OPCODE_SIZE+_WHICH):
+	case (OPCODE_SIZE+_WHICH):					\
+	CORE_OPCODE_LABEL(opcode_d_ ## _WHICH)
 
 #define CASE_B(_WHICH)							\
-	CASE_W(_WHICH)								\
-	CASE_D(_WHICH)
+	case (OPCODE_NONE+_WHICH):					\
+	case (OPCODE_SIZE+_WHICH):					\
+	CORE_OPCODE_LABEL(opcode_b_ ## _WHICH)
 
 #define CASE_0F_W(_WHICH)						\
-	case ((OPCODE_0F|OPCODE_NONE)+_WHICH):
+	case ((OPCODE_0F|OPCODE_NONE)+_WHICH):		\
+	CORE_OPCODE_LABEL(opcode_0f_w_ ## _WHICH)
 
 #define CASE_0F_D(_WHICH)						\
-	case ((OPCODE_0F|OPCODE_SIZE)+_WHICH):
+	case ((OPCODE_0F|OPCODE_SIZE)+_WHICH):		\
+	CORE_OPCODE_LABEL(opcode_0f_d_ ## _WHICH)
 
 #define CASE_0F_B(_WHICH)						\
-	CASE_0F_W(_WHICH)							\
-	CASE_0F_D(_WHICH)
+	case ((OPCODE_0F|OPCODE_NONE)+_WHICH):		\
+	case ((OPCODE_0F|OPCODE_SIZE)+_WHICH):		\
+	CORE_OPCODE_LABEL(opcode_0f_b_ ## _WHICH)
+//--End of modifications
@@ -30,6 +30,10 @@
 #include "paging.h"
 #include "lazyflags.h"
 #include "support.h"
+//--Added 2026-10-17 for host-idle detection
+#include "pic.h"
+#include <unistd.h>
+//--End of modifications
 
 Bitu DEBUG_EnableDebugger(void);
 extern void GFX_SetTitle(Bit32s cycles ,Bits frameskip,bool paused);
@@ -60,6 +64,10 @@ Bit64s CPU_IODelayRemoved = 0;
 CPU_Decoder * cpudecoder;
 bool CPU_CycleAutoAdjust = false;
 bool CPU_SkipCycleAutoAdjust = false;
+//--Added 2026-10-17 for the closed-loop cycle governor
+bool CPU_CycleGoverned = false;
+Bit64s CPU_HaltedCyclesSkipped = 0;
+//--End of modifications
 Bitu CPU_AutoDetermineMode = 0;
 
 Bitu CPU_ArchitectureType = CPU_ARCHTYPE_MIXED;
@@ -80,6 +88,10 @@ void CPU_Core_Dyn_X86_SetFPUMode(bool dh_fpu);
 void CPU_Core_Dynrec_Init(void);
 void CPU_Core_Dynrec_Cache_Init(bool enable_cache);
 void CPU_Core_Dynrec_Cache_Close(void);
+//--Added 2026-10-17 to make the size of the code cache configurable
+void CPU_Core_Dynrec_SetCacheSize(Bitu megabytes);
+void CPU_Core_Dynrec_SetSuperblocks(bool enabled);
+//--End of modifications
 #endif
 
 /* In debug mode exceptions are tested and dosbox exits when 
@@ -2051,6 +2063,9 @@ static Bits HLT_Decode(void) {
 	if (reg_eip!=cpu.hlt.eip || SegValue(cs) != cpu.hlt.cs) {
 		cpudecoder=cpu.hlt.old_decoder;
 	} else {
+		//--Added 2026-10-17 to let the cycle governor discount time spent halted
+		if (CPU_Cycles>0) CPU_HaltedCyclesSkipped+=CPU_Cycles;
+		//--End of modifications
 		CPU_Cycles=0;
 	}
 	return 0;
@@ -2058,6 +2073,9 @@ static Bits HLT_Decode(void) {
 
 void CPU_HLT(Bitu oldeip) {
 	reg_eip=oldeip;
+	//--Added 2026-10-17 to let the cycle governor discount time spent halted
+	if (CPU_Cycles>0) CPU_HaltedCyclesSkipped+=CPU_Cycles;
+	//--End of modifications
 	CPU_Cycles=0;
 	cpu.hlt.cs=SegValue(cs);
 	cpu.hlt.eip=reg_eip;
@@ -2146,6 +2164,28 @@ static void CPU_CycleDecrease(bool pressed) {
 	}
 }
 
+//--Added 2026-10-17 for host-idle detection
+//How long the host sleeps for in a tick in which the guest looked busy-waiting, in microseconds.
+#define CPU_IDLE_HOST_SLEEP_US 250
+
+bool CPU_IdleSkip = false;
+static Bitu CPU_IdleHostTick = 0;
+
+void CPU_SkipIdleCycles(Bits cycles) {
+	if (!CPU_IdleSkip || CPU_Cycles<=0) return;
+	if (cycles<=0 || cycles>CPU_Cycles) cycles=CPU_Cycles;
+	CPU_Cycles-=cycles;
+	CPU_IODelayRemoved+=cycles;
+}
+
+void CPU_IdleHost(void) {
+	/* With fixed cycles the host sleeps anyway once the tick's cycles are done */
+	if (!CPU_IdleSkip || !CPU_CycleAutoAdjust || CPU_IdleHostTick==PIC_Ticks) return;
+	CPU_IdleHostTick=PIC_Ticks;
+	usleep(CPU_IDLE_HOST_SLEEP_US);
+}
+//--End of modifications
+
 void CPU_Enable_SkipAutoAdjust(void) {
 	if (CPU_CycleAutoAdjust) {
 		CPU_CycleMax /= 2;
@@ -2243,6 +2283,9 @@ public:
 		std::string type = p->GetSection()->Get_string("type");
 		std::string str ;
 		CommandLine cmd(0,p->GetSection()->Get_string("parameters"));
+		//--Added 2026-10-17 for the closed-loop cycle governor
+		CPU_CycleGoverned=(type=="governed");
+		//--End of modifications
 		if (type=="max") {
 			CPU_CycleMax=0;
 			CPU_CyclePercUsed=100;
@@ -2267,6 +2310,34 @@ public:
 					}
 				}
 			}
+		//--Added 2026-10-17 for the closed-loop cycle governor: like max, but with
+		//the percentage being the share of host CPU time to spend emulating.
+		} else if (type=="governed") {
+			CPU_CycleMax=3000;
+			CPU_OldCycleMax=3000;
+			CPU_CyclePercUsed=90;
+			CPU_CycleAutoAdjust=true;
+			CPU_CycleLimit=-1;
+			for (Bitu cmdnum=1; cmdnum<=cmd.GetCount(); cmdnum++) {
+				if (cmd.FindCommand(cmdnum,str)) {
+					if (str.find('%')==str.length()-1) {
+						str.erase(str.find('%'));
+						int percval=0;
+						std::istringstream stream(str);
+						stream >> percval;
+						if ((percval>0) && (percval<=100)) CPU_CyclePercUsed=(Bit32s)percval;
+					} else if (str=="limit") {
+						cmdnum++;
+						if (cmd.FindCommand(cmdnum,str)) {
+							int cyclimit=0;
+							std::istringstream stream(str);
+							stream >> cyclimit;
+							if (cyclimit>0) CPU_CycleLimit=cyclimit;
+						}
+					}
+				}
+			}
+		//--End of modifications
 		} else {
 			if (type=="auto") {
 				CPU_AutoDetermineMode|=CPU_AUTODETERMINE_CYCLES;
@@ -2316,6 +2387,9 @@ public:
 		}
 
 		CPU_CycleUp=section->Get_int("cycleup");
+		//--Added 2026-10-17 for host-idle detection
+		CPU_IdleSkip=section->Get_bool("idleskip");
+		//--End of modifications
 		CPU_CycleDown=section->Get_int("cycledown");
 		std::string core(section->Get_string("core"));
 		cpudecoder=&CPU_Core_Normal_Run;
@@ -2349,6 +2423,10 @@ public:
 #if (C_DYNAMIC_X86)
 		CPU_Core_Dyn_X86_Cache_Init((core == "dynamic") || (core == "dynamic_nodhfpu"));
 #elif (C_DYNREC)
+		//--Added 2026-10-17 to make the size of the code cache configurable
+		CPU_Core_Dynrec_SetCacheSize(section->Get_int("dynamic_cache"));
+		CPU_Core_Dynrec_SetSuperblocks(section->Get_bool("dynamic_superblocks"));
+		//--End of modifications
 		CPU_Core_Dynrec_Cache_Init( core == "dynamic" );
 #endif
 
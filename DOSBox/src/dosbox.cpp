@@ -23,6 +23,14 @@
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
+#include <math.h>
+//--Added 2026-10-17 for the closed-loop cycle governor
+#if defined(MACOSX)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+//--End of modifications
 #include "dosbox.h"
 #include "debug.h"
 #include "cpu.h"
@@ -128,6 +136,148 @@ Bit32s ticksDone;
 Bit32u ticksScheduled;
 bool ticksLocked;
 
+//--Added 2026-10-17: the closed-loop cycle governor for cycles=governed.
+//Unlike the auto-adjust logic in Normal_Loop, which counts whole milliseconds from GetTicks()
+//and scales the cycles by ratio thresholds, this paces emulated ticks against a microsecond
+//host clock and steers the cycles with a PI controller working on the measured share of host
+//time spent emulating. The controller works in log space, since the time taken to emulate a
+//tick is roughly proportional to the number of cycles in it.
+
+//How much host time to measure before each adjustment, in microseconds.
+#define GOVERNOR_WINDOW_US 50000
+//Proportional and integral gains of the controller.
+#define GOVERNOR_KP 0.25
+#define GOVERNOR_KI 0.35
+//Weight given to each new measurement when smoothing.
+#define GOVERNOR_SMOOTHING 0.5
+//The most we'll scale the cycles by in a single adjustment.
+#define GOVERNOR_MAX_STEP 2.0
+//How many ticks we'll emulate in one go when we fall behind: any further behind than
+//this and we'll give up catching up, as the auto-adjust logic does.
+#define GOVERNOR_MAX_TICKS 20
+
+static struct {
+	bool running;
+	Bit64u clockBase;		//Host time at which tick 0 was due
+	Bit64u ticksPaced;		//Ticks scheduled since clockBase
+	Bit64u windowStart;
+	Bit64u windowSlept;		//Host time spent sleeping since windowStart
+	Bitu windowTicks;		//Ticks scheduled since windowStart
+	double measured;
+	double error;
+	Bitu updates;
+} governor;
+
+static Bit64u GetHostMicroseconds(void) {
+#if defined(MACOSX)
+	static mach_timebase_info_data_t timebase;
+	if (!timebase.denom) mach_timebase_info(&timebase);
+	return (mach_absolute_time() * timebase.numer / timebase.denom) / 1000;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (Bit64u)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+#endif
+}
+
+static double Governor_Target(void) {
+	double target = CPU_CyclePercUsed / 100.0;
+	return (target > 1.0) ? 1.0 : target;
+}
+
+static void Governor_Reset(Bit64u now) {
+	governor.running = true;
+	governor.clockBase = now;
+	governor.ticksPaced = 0;
+	governor.windowStart = now;
+	governor.windowSlept = 0;
+	governor.windowTicks = 0;
+	CPU_IODelayRemoved = 0;
+	CPU_HaltedCyclesSkipped = 0;
+}
+
+static void Governor_Adjust(Bit64u now) {
+	Bit64u elapsed = now - governor.windowStart;
+	Bit64u busy = (elapsed > governor.windowSlept) ? elapsed - governor.windowSlept : 0;
+	Bitu ticks = governor.windowTicks;
+
+	/* Cycles skipped by the io delay code or while halted took next to no time,
+	   so extrapolate from the ones that were actually emulated */
+	Bit64s scheduled = (Bit64s)CPU_CycleMax * (Bit64s)ticks;
+	Bit64s executed = scheduled - CPU_IODelayRemoved - CPU_HaltedCyclesSkipped;
+
+	governor.windowStart = now;
+	governor.windowSlept = 0;
+	governor.windowTicks = 0;
+	CPU_IODelayRemoved = 0;
+	CPU_HaltedCyclesSkipped = 0;
+
+	/* A window much longer than the ticks we emulated in it means the host stalled
+	   us (or we were paused), which says nothing about how expensive our cycles are.
+	   Likewise a guest that sat idle for most of the window tells us little, since the
+	   fixed costs of each tick swamp the cost of the cycles it did use. */
+	if (!ticks || elapsed > (Bit64u)(GOVERNOR_WINDOW_US * 4) + ticks * 1000) return;
+	if (scheduled <= 0 || executed * 2 < scheduled) return;
+
+	double sample = (busy / (ticks * 1000.0)) * ((double)scheduled / (double)executed);
+	if (sample < 0.001) sample = 0.001;
+	if (!governor.updates) governor.measured = sample;
+	else governor.measured += (sample - governor.measured) * GOVERNOR_SMOOTHING;
+
+	double error = log(Governor_Target() / governor.measured);
+	double step = GOVERNOR_KP * (error - governor.error) + GOVERNOR_KI * error;
+	if (!governor.updates) step = GOVERNOR_KI * error;
+	governor.error = error;
+	governor.updates++;
+
+	if (!CPU_CycleAutoAdjust || CPU_SkipCycleAutoAdjust) return;
+
+	double scale = exp(step);
+	if (scale > GOVERNOR_MAX_STEP) scale = GOVERNOR_MAX_STEP;
+	if (scale < 1.0 / GOVERNOR_MAX_STEP) scale = 1.0 / GOVERNOR_MAX_STEP;
+
+	double new_cmax = (CPU_CycleMax > 0 ? CPU_CycleMax : CPU_CYCLES_LOWER_LIMIT) * scale;
+	if (CPU_CycleLimit > 0 && new_cmax > CPU_CycleLimit) new_cmax = CPU_CycleLimit;
+	if (new_cmax < CPU_CYCLES_LOWER_LIMIT) new_cmax = CPU_CYCLES_LOWER_LIMIT;
+	if (new_cmax > 0x7FFFFFFF) new_cmax = 0x7FFFFFFF;
+	CPU_CycleMax = (Bit32s)new_cmax;
+}
+
+/* Works out how many ticks are due, sleeping until the next one if none are */
+static Bit32u Governor_IncreaseTicks(void) {
+	Bit64u now = GetHostMicroseconds();
+	if (!governor.running) Governor_Reset(now);
+
+	Bit64u due = (now - governor.clockBase) / 1000;
+	if (due > governor.ticksPaced) {
+		Bit64u ticks = due - governor.ticksPaced;
+		if (ticks > GOVERNOR_MAX_TICKS) {
+			/* Too far behind: drop the backlog and pace from here */
+			ticks = GOVERNOR_MAX_TICKS;
+			governor.clockBase = now - (governor.ticksPaced + ticks) * 1000;
+		}
+		governor.ticksPaced += ticks;
+		governor.windowTicks += (Bitu)ticks;
+		if (now - governor.windowStart >= GOVERNOR_WINDOW_US) Governor_Adjust(now);
+		return (Bit32u)ticks;
+	}
+
+	Bit64u next = governor.clockBase + (governor.ticksPaced + 1) * 1000;
+	usleep((useconds_t)(next - now));
+	governor.windowSlept += GetHostMicroseconds() - now;
+	return 0;
+}
+
+void CPU_GetGovernorState(CPU_GovernorState * state) {
+	state->active = CPU_CycleGoverned && governor.running;
+	state->target = Governor_Target();
+	state->measured = governor.measured;
+	state->error = governor.error;
+	state->cycles = CPU_CycleMax;
+	state->updates = governor.updates;
+}
+//--End of modifications
+
 static Bitu Normal_Loop(void) {
 	Bits ret;
 	while (1) {
@@ -164,7 +314,18 @@ increaseticks:
 		ticksAdded = 0;
 		ticksDone = 0;
 		ticksScheduled = 0;
+		//--Added 2026-10-17 for the closed-loop cycle governor
+		governor.running = false;
+		//--End of modifications
+	//--Added 2026-10-17 for the closed-loop cycle governor
+	} else if (CPU_CycleGoverned) {
+		ticksRemain = Governor_IncreaseTicks();
+		ticksLast = GetTicks();
+	//--End of modifications
 	} else {
+		//--Added 2026-10-17 for the closed-loop cycle governor
+		governor.running = false;
+		//--End of modifications
 		Bit32u ticksNew;
 		ticksNew=GetTicks();
 		ticksScheduled += ticksAdded;
@@ -391,6 +552,11 @@ void DOSBOX_Init(void) {
 	Pbool = secprop->Add_bool("aspect",Property::Changeable::Always,false);
 	Pbool->Set_help("Do aspect correction, if your output method doesn't support scaling this can slow things down!.");
 
+	//--Added 2026-10-17 for off-thread scaling
+	Pbool = secprop->Add_bool("threaded",Property::Changeable::Always,false);
+	Pbool->Set_help("Scale and hand over frames on a separate thread, so that slower scalers don't take time away from emulation.");
+	//--End of modifications
+
 	Pmulti = secprop->Add_multi("scaler",Property::Changeable::Always," ");
 	Pmulti->SetValue("normal2x");
 	Pmulti->Set_help("Scaler used to enlarge/enhance low resolution modes.\n"
@@ -437,9 +603,11 @@ void DOSBOX_Init(void) {
 		"                  It usually works, but can fail for certain games.\n"
 		"  'fixed #number' will set a fixed amount of cycles. This is what you usually need if 'auto' fails.\n"
 		"                  (Example: fixed 4000).\n"
-		"  'max'           will allocate as much cycles as your computer is able to handle.\n");
+		"  'max'           will allocate as much cycles as your computer is able to handle.\n"
+		"  'governed'      like max, but adjusts the cycles smoothly to use a share of your computer's time.\n"
+		"                  (Example: governed 75%, default 90%).\n");
 
-	const char* cyclest[] = { "auto","fixed","max","%u",0 };
+	const char* cyclest[] = { "auto","fixed","max","governed","%u",0 };
 	Pstring = Pmulti_remain->GetSection()->Add_string("type",Property::Changeable::Always,"auto");
 	Pmulti_remain->SetValue("auto");
 	Pstring->Set_values(cyclest);
@@ -453,6 +621,28 @@ void DOSBOX_Init(void) {
 	Pint = secprop->Add_int("cycledown",Property::Changeable::Always,20);
 	Pint->SetMinMax(1,1000000);
 	Pint->Set_help("Setting it lower than 100 will be a percentage.");
+
+	//--Added 2026-10-17 for host-idle detection
+	Pbool = secprop->Add_bool("idleskip",Property::Changeable::Always,false);
+	Pbool->Set_help("Skip ahead to the next event when a program waits in a loop that does nothing but\n"
+		"poll the keyboard or the retrace, to save power. Loops that might do anything else\n"
+		"only let the host rest a little. Some programs that time the CPU may run at the wrong speed.");
+	//--End of modifications
+
+#if (C_DYNREC)
+	//--Added 2026-10-17 to make the size of the dynamic core's code cache configurable
+	Pint = secprop->Add_int("dynamic_cache",Property::Changeable::OnlyAtStart,8);
+	Pint->SetMinMax(4,128);
+	Pint->Set_help("Size in megabytes of the dynamic core's cache of translated code.\n"
+		"Large protected-mode games may run more smoothly with a bigger cache.");
+	//--End of modifications
+
+	//--Added 2026-10-17 to allow superblock formation to be turned off
+	Pbool = secprop->Add_bool("dynamic_superblocks",Property::Changeable::OnlyAtStart,true);
+	Pbool->Set_help("Let the dynamic core retranslate frequently-run code into larger blocks\n"
+		"that follow the likely path through jumps and branches.");
+	//--End of modifications
+#endif
 		
 #if C_FPU
 	secprop->AddInitFunction(&FPU_Init);
@@ -479,6 +669,12 @@ void DOSBOX_Init(void) {
 	Pint->SetMinMax(0,100);
 	Pint->Set_help("How many milliseconds of data to keep on top of the blocksize.");
 
+	//--Added 2026-10-17 for polyphase resampling
+	Pstring = secprop->Add_string("polyphase",Property::Changeable::OnlyAtStart,"");
+	Pstring->Set_help("Channels to resample with a band-limited polyphase filter instead of linear interpolation, e.g. SB GUS CDAUDIO, or all.\n"
+		"This keeps channels running at other rates than the mixer from aliasing, at some cost in CPU.");
+	//--End of modifications
+
 	secprop=control->AddSection_prop("midi",&MIDI_Init,true);//done
 	secprop->AddInitFunction(&MPU401_Init,true);//done
 	
@@ -590,6 +786,12 @@ void DOSBOX_Init(void) {
 	Pint->Set_values(oplrates);
 	Pint->Set_help("Sample rate of OPL music emulation. Use 49716 for highest quality (set the mixer rate accordingly).");
 
+	//--Added 2026-10-17 for threaded OPL synthesis
+	Pbool = secprop->Add_bool("oplthread",Property::Changeable::WhenIdle,false);
+	Pbool->Set_help("Synthesise the default/fast OPL emulation on a thread of its own, a couple of milliseconds behind the other sound.\n"
+		"Only applies to those: compat is always synthesised on the emulation thread.");
+	//--End of modifications
+
 
 	secprop=control->AddSection_prop("gus",&GUS_Init,true); //done
 	Pbool = secprop->Add_bool("gus",Property::Changeable::WhenIdle,false); 	
@@ -34,30 +34,89 @@
 
 #include "render_scalers.h"
 
+//--Added 2026-10-17 for off-thread scaling
+#include "SDL.h"
+#include <vector>
+//--End of modifications
+
 Render_t render;
 ScalerLineHandler_t RENDER_DrawLine;
 
+//--Added 2026-10-17 for off-thread scaling
+/* With threaded rendering the emulation thread only copies each frame's source lines into
+   a ring of frames, and the render thread replays them through the usual line handlers,
+   scalers and GFX_EndUpdate in order. The ring is handed over with the head and tail
+   counters alone: only the emulation thread advances head and only the render thread
+   advances tail, the semaphore just wakes the render thread up when it's idle.
+   Anything that reconfigures the renderer waits for the ring to empty first. */
+#define RENDER_FRAME_RING 3
+
+typedef struct {
+	std::vector<Bit8u> lines;		//render.scale.cachePitch bytes per source line
+	std::vector<Bit8u> present;		//Whether each line had data or was passed as 0
+	Bitu count;
+	bool abort;
+	Bitu palFirst, palLast;			//The palette entries that changed before this frame
+	GFX_PalEntry pal[256];
+} RenderFrame_t;
+
+static struct {
+	SDL_Thread *thread;
+	SDL_sem *wake;
+	bool quit;
+	RenderFrame_t frames[RENDER_FRAME_RING];
+	Bitu capacity;
+	RenderFrame_t *queueing;		//The frame the emulation thread is filling, if any
+	Bitu head, tail;
+	bool rendering;					//Only ever true on the render thread
+	ScalerLineHandler_t drawLine;	//The line handler the render code itself goes through
+} renderThread;
+
+/* The render thread must leave RENDER_DrawLine alone, as the emulation thread
+   is calling it to queue up the next frame. */
+static void RENDER_SetLineHandler(ScalerLineHandler_t handler) {
+	renderThread.drawLine = handler;
+	if (!renderThread.rendering) RENDER_DrawLine = handler;
+}
+//--End of modifications
+
+//--Added 2026-10-17 for frame hashing
+/* Every finished frame that drew anything gets a hash of its source pixels and palette,
+   and the generation only moves on when that differs from the previous frame's, so
+   frames with the same generation look exactly the same: e.g. those redrawn in full
+   after clearing the cache. Aborted frames always count as new, as they only drew
+   part of the frame, and so do the first frames after a reset or a redraw request,
+   as they may be drawn with another scaler or at another size. */
+static struct {
+	Bit64u hash;
+	Bitu generation;
+	bool forceNew;
+} renderHash;
+//--End of modifications
+
 static void RENDER_CallBack( GFX_CallBackFunctions_t function );
 
-static void Check_Palette(void) {
+//--Modified 2026-10-17 for off-thread scaling: takes the palette to check, so that the
+//render thread can check the copy that was made of it when its frame was queued
+static void Check_Palette(const GFX_PalEntry *rgb, Bitu first, Bitu last) {
 	/* Clean up any previous changed palette data */
 	if (render.pal.changed) {
 		memset(render.pal.modified, 0, sizeof(render.pal.modified));
 		render.pal.changed = false;
 	}
-	if (render.pal.first>render.pal.last) 
+	if (first>last) 
 		return;
 	Bitu i;
 	switch (render.scale.outMode) {
 	case scalerMode8:
-		GFX_SetPalette(render.pal.first,render.pal.last-render.pal.first+1,(GFX_PalEntry *)&render.pal.rgb[render.pal.first]);
+		GFX_SetPalette(first,last-first+1,(GFX_PalEntry *)&rgb[first]);
 		break;
 	case scalerMode15:
 	case scalerMode16:
-		for (i=render.pal.first;i<=render.pal.last;i++) {
-			Bit8u r=render.pal.rgb[i].red;
-			Bit8u g=render.pal.rgb[i].green;
-			Bit8u b=render.pal.rgb[i].blue;
+		for (i=first;i<=last;i++) {
+			Bit8u r=rgb[i].r;
+			Bit8u g=rgb[i].g;
+			Bit8u b=rgb[i].b;
 			Bit16u newPal = GFX_GetRGB(r,g,b);
 			if (newPal != render.pal.lut.b16[i]) {
 				render.pal.changed = true;
@@ -68,10 +127,10 @@ static void Check_Palette(void) {
 		break;
 	case scalerMode32:
 	default:
-		for (i=render.pal.first;i<=render.pal.last;i++) {
-			Bit8u r=render.pal.rgb[i].red;
-			Bit8u g=render.pal.rgb[i].green;
-			Bit8u b=render.pal.rgb[i].blue;
+		for (i=first;i<=last;i++) {
+			Bit8u r=rgb[i].r;
+			Bit8u g=rgb[i].g;
+			Bit8u b=rgb[i].b;
 			Bit32u newPal = GFX_GetRGB(r,g,b);
 			if (newPal != render.pal.lut.b32[i]) {
 				render.pal.changed = true;
@@ -81,12 +140,15 @@ static void Check_Palette(void) {
 		}
 		break;
 	}
-	/* Setup pal index to startup values */
-	render.pal.first=256;
-	render.pal.last=0;
 }
+//--End of modifications
 
 void RENDER_SetPal(Bit8u entry,Bit8u red,Bit8u green,Bit8u blue) {
+	//--Added 2026-10-17 for frame hashing: programs often rewrite the whole palette with
+	//the same colours, which leaves nothing for Check_Palette to do
+	if (render.pal.rgb[entry].red==red && render.pal.rgb[entry].green==green && render.pal.rgb[entry].blue==blue)
+		return;
+	//--End of modifications
 	render.pal.rgb[entry].red=red;
 	render.pal.rgb[entry].green=green;
 	render.pal.rgb[entry].blue=blue;
@@ -99,20 +161,24 @@ static void RENDER_EmptyLineHandler(const void * src) {
 
 static void RENDER_StartLineHandler(const void * s) {
 	if (s) {
-		const Bitu *src = (Bitu*)s;
-		Bitu *cache = (Bitu*)(render.scale.cacheRead);
-		for (Bits x=render.src.start;x>0;) {
-			if (GCC_UNLIKELY(src[0] != cache[0])) {
-				if (!GFX_StartUpdate(&render.scale.outWrite, &render.scale.outPitch )) {
-					RENDER_DrawLine = RENDER_EmptyLineHandler;
-					return;
-				}
-				render.scale.outWrite += render.scale.outPitch * Scaler_ChangedLines[0];
-				RENDER_DrawLine = render.scale.lineHandler;
-				RENDER_DrawLine( s );
+		//--Modified 2026-10-17 for vectorised line comparison
+		Bitu bytes = render.src.start * sizeof(Bitu);
+		if (GCC_UNLIKELY(Scaler_SIMD->SameBytes(s, render.scale.cacheRead, bytes) < bytes)) {
+		//--End of modifications
+			//--Modified 2026-10-17 for off-thread scaling, dirty-tile tracking and VRAM write tracking
+			if (!GFX_StartUpdate(&render.scale.outWrite, &render.scale.outPitch )) {
+				RENDER_SetLineHandler(RENDER_EmptyLineHandler);
+				//The rest of the frame never reaches the cache, so the VGA code
+				//can't skip the lines it thinks are unchanged next frame
+				render.scale.clearCache = true;
 				return;
 			}
-			x--; src++; cache++;
+			render.scale.outWrite += render.scale.outPitch * Scaler_ChangedLines[0];
+			Scaler_DirtyLine = Scaler_ChangedLines[0];
+			RENDER_SetLineHandler(render.scale.lineHandler);
+			renderThread.drawLine( s );
+			//--End of modifications
+			return;
 		}
 	}
 	render.scale.cacheRead += render.scale.cachePitch;
@@ -122,14 +188,9 @@ static void RENDER_StartLineHandler(const void * s) {
 }
 
 static void RENDER_FinishLineHandler(const void * s) {
-	if (s) {
-		const Bitu *src = (Bitu*)s;
-		Bitu *cache = (Bitu*)(render.scale.cacheRead);
-		for (Bits x=render.src.start;x>0;) {
-			cache[0] = src[0];
-			x--; src++; cache++;
-		}
-	}
+	//--Modified 2026-10-17 for vectorised line copying: the system memcpy already is
+	if (s) memcpy(render.scale.cacheRead, s, render.src.start * sizeof(Bitu));
+	//--End of modifications
 	render.scale.cacheRead += render.scale.cachePitch;
 }
 
@@ -145,6 +206,89 @@ static void RENDER_ClearCacheHandler(const void * src) {
 	render.scale.lineHandler( src );
 }
 
+//--Added 2026-10-17 for off-thread scaling
+static void RENDER_QueueLineHandler(const void * s) {
+	RenderFrame_t *frame = renderThread.queueing;
+	if (GCC_UNLIKELY(frame->count >= renderThread.capacity))
+		return;
+	frame->present[frame->count] = (s != 0);
+	if (s) memcpy(&frame->lines[frame->count * render.scale.cachePitch], s, render.src.start * sizeof(Bitu));
+	frame->count++;
+}
+
+/* Claims the next frame in the ring for the emulation thread to copy lines into.
+   If the render thread has fallen behind, this frame gets skipped instead. */
+static bool RENDER_QueueFrame(void) {
+	Bitu head = renderThread.head;
+	if (head - __atomic_load_n(&renderThread.tail, __ATOMIC_ACQUIRE) >= RENDER_FRAME_RING)
+		return false;
+	RenderFrame_t *frame = &renderThread.frames[head % RENDER_FRAME_RING];
+	frame->count = 0;
+	frame->abort = false;
+	frame->palFirst = 256;
+	frame->palLast = 0;
+	if (render.scale.inMode == scalerMode8) {
+		frame->palFirst = render.pal.first;
+		frame->palLast = render.pal.last;
+		if (frame->palFirst <= frame->palLast)
+			memcpy(&frame->pal[frame->palFirst], &render.pal.rgb[frame->palFirst],
+				(frame->palLast - frame->palFirst + 1) * sizeof(GFX_PalEntry));
+		render.pal.first = 256;
+		render.pal.last = 0;
+	}
+	renderThread.queueing = frame;
+	//The render thread gets every line, whatever it then decides has changed
+	render.fullFrame = true;
+	RENDER_DrawLine = RENDER_QueueLineHandler;
+	render.updating = true;
+	return true;
+}
+
+//Blocks until the render thread has drawn every frame handed to it so far.
+void RENDER_WaitForFrames(void) {
+	while (__atomic_load_n(&renderThread.tail, __ATOMIC_ACQUIRE) != renderThread.head)
+		SDL_Delay(1);
+}
+
+static void RENDER_FinishFrame(bool abort);
+static bool RENDER_BeginFrame(const GFX_PalEntry *rgb, Bitu palFirst, Bitu palLast);
+
+static int RENDER_ThreadMain(void *) {
+	for (;;) {
+		SDL_SemWait(renderThread.wake);
+		if (__atomic_load_n(&renderThread.quit, __ATOMIC_ACQUIRE))
+			return 0;
+		Bitu tail = renderThread.tail;
+		while (tail != __atomic_load_n(&renderThread.head, __ATOMIC_ACQUIRE)) {
+			RenderFrame_t *frame = &renderThread.frames[tail % RENDER_FRAME_RING];
+			renderThread.rendering = true;
+			if (RENDER_BeginFrame(frame->pal, frame->palFirst, frame->palLast)) {
+				for (Bitu i = 0; i < frame->count; i++)
+					renderThread.drawLine(frame->present[i] ? &frame->lines[i * render.scale.cachePitch] : 0);
+				RENDER_FinishFrame(frame->abort);
+			}
+			renderThread.rendering = false;
+			tail++;
+			__atomic_store_n(&renderThread.tail, tail, __ATOMIC_RELEASE);
+		}
+	}
+}
+
+static void RENDER_StopThread(Section * sec) {
+	if (!renderThread.thread)
+		return;
+	RENDER_WaitForFrames();
+	__atomic_store_n(&renderThread.quit, true, __ATOMIC_RELEASE);
+	SDL_SemPost(renderThread.wake);
+	SDL_WaitThread(renderThread.thread, 0);
+	SDL_DestroySemaphore(renderThread.wake);
+	renderThread.thread = 0;
+	renderThread.wake = 0;
+	renderThread.quit = false;
+	renderThread.queueing = 0;
+}
+//--End of modifications
+
 bool RENDER_StartUpdate(void) {
 	if (GCC_UNLIKELY(render.updating))
 		return false;
@@ -155,16 +299,46 @@ bool RENDER_StartUpdate(void) {
 		return false;
 	}
 	render.frameskip.count=0;
+	//--Modified 2026-10-17 for off-thread scaling: the rest of the frame setup is shared with
+	//the render thread. Frames being captured are drawn here, as the capture code isn't threadsafe.
+	if (renderThread.thread) {
+		if (!(CaptureState & (CAPTURE_IMAGE|CAPTURE_VIDEO)))
+			return RENDER_QueueFrame();
+		RENDER_WaitForFrames();
+	}
+	Bitu palFirst = render.pal.first;
+	Bitu palLast = render.pal.last;
 	if (render.scale.inMode == scalerMode8) {
-		Check_Palette();
+		/* Setup pal index to startup values */
+		render.pal.first=256;
+		render.pal.last=0;
+	}
+	if (!RENDER_BeginFrame((GFX_PalEntry *)render.pal.rgb, palFirst, palLast))
+		return false;
+	render.updating = true;
+	return true;
+}
+
+static bool RENDER_BeginFrame(const GFX_PalEntry *rgb, Bitu palFirst, Bitu palLast) {
+	bool fullFrame;
+	//--Modified 2026-10-17 for frame hashing: skip checking the palette when nothing in it
+	//has changed and the last check has nothing to clean up
+	if (render.scale.inMode == scalerMode8 && (palFirst <= palLast || render.pal.changed)) {
+	//--End of modifications
+		Check_Palette(rgb, palFirst, palLast);
 	}
 	render.scale.inLine = 0;
 	render.scale.outLine = 0;
-	render.scale.cacheRead = (Bit8u*)&scalerSourceCache;
+	//--Modified 2026-10-17 for dynamically sized scaler caches
+	render.scale.cacheRead = scalerSourceCache;
+	//--End of modifications
 	render.scale.outWrite = 0;
 	render.scale.outPitch = 0;
 	Scaler_ChangedLines[0] = 0;
 	Scaler_ChangedLineIndex = 0;
+	//--Added 2026-10-17 for dirty-tile tracking
+	Scaler_ClearDirtyTiles();
+	//--End of modifications
 	/* Clearing the cache will first process the line to make sure it's never the same */
 	if (GCC_UNLIKELY( render.scale.clearCache) ) {
 //		LOG_MSG("Clearing cache");
@@ -172,29 +346,90 @@ bool RENDER_StartUpdate(void) {
 		
 		if (GCC_UNLIKELY(!GFX_StartUpdate(&render.scale.outWrite, &render.scale.outPitch )))
 			return false;
-		render.fullFrame = true;
+		fullFrame = true;
 		render.scale.clearCache = false;
-		RENDER_DrawLine = RENDER_ClearCacheHandler;
+		RENDER_SetLineHandler(RENDER_ClearCacheHandler);
 	} else {
 		if (render.pal.changed) {
 			/* Assume pal changes always do a full screen update anyway */
 			if (GCC_UNLIKELY(!GFX_StartUpdate(&render.scale.outWrite, &render.scale.outPitch )))
 				return false;
-			RENDER_DrawLine = render.scale.linePalHandler;
-			render.fullFrame = true;
+			RENDER_SetLineHandler(render.scale.linePalHandler);
+			fullFrame = true;
 		} else {
-			RENDER_DrawLine = RENDER_StartLineHandler;
+			RENDER_SetLineHandler(RENDER_StartLineHandler);
 			if (GCC_UNLIKELY(CaptureState & (CAPTURE_IMAGE|CAPTURE_VIDEO))) 
-				render.fullFrame = true;
+				fullFrame = true;
 			else
-				render.fullFrame = false;
+				fullFrame = false;
 		}
 	}
-	render.updating = true;
+	//The emulation thread has already been told to supply every line
+	if (!renderThread.rendering)
+		render.fullFrame = fullFrame;
 	return true;
 }
+//--End of modifications
+
+//--Added 2026-10-17 for frame hashing
+//FNV-1a over whole 64 bit words, in four independent streams so that the multiplies
+//overlap, then folded together.
+static Bit64u RENDER_Hash(Bit64u hash, const void *data, Bitu bytes) {
+	static const Bit64u prime = 0x100000001b3ULL;
+	const Bit8u *src = (const Bit8u *)data;
+	Bit64u h[4] = { hash, hash ^ 1, hash ^ 2, hash ^ 3 };
+	Bitu x = 0;
+	for (; x + 32 <= bytes; x += 32) {
+		Bit64u w[4];
+		memcpy(w, src + x, sizeof(w));
+		h[0] = (h[0] ^ w[0]) * prime;
+		h[1] = (h[1] ^ w[1]) * prime;
+		h[2] = (h[2] ^ w[2]) * prime;
+		h[3] = (h[3] ^ w[3]) * prime;
+	}
+	for (; x < bytes; x++)
+		h[0] = (h[0] ^ src[x]) * prime;
+	return ((h[0] * prime ^ h[1]) * prime ^ h[2]) * prime ^ h[3];
+}
+
+//Moves the generation on if the frame just drawn differs from the last one.
+static void RENDER_HashFrame(bool abort) {
+	Bit64u hash = RENDER_Hash(0xcbf29ce484222325ULL, scalerSourceCache, render.scale.cachePitch * render.src.height);
+	if (render.scale.inMode == scalerMode8)
+		hash = RENDER_Hash(hash, &render.pal.lut, sizeof(render.pal.lut));
+	if (abort || renderHash.forceNew || hash != renderHash.hash)
+		renderHash.generation++;
+	//An aborted frame's hash doesn't describe what was drawn, so the next one counts as new too
+	renderHash.forceNew = abort;
+	renderHash.hash = hash;
+}
+
+//Returns how many times the content of the frames finished so far has changed, and the
+//hash of the frame being finished if hash isn't NULL. Frames that finish with the same
+//generation are identical, so anything showing or recording them can skip the repeats.
+//Only valid while GFX_EndUpdate is being called.
+Bitu RENDER_GetFrameGeneration(Bit64u *hash) {
+	if (hash) *hash = renderHash.hash;
+	return renderHash.generation;
+}
+//--End of modifications
+
+//--Added 2026-10-17 for dirty-tile tracking
+//Returns the tiles of the output that the frame being finished has changed, one byte per
+//tile in rows of *across tiles. Only valid while GFX_EndUpdate is being called.
+const Bit8u *RENDER_GetDirtyTiles(Bitu *across, Bitu *down, Bitu *tileSize) {
+	*across = Scaler_DirtyTilesAcross;
+	*down = Scaler_DirtyTilesDown;
+	*tileSize = SCALER_TILESIZE;
+	return Scaler_DirtyTiles;
+}
+//--End of modifications
 
 static void RENDER_Halt( void ) {
+	//--Added 2026-10-17 for off-thread scaling
+	RENDER_WaitForFrames();
+	renderThread.queueing = 0;
+	//--End of modifications
 	RENDER_DrawLine = RENDER_EmptyLineHandler;
 	GFX_EndUpdate( 0 );
 	render.updating=false;
@@ -206,7 +441,21 @@ void RENDER_EndUpdate( bool abort ) {
 	if (GCC_UNLIKELY(!render.updating))
 		return;
 	RENDER_DrawLine = RENDER_EmptyLineHandler;
-	if (GCC_UNLIKELY(CaptureState & (CAPTURE_IMAGE|CAPTURE_VIDEO))) {
+	//--Modified 2026-10-17 for off-thread scaling: hand queued frames over to the render thread,
+	//which finishes them the same way.
+	if (renderThread.queueing) {
+		renderThread.queueing->abort = abort;
+		renderThread.queueing = 0;
+		__atomic_store_n(&renderThread.head, renderThread.head + 1, __ATOMIC_RELEASE);
+		SDL_SemPost(renderThread.wake);
+	} else {
+		RENDER_FinishFrame(abort);
+	}
+	render.updating=false;
+}
+
+static void RENDER_FinishFrame(bool abort) {
+	if (GCC_UNLIKELY(CaptureState & (CAPTURE_IMAGE|CAPTURE_VIDEO)) && !renderThread.rendering) {
 		Bitu pitch, flags;
 		flags = 0;
 		if (render.src.dblw != render.src.dblh) {
@@ -217,10 +466,15 @@ void RENDER_EndUpdate( bool abort ) {
 		pitch = render.scale.cachePitch;
 		if (render.frameskip.max)
 			fps /= 1+render.frameskip.max;
+		//--Modified 2026-10-17 for dynamically sized scaler caches
 		CAPTURE_AddImage( render.src.width, render.src.height, render.src.bpp, pitch,
-			flags, fps, (Bit8u *)&scalerSourceCache, (Bit8u*)&render.pal.rgb );
+			flags, fps, scalerSourceCache, (Bit8u*)&render.pal.rgb );
+		//--End of modifications
 	}
 	if ( render.scale.outWrite ) {
+		//--Added 2026-10-17 for frame hashing
+		RENDER_HashFrame(abort);
+		//--End of modifications
 		GFX_EndUpdate( abort? NULL : Scaler_ChangedLines );
 		render.frameskip.hadSkip[render.frameskip.index] = 0;
 	} else {
@@ -233,8 +487,8 @@ void RENDER_EndUpdate( bool abort ) {
 #endif
 	}
 	render.frameskip.index = (render.frameskip.index + 1) & (RENDER_SKIP_CACHE - 1);
-	render.updating=false;
 }
+//--End of modifications
 
 static Bitu MakeAspectTable(Bitu skip,Bitu height,double scaley,Bitu miny) {
 	Bitu i;
@@ -262,6 +516,17 @@ static Bitu MakeAspectTable(Bitu skip,Bitu height,double scaley,Bitu miny) {
 /* static */ void RENDER_Reset( void ) {
 //--End of modifications
 
+	//--Added 2026-10-17 for off-thread scaling: any frame being queued is finished below
+	//with the copy only handler instead.
+	RENDER_WaitForFrames();
+	renderThread.queueing = 0;
+	//--End of modifications
+
+	//--Added 2026-10-17 for frame hashing: the next frame is drawn in full with what may be
+	//another scaler or size, so it must count as new even if its source is the same
+	renderHash.forceNew = true;
+	//--End of modifications
+
 	//--Added 2009-03-06 by Alun Bestor to allow Boxer to override DOSBox's scaler settings
 	boxer_applyRenderingStrategy();
 	//--End of modifications
@@ -365,10 +630,14 @@ forcenormal:
 	}
 	if (complexBlock) {
 #if RENDER_USE_ADVANCED_SCALERS>1
+		//--Disabled 2026-10-17: the complex scalers' caches are now sized to fit each mode
+		/*
 		if ((width >= SCALER_COMPLEXWIDTH - 16) || height >= SCALER_COMPLEXHEIGHT - 16) {
 			LOG_MSG("Scaler can't handle this resolution, going back to normal");
 			goto forcenormal;
 		}
+		*/
+		//--End of modifications
 #else
 		goto forcenormal;
 #endif
@@ -494,6 +763,25 @@ forcenormal:
 	render.scale.blocks = render.src.width / SCALER_BLOCKSIZE;
 	render.scale.lastBlock = render.src.width % SCALER_BLOCKSIZE;
 	render.scale.inHeight = render.src.height;
+	//--Added 2026-10-17 for dynamically sized scaler caches
+	{
+		static const Bitu pixelSizes[4] = { 1, 2, 2, 4 };
+		Bitu complexWidth = render.scale.complexHandler ? render.src.width : 0;
+		Scaler_AllocateCaches(render.scale.cachePitch, render.src.height, complexWidth, pixelSizes[render.scale.outMode]);
+	}
+	//--End of modifications
+	//--Added 2026-10-17 for dirty-tile tracking
+	Scaler_SizeDirtyTiles(width, height, xscale);
+	//--End of modifications
+	//--Added 2026-10-17 for off-thread scaling
+	if (renderThread.thread) {
+		renderThread.capacity = render.src.height;
+		for (Bitu i = 0; i < RENDER_FRAME_RING; i++) {
+			renderThread.frames[i].lines.resize(render.scale.cachePitch * render.src.height);
+			renderThread.frames[i].present.resize(render.src.height);
+		}
+	}
+	//--End of modifications
 	/* Reset the palette change detection to it's initial value */
 	render.pal.first= 0;
 	render.pal.last = 255;
@@ -512,7 +800,13 @@ static void RENDER_CallBack( GFX_CallBackFunctions_t function ) {
 		RENDER_Halt( );	
 		return;
 	} else if (function == GFX_CallBackRedraw) {
+		//--Added 2026-10-17 for off-thread scaling
+		RENDER_WaitForFrames();
+		//--End of modifications
 		render.scale.clearCache = true;
+		//--Added 2026-10-17 for frame hashing: whatever showed the last frame wants it again
+		renderHash.forceNew = true;
+		//--End of modifications
 		return;
 	} else if ( function == GFX_CallBackReset) {
 		GFX_EndUpdate( 0 );	
@@ -587,6 +881,22 @@ void RENDER_Init(Section * sec) {
 	render.aspect=section->Get_bool("aspect");
 	render.frameskip.max=section->Get_int("frameskip");
 	render.frameskip.count=0;
+	//--Added 2026-10-17 for off-thread scaling
+	if (section->Get_bool("threaded") && !renderThread.thread) {
+		renderThread.head = renderThread.tail = 0;
+		renderThread.wake = SDL_CreateSemaphore(0);
+		renderThread.thread = SDL_CreateThread(&RENDER_ThreadMain, 0);
+		if (renderThread.thread) {
+			section->AddDestroyFunction(&RENDER_StopThread,true);
+			//Size the ring for the current mode
+			if (render.src.bpp) RENDER_CallBack( GFX_CallBackReset );
+		} else {
+			LOG_MSG("RENDER:Could not start the render thread, rendering on the emulation thread instead");
+			SDL_DestroySemaphore(renderThread.wake);
+			renderThread.wake = 0;
+		}
+	}
+	//--End of modifications
 	std::string cline;
 	std::string scaler;
 	//Check for commandline paramters and parse them through the configclass so they get checked against allowed values
@@ -632,6 +942,9 @@ void RENDER_Init(Section * sec) {
 				   render.scale.forced))
 		RENDER_CallBack( GFX_CallBackReset );
 
+	//--Added 2026-10-17 for vectorised line comparison and scaling
+	if(!running) Scaler_InitSIMD(scalerSIMDAVX2);
+	//--End of modifications
 	if(!running) render.updating=true;
 	running = true;
 
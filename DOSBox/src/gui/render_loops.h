@@ -27,7 +27,9 @@ static void conc3d(SCALERNAME,SBPP,R)(void) {
 		return;
 	}
 lastagain:
-	if (!CC[render.scale.outLine][0]) {
+	//--Modified 2026-10-17 for dynamically sized scaler caches
+	if (!CC(render.scale.outLine)[0]) {
+	//--End of modifications
 #if defined(SCALERLINEAR) 
 		Bitu scaleLines = SCALERHEIGHT;
 #else
@@ -39,10 +41,23 @@ lastagain:
 		return;
 	}
 	/* Clear the complete line marker */
-	CC[render.scale.outLine][0] = 0;
-	const PTYPE * fc = &FC[render.scale.outLine][1];
+	//--Modified 2026-10-17 for dynamically sized scaler caches
+	CC(render.scale.outLine)[0] = 0;
+	const Bits fcWidth = (Bits)scalerFrameWidth;
+	const PTYPE * fc = &FC(render.scale.outLine)[1];
 	PTYPE * line0=(PTYPE *)(render.scale.outWrite);
-	Bit8u * changed = &CC[render.scale.outLine][1];
+	Bit8u * changed = &CC(render.scale.outLine)[1];
+	//--End of modifications
+	//--Added 2026-10-17 for vectorised HQ patterns: scalers that switch on the pattern of
+	//each pixel's neighbours work it out for a whole block at a time before scaling it
+#if defined(SCALERPATTERNS)
+	Bit8u patterns[SCALER_BLOCKSIZE];
+	const Bit8u * pattern = patterns;
+#define LOOPPATTERNS(_COUNT)	SCALERPATTERNS(_COUNT); pattern = patterns;
+#else
+#define LOOPPATTERNS(_COUNT)
+#endif
+	//--End of modifications
 	Bitu b;
 	for (b=0;b<render.scale.blocks;b++) {
 #if (SCALERHEIGHT > 1) 
@@ -66,6 +81,9 @@ lastagain:
 #if (SCALERHEIGHT > 2) 
 			line2 = (PTYPE *)(((Bit8u*)line0)+ render.scale.outPitch * 2);
 #endif
+			//--Added 2026-10-17 for vectorised HQ patterns
+			LOOPPATTERNS(1)
+			//--End of modifications
 			SCALERFUNC;
 			line0 += SCALERWIDTH * SCALER_BLOCKSIZE;
 			fc += SCALER_BLOCKSIZE;
@@ -77,6 +95,9 @@ lastagain:
 #if (SCALERHEIGHT > 2) 
 			line2 = (PTYPE *)(((Bit8u*)line0)+ render.scale.outPitch * 2);
 #endif
+			//--Added 2026-10-17 for vectorised HQ patterns
+			LOOPPATTERNS(1)
+			//--End of modifications
 			SCALERFUNC;
 		case SCALE_RIGHT:
 #if (SCALERHEIGHT > 1) 			
@@ -93,6 +114,9 @@ lastagain:
 			line2 += SCALERWIDTH * (SCALER_BLOCKSIZE -1);
 #endif
 			fc += SCALER_BLOCKSIZE -1;
+			//--Added 2026-10-17 for vectorised HQ patterns
+			LOOPPATTERNS(1)
+			//--End of modifications
 			SCALERFUNC;
 			line0 += SCALERWIDTH;
 			fc++;
@@ -113,8 +137,16 @@ lastagain:
 			line2 = (PTYPE *)(((Bit8u*)line0)+ render.scale.outPitch * 2);
 #endif
 #endif //defined(SCALERLINEAR)
+			//--Added 2026-10-17 for vectorised HQ patterns
+			LOOPPATTERNS(SCALER_BLOCKSIZE)
+			//--End of modifications
 			for (Bitu i = 0; i<SCALER_BLOCKSIZE;i++) {
 				SCALERFUNC;
+				//--Added 2026-10-17 for vectorised HQ patterns
+#if defined(SCALERPATTERNS)
+				pattern++;
+#endif
+				//--End of modifications
 				line0 += SCALERWIDTH;
 #if (SCALERHEIGHT > 1) 
 				line1 += SCALERWIDTH;
@@ -134,6 +166,9 @@ lastagain:
 #endif //defined(SCALERLINEAR)
 			break;
 		}
+		//--Added 2026-10-17 for dirty-tile tracking
+		ScalerDirtySpan(b * SCALER_BLOCKSIZE, (b + 1) * SCALER_BLOCKSIZE);
+		//--End of modifications
 	}
 #if defined(SCALERLINEAR) 
 	Bitu scaleLines = SCALERHEIGHT;
@@ -150,6 +185,10 @@ lastagain:
 		goto lastagain;
 }
 
+//--Added 2026-10-17 for vectorised HQ patterns
+#undef LOOPPATTERNS
+//--End of modifications
+
 #if !defined(SCALERLINEAR) 
 #define SCALERLINEAR 1
 #include "render_loops.h"
@@ -24,9 +24,15 @@
 #include "dosbox.h"
 #include "render.h"
 #include <string.h>
-
-Bit8u Scaler_Aspect[SCALER_MAXHEIGHT];
-Bit16u Scaler_ChangedLines[SCALER_MAXHEIGHT];
+//--Added 2026-10-17 for dynamically sized scaler caches
+#include <stdlib.h>
+//--End of modifications
+
+//--Modified 2026-10-17 for dynamically sized scaler caches: the complex scalers skip an
+//extra line at the top, which they can now do at the largest heights too
+Bit8u Scaler_Aspect[SCALER_MAXHEIGHT+1];
+Bit16u Scaler_ChangedLines[SCALER_MAXHEIGHT+1];
+//--End of modifications
 Bitu Scaler_ChangedLineIndex;
 
 static union {
@@ -34,11 +40,118 @@ static union {
 	Bit16u b16 [4][SCALER_MAXWIDTH*3];
 	Bit8u b8 [4][SCALER_MAXWIDTH*3];
 } scalerWriteCache;
-//scalerFrameCache_t scalerFrameCache;
-scalerSourceCache_t scalerSourceCache;
+//--Modified 2026-10-17 for dynamically sized scaler caches
+Bit8u *scalerSourceCache;
+#if RENDER_USE_ADVANCED_SCALERS>1
+Bit8u *scalerFrameCache;
+Bit8u *scalerChangeCache;
+Bitu scalerFrameWidth;
+Bitu scalerChangeWidth;
+#endif
+
+/* All the caches share one block, with each of them aligned to a cache line. The block is
+   only reallocated when a mode needs more than it has, or much less than it has, so that
+   switching back and forth between modes doesn't keep freeing and allocating it. */
+#define SCALER_CACHEALIGN	64
+static Bit8u *scalerCacheBlock;
+static Bitu scalerCacheSize;
+
+static Bitu Scaler_AlignCache(Bitu size) {
+	return (size + SCALER_CACHEALIGN - 1) & ~(Bitu)(SCALER_CACHEALIGN - 1);
+}
+
+void Scaler_AllocateCaches(Bitu sourcePitch, Bitu height, Bitu complexWidth, Bitu complexPixelSize) {
+	Bitu sourceSize = Scaler_AlignCache(sourcePitch * height);
+	Bitu frameSize = 0, changeSize = 0;
+#if RENDER_USE_ADVANCED_SCALERS>1
+	/* The complex scalers read a pixel either side of each line and up to two lines
+	   around it, and mark the blocks either side of each changed block */
+	Bitu frameHeight = height + 4;
+	if (complexWidth) {
+		scalerFrameWidth = (complexWidth + 2 * SCALER_BLOCKSIZE) & ~(SCALER_BLOCKSIZE - 1);
+		scalerChangeWidth = scalerFrameWidth / SCALER_BLOCKSIZE;
+		frameSize = Scaler_AlignCache(scalerFrameWidth * frameHeight * complexPixelSize);
+		changeSize = Scaler_AlignCache(scalerChangeWidth * frameHeight);
+	}
+#endif
+	Bitu size = sourceSize + frameSize + changeSize;
+	if (!scalerCacheBlock || size > scalerCacheSize || size < scalerCacheSize / 4) {
+		free(scalerCacheBlock);
+		scalerCacheBlock = (Bit8u *)malloc(size + SCALER_CACHEALIGN);
+		if (!scalerCacheBlock)
+			E_Exit("RENDER:Can't allocate %d bytes for the scaler caches", size);
+		scalerCacheSize = size;
+	}
+	scalerSourceCache = (Bit8u *)Scaler_AlignCache((Bitu)scalerCacheBlock);
 #if RENDER_USE_ADVANCED_SCALERS>1
-scalerChangeCache_t scalerChangeCache;
+	scalerFrameCache = scalerSourceCache + sourceSize;
+	scalerChangeCache = scalerFrameCache + frameSize;
+	/* Start from a blank frame with nothing marked as changed, as the static caches did */
+	memset(scalerFrameCache, 0, frameSize + changeSize);
 #endif
+}
+//--End of modifications
+
+//--Added 2026-10-17 for dirty-tile tracking
+Bit8u *Scaler_DirtyTiles;
+Bitu Scaler_DirtyTilesAcross;
+Bitu Scaler_DirtyTilesDown;
+Bitu Scaler_DirtyLine;
+static Bitu scalerTileCount;
+static Bitu scalerTileScale;
+/* The span of source pixels redrawn on the current line, empty when left >= right */
+static Bitu scalerDirtyLeft = ~(Bitu)0;
+static Bitu scalerDirtyRight = 0;
+
+void Scaler_SizeDirtyTiles(Bitu width, Bitu height, Bitu xscale) {
+	Scaler_DirtyTilesAcross = (width + SCALER_TILESIZE - 1) / SCALER_TILESIZE;
+	Scaler_DirtyTilesDown = (height + SCALER_TILESIZE - 1) / SCALER_TILESIZE;
+	scalerTileScale = xscale;
+	Bitu count = Scaler_DirtyTilesAcross * Scaler_DirtyTilesDown;
+	if (count > scalerTileCount) {
+		free(Scaler_DirtyTiles);
+		Scaler_DirtyTiles = (Bit8u *)malloc(count);
+		if (!Scaler_DirtyTiles)
+			E_Exit("RENDER:Can't allocate %d bytes for the dirty tiles", count);
+		scalerTileCount = count;
+	}
+	Scaler_ClearDirtyTiles();
+}
+
+void Scaler_ClearDirtyTiles(void) {
+	if (Scaler_DirtyTiles)
+		memset(Scaler_DirtyTiles, 0, Scaler_DirtyTilesAcross * Scaler_DirtyTilesDown);
+	Scaler_DirtyLine = 0;
+	scalerDirtyLeft = ~(Bitu)0;
+	scalerDirtyRight = 0;
+}
+
+static void Scaler_MarkDirtyTiles(Bitu count) {
+	Bitu right = scalerDirtyRight;
+	if (right > render.src.width) right = render.src.width;
+	Bitu left = scalerDirtyLeft;
+	scalerDirtyLeft = ~(Bitu)0;
+	scalerDirtyRight = 0;
+	if (left >= right || !count || !Scaler_DirtyTiles) return;
+
+	Bitu firstColumn = left * scalerTileScale / SCALER_TILESIZE;
+	Bitu lastColumn = (right * scalerTileScale - 1) / SCALER_TILESIZE;
+	Bitu firstRow = Scaler_DirtyLine / SCALER_TILESIZE;
+	Bitu lastRow = (Scaler_DirtyLine + count - 1) / SCALER_TILESIZE;
+	if (lastColumn >= Scaler_DirtyTilesAcross) lastColumn = Scaler_DirtyTilesAcross - 1;
+	if (lastRow >= Scaler_DirtyTilesDown) lastRow = Scaler_DirtyTilesDown - 1;
+	for (Bitu row = firstRow; row <= lastRow; row++) {
+		Bit8u *tiles = &Scaler_DirtyTiles[row * Scaler_DirtyTilesAcross];
+		for (Bitu column = firstColumn; column <= lastColumn; column++)
+			tiles[column] = 1;
+	}
+}
+
+static INLINE void ScalerDirtySpan( Bitu left, Bitu right ) {
+	if (left < scalerDirtyLeft) scalerDirtyLeft = left;
+	if (right > scalerDirtyRight) scalerDirtyRight = right;
+}
+//--End of modifications
 
 #define _conc2(A,B) A ## B
 #define _conc3(A,B,C) A ## B ## C
@@ -53,6 +166,10 @@ scalerChangeCache_t scalerChangeCache;
 #define conc3d(A,B,C) _conc5(A,_,B,_,C)
 #define conc4d(A,B,C,D) _conc7(A,_,B,_,C,_,D)
 
+//--Added 2026-10-17 for vectorised line comparison and scaling
+#include "render_simd.h"
+//--End of modifications
+
 static INLINE void BituMove( void *_dst, const void * _src, Bitu size) {
 	Bitu * dst=(Bitu *)(_dst);
 	const Bitu * src=(Bitu *)(_src);
@@ -68,6 +185,10 @@ static INLINE void ScalerAddLines( Bitu changed, Bitu count ) {
 		Scaler_ChangedLines[++Scaler_ChangedLineIndex] = count;
 	}
 	render.scale.outWrite += render.scale.outPitch * count;
+	//--Added 2026-10-17 for dirty-tile tracking
+	if (changed) Scaler_MarkDirtyTiles(count);
+	Scaler_DirtyLine += count;
+	//--End of modifications
 }
 
 
@@ -90,7 +211,9 @@ static INLINE void ScalerAddLines( Bitu changed, Bitu count ) {
 	((((P0&  greenMask)*W0+(P1&  greenMask)*W1+(P2&  greenMask)*W2+(P3&  greenMask)*W3)/(W0+W1+W2+W3)) & greenMask)
 
 
-#define CC scalerChangeCache
+//--Modified 2026-10-17 for dynamically sized scaler caches
+#define CC(_LINE) (scalerChangeCache + (_LINE) * scalerChangeWidth)
+//--End of modifications
 
 /* Include the different rendering routines */
 #define SBPP 8
@@ -360,6 +483,66 @@ ScalerSimpleBlock_t ScaleRGB3x = {
 }};
 #endif
 
+//--Added 2026-10-17 for vectorised line comparison and scaling:
+#if RENDER_USE_ADVANCED_SCALERS>0
+#define SCALER_SPANS_ADVANCED(_LEVEL)															\
+{	0,	conc3d(TV2x,15,_LEVEL),		conc3d(TV2x,16,_LEVEL),		conc3d(TV2x,32,_LEVEL)	},		\
+{	0,	conc3d(TV3x,15,_LEVEL),		conc3d(TV3x,16,_LEVEL),		conc3d(TV3x,32,_LEVEL)	},		\
+{	0,	conc3d(RGB2x,15,_LEVEL),	conc3d(RGB2x,16,_LEVEL),	conc3d(RGB2x,32,_LEVEL)	},		\
+{	0,	conc3d(RGB3x,15,_LEVEL),	conc3d(RGB3x,16,_LEVEL),	conc3d(RGB3x,32,_LEVEL)	},		\
+{	0,	conc3d(Scan2x,15,_LEVEL),	conc3d(Scan2x,16,_LEVEL),	conc3d(Scan2x,32,_LEVEL)	},		\
+{	0,	conc3d(Scan3x,15,_LEVEL),	conc3d(Scan3x,16,_LEVEL),	conc3d(Scan3x,32,_LEVEL)	},
+#else
+#define SCALER_SPANS_ADVANCED(_LEVEL)
+#endif
+
+#define SCALER_SPANS(_LEVEL) {																					\
+{	conc3d(Normal1x,8,_LEVEL),	conc3d(Normal1x,15,_LEVEL),	conc3d(Normal1x,16,_LEVEL),	conc3d(Normal1x,32,_LEVEL)	},	\
+{	conc3d(NormalDw,8,_LEVEL),	conc3d(NormalDw,15,_LEVEL),	conc3d(NormalDw,16,_LEVEL),	conc3d(NormalDw,32,_LEVEL)	},	\
+{	conc3d(NormalDh,8,_LEVEL),	conc3d(NormalDh,15,_LEVEL),	conc3d(NormalDh,16,_LEVEL),	conc3d(NormalDh,32,_LEVEL)	},	\
+{	conc3d(Normal2x,8,_LEVEL),	conc3d(Normal2x,15,_LEVEL),	conc3d(Normal2x,16,_LEVEL),	conc3d(Normal2x,32,_LEVEL)	},	\
+{	conc3d(Normal3x,8,_LEVEL),	conc3d(Normal3x,15,_LEVEL),	conc3d(Normal3x,16,_LEVEL),	conc3d(Normal3x,32,_LEVEL)	},	\
+SCALER_SPANS_ADVANCED(_LEVEL)																					\
+}
+
+#if RENDER_USE_ADVANCED_SCALERS>2
+#define SCALER_HQPATTERNS(_LEVEL) conc2(HqPatterns_,_LEVEL)
+#else
+#define SCALER_HQPATTERNS(_LEVEL) 0
+#endif
+
+static const ScalerSIMDBlock_t ScalerSIMDNone = {
+	scalerSIMDNone, "none", SameBytes_None, {{0}}, SCALER_HQPATTERNS(None)
+};
+
+#if defined(RENDER_SIMD_SSE2)
+static const ScalerSIMDBlock_t ScalerSIMDSSE2 = {
+	scalerSIMDSSE2, "sse2", SameBytes_SSE2, SCALER_SPANS(SSE2), SCALER_HQPATTERNS(SSE2)
+};
+#endif
+
+#if defined(RENDER_SIMD_AVX2)
+static const ScalerSIMDBlock_t ScalerSIMDAVX2 = {
+	//The HQ patterns use the SSE2 version: an 8 pixel AVX2 version measured 20-40% slower
+	scalerSIMDAVX2, "avx2", SameBytes_AVX2, SCALER_SPANS(AVX2), SCALER_HQPATTERNS(SSE2)
+};
+#endif
+
+const ScalerSIMDBlock_t *Scaler_SIMD = &ScalerSIMDNone;
+
+scalerSIMD_t Scaler_InitSIMD(scalerSIMD_t maxLevel) {
+	Scaler_SIMD = &ScalerSIMDNone;
+#if defined(RENDER_SIMD_SSE2)
+	if (maxLevel >= scalerSIMDSSE2) Scaler_SIMD = &ScalerSIMDSSE2;
+#endif
+#if defined(RENDER_SIMD_AVX2)
+	__builtin_cpu_init();
+	if (maxLevel >= scalerSIMDAVX2 && __builtin_cpu_supports("avx2")) Scaler_SIMD = &ScalerSIMDAVX2;
+#endif
+	return Scaler_SIMD->level;
+}
+//--End of modifications
+
 
 /* Complex scalers */
 
@@ -21,19 +21,18 @@
 
 //#include "render.h"
 #include "video.h"
+//--Modified 2026-10-17 for dynamically sized scaler caches: the caches are now sized for
+//each mode by Scaler_AllocateCaches, so these only limit the modes that can be rendered
+//and the complex scalers can handle the same modes as the rest.
 #if RENDER_USE_ADVANCED_SCALERS>0
-#define SCALER_MAXWIDTH		1280 
-#define SCALER_MAXHEIGHT	1024
+#define SCALER_MAXWIDTH		1600 
+#define SCALER_MAXHEIGHT	1200
 #else
 // reduced to save some memory
 #define SCALER_MAXWIDTH		800 
 #define SCALER_MAXHEIGHT	600
 #endif
-
-#if RENDER_USE_ADVANCED_SCALERS>1
-#define SCALER_COMPLEXWIDTH		800
-#define SCALER_COMPLEXHEIGHT	600
-#endif
+//--End of modifications
 
 #define SCALER_BLOCKSIZE	16
 
@@ -66,24 +65,33 @@ extern Bit8u Scaler_Aspect[];
 extern Bit8u diff_table[];
 extern Bitu Scaler_ChangedLineIndex;
 extern Bit16u Scaler_ChangedLines[];
+//--Modified 2026-10-17 for dynamically sized scaler caches
+/* The source cache holds render.scale.cachePitch bytes for each source line. The complex
+   scalers' frame cache holds scalerFrameWidth output pixels for each line, with a border
+   around the source pixels, and the change cache a byte for each block of those. */
+extern Bit8u *scalerSourceCache;
 #if RENDER_USE_ADVANCED_SCALERS>1
-/* Not entirely happy about those +2's since they make a non power of 2, with muls instead of shift */
-typedef Bit8u scalerChangeCache_t [SCALER_COMPLEXHEIGHT][SCALER_COMPLEXWIDTH / SCALER_BLOCKSIZE] ;
-typedef union {
-	Bit32u b32	[SCALER_COMPLEXHEIGHT] [SCALER_COMPLEXWIDTH];
-	Bit16u b16	[SCALER_COMPLEXHEIGHT] [SCALER_COMPLEXWIDTH];
-	Bit8u b8	[SCALER_COMPLEXHEIGHT] [SCALER_COMPLEXWIDTH];
-} scalerFrameCache_t;
-#endif
-typedef union {
-	Bit32u b32	[SCALER_MAXHEIGHT] [SCALER_MAXWIDTH];
-	Bit16u b16	[SCALER_MAXHEIGHT] [SCALER_MAXWIDTH];
-	Bit8u b8	[SCALER_MAXHEIGHT] [SCALER_MAXWIDTH];
-} scalerSourceCache_t;
-extern scalerSourceCache_t scalerSourceCache;
-#if RENDER_USE_ADVANCED_SCALERS>1
-extern scalerChangeCache_t scalerChangeCache;
+extern Bit8u *scalerFrameCache;
+extern Bit8u *scalerChangeCache;
+extern Bitu scalerFrameWidth;
+extern Bitu scalerChangeWidth;
 #endif
+void Scaler_AllocateCaches(Bitu sourcePitch, Bitu height, Bitu complexWidth, Bitu complexPixelSize);
+//--End of modifications
+//--Added 2026-10-17 for dirty-tile tracking
+/* The output is divided into SCALER_TILESIZE pixel square tiles, with a byte for each tile
+   that is set when the frame changed any pixels within it. The scalers note the span of
+   source pixels they redrew on each line, and ScalerAddLines marks the tiles that span
+   covers once it knows which output lines it ended up on. Scaler_DirtyLine is the output
+   line the next source line will be drawn at. */
+#define SCALER_TILESIZE 32
+extern Bit8u *Scaler_DirtyTiles;
+extern Bitu Scaler_DirtyTilesAcross;
+extern Bitu Scaler_DirtyTilesDown;
+extern Bitu Scaler_DirtyLine;
+void Scaler_SizeDirtyTiles(Bitu width, Bitu height, Bitu xscale);
+void Scaler_ClearDirtyTiles(void);
+//--End of modifications
 typedef ScalerLineHandler_t ScalerLineBlock_t[5][4];
 
 typedef struct {
@@ -103,6 +111,39 @@ typedef struct {
 } ScalerSimpleBlock_t;
 
 
+//--Added 2026-10-17 for vectorised line comparison and scaling:
+//Vector versions of the simple scalers work on pixels already converted to the output
+//depth, one span of changed pixels at a time.
+typedef void (*ScalerSpanHandler_t)(const void *src, void *line0, void *line1, void *line2, Bitu count);
+
+typedef enum {
+	scalerSpanNormal1x, scalerSpanNormalDw, scalerSpanNormalDh, scalerSpanNormal2x, scalerSpanNormal3x,
+#if RENDER_USE_ADVANCED_SCALERS>0
+	scalerSpanTV2x, scalerSpanTV3x, scalerSpanRGB2x, scalerSpanRGB3x, scalerSpanScan2x, scalerSpanScan3x,
+#endif
+	scalerSpanLast
+} scalerSpan_t;
+
+typedef enum {
+	scalerSIMDNone, scalerSIMDSSE2, scalerSIMDAVX2, scalerSIMDLast
+} scalerSIMD_t;
+
+typedef struct {
+	scalerSIMD_t level;
+	const char *name;
+	//Returns how many bytes at the start of src and cache match, in whole Bitu's.
+	Bitu (*SameBytes)(const void *src, const void *cache, Bitu bytes);
+	//Indexed by span and output scalerMode_t, 0 where there is no vector version.
+	ScalerSpanHandler_t Span[scalerSpanLast][4];
+	//Works out the HQ scalers' neighbour patterns from three rows of YUV pixels.
+	void (*HqPatterns)(const Bit32u *yuv0, const Bit32u *yuv1, const Bit32u *yuv2, Bit8u *patterns, Bitu count);
+} ScalerSIMDBlock_t;
+
+extern const ScalerSIMDBlock_t *Scaler_SIMD;
+//Picks the best level up to maxLevel that this CPU supports, and returns it.
+scalerSIMD_t Scaler_InitSIMD(scalerSIMD_t maxLevel);
+//--End of modifications
+
 #define SCALE_LEFT	0x1
 #define SCALE_RIGHT	0x2
 #define SCALE_FULL	0x4
@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2002-2010  The DOSBox Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+//Vector versions of the line cache comparison and the building blocks of the simple
+//scalers. Scaler_InitSIMD in render_scalers.cpp picks the best level the CPU supports.
+//SSE2 is used whenever the compiler targets it, AVX2 is compiled separately and only
+//used after checking the CPU: other architectures get the plain C versions.
+
+#if defined(__SSE2__)
+#define RENDER_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(RENDER_SIMD_SSE2) && defined(__GNUC__) && \
+	(defined(__clang__) || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define RENDER_SIMD_AVX2 1
+#define RENDER_SIMD_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+
+/* Line comparison: returns how many bytes at the start of the two lines are the same,
+   counted in whole Bitu's as the scalers compare them. bytes must be a multiple of a Bitu. */
+
+static Bitu SameBytes_None(const void * _src, const void * _cache, Bitu bytes) {
+	const Bitu * src=(const Bitu *)_src;
+	const Bitu * cache=(const Bitu *)_cache;
+	Bitu words=bytes/sizeof(Bitu);
+	Bitu x=0;
+	while (x<words && src[x]==cache[x]) x++;
+	return x*sizeof(Bitu);
+}
+
+#if defined(RENDER_SIMD_SSE2)
+static Bitu SameBytes_SSE2(const void * _src, const void * _cache, Bitu bytes) {
+	const Bit8u * src=(const Bit8u *)_src;
+	const Bit8u * cache=(const Bit8u *)_cache;
+	Bitu x=0;
+	for (;x+16<=bytes;x+=16) {
+		unsigned int same=_mm_movemask_epi8(_mm_cmpeq_epi8(
+			_mm_loadu_si128((const __m128i *)(src+x)),_mm_loadu_si128((const __m128i *)(cache+x))));
+		if (same!=0xffff) return (x+__builtin_ctz(~same)) & ~(sizeof(Bitu)-1);
+	}
+	return x+SameBytes_None(src+x,cache+x,bytes-x);
+}
+#endif
+
+#if defined(RENDER_SIMD_AVX2)
+static RENDER_SIMD_AVX2_TARGET Bitu SameBytes_AVX2(const void * _src, const void * _cache, Bitu bytes) {
+	const Bit8u * src=(const Bit8u *)_src;
+	const Bit8u * cache=(const Bit8u *)_cache;
+	Bitu x=0;
+	for (;x+32<=bytes;x+=32) {
+		unsigned int same=_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+			_mm256_loadu_si256((const __m256i *)(src+x)),_mm256_loadu_si256((const __m256i *)(cache+x))));
+		if (same!=0xffffffff) return (x+__builtin_ctz(~same)) & ~(sizeof(Bitu)-1);
+	}
+	return x+SameBytes_None(src+x,cache+x,bytes-x);
+}
+#endif
+
+
+/* Building blocks for the vectorised spans in render_simd_span.h. These are written
+   against the V() prefix and the VTYPE/VAND/VSTOREPAIR etc. macros the span header
+   defines for each level, so the same code serves 128 and 256 bit registers: every
+   operation works within 128 bit lanes and VSTOREPAIR/VSTORETRIPLE put the lanes
+   back in order when storing. */
+
+#define V(_OP) conc2(VOP,_OP)
+#define VSET16(_VAL) V(set1_epi16)((Bit16s)(_VAL))
+#define VSET32(_VAL) V(set1_epi32)((Bit32s)(_VAL))
+
+//Interleaves the pixels of two vectors: a0 b0 a1 b1 ...
+#define SIMD_STORE2(_DST,_A,_B,_BITS)											\
+	VSTOREPAIR(_DST,V(conc2(unpacklo_epi,_BITS))(_A,_B),V(conc2(unpackhi_epi,_BITS))(_A,_B))
+
+//Interleaves the pixels of three vectors: a0 b0 c0 a1 b1 c1 ...
+#define SIMD_INTERLEAVE3_32(_A,_B,_C,_O0,_O1,_O2) {								\
+	VTYPE i3_ab=V(unpacklo_epi32)(_A,_B),i3_ca=V(unpacklo_epi32)(_C,_A);		\
+	VTYPE i3_bc=V(unpacklo_epi32)(_B,_C),i3_ab2=V(unpackhi_epi32)(_A,_B);		\
+	VTYPE i3_ca2=V(unpackhi_epi32)(_C,_A),i3_bc2=V(unpackhi_epi32)(_B,_C);		\
+	_O0=VCASTSI(V(shuffle_ps)(VCASTPS(i3_ab),VCASTPS(i3_ca),_MM_SHUFFLE(3,0,1,0)));	\
+	_O1=VCASTSI(V(shuffle_ps)(VCASTPS(i3_bc),VCASTPS(i3_ab2),_MM_SHUFFLE(1,0,3,2)));	\
+	_O2=VCASTSI(V(shuffle_ps)(VCASTPS(i3_ca2),VCASTPS(i3_bc2),_MM_SHUFFLE(3,2,3,0)));	\
+}
+
+//16 bit pixels are sign extended to 32 bits, interleaved and packed back down again
+#define SIMD_INTERLEAVE3_16(_A,_B,_C,_O0,_O1,_O2) {								\
+	VTYPE i16_al=V(srai_epi32)(V(unpacklo_epi16)(_A,_A),16);					\
+	VTYPE i16_ah=V(srai_epi32)(V(unpackhi_epi16)(_A,_A),16);					\
+	VTYPE i16_bl=V(srai_epi32)(V(unpacklo_epi16)(_B,_B),16);					\
+	VTYPE i16_bh=V(srai_epi32)(V(unpackhi_epi16)(_B,_B),16);					\
+	VTYPE i16_cl=V(srai_epi32)(V(unpacklo_epi16)(_C,_C),16);					\
+	VTYPE i16_ch=V(srai_epi32)(V(unpackhi_epi16)(_C,_C),16);					\
+	VTYPE i16_l0,i16_l1,i16_l2,i16_h0,i16_h1,i16_h2;							\
+	SIMD_INTERLEAVE3_32(i16_al,i16_bl,i16_cl,i16_l0,i16_l1,i16_l2);				\
+	SIMD_INTERLEAVE3_32(i16_ah,i16_bh,i16_ch,i16_h0,i16_h1,i16_h2);				\
+	_O0=V(packs_epi32)(i16_l0,i16_l1);											\
+	_O1=V(packs_epi32)(i16_l2,i16_h0);											\
+	_O2=V(packs_epi32)(i16_h1,i16_h2);											\
+}
+
+//8 bit pixels are zero extended to 16 bits in the same way
+#define SIMD_INTERLEAVE3_8(_A,_B,_C,_O0,_O1,_O2) {								\
+	VTYPE i8_al=V(unpacklo_epi8)(_A,VZERO),i8_ah=V(unpackhi_epi8)(_A,VZERO);	\
+	VTYPE i8_bl=V(unpacklo_epi8)(_B,VZERO),i8_bh=V(unpackhi_epi8)(_B,VZERO);	\
+	VTYPE i8_cl=V(unpacklo_epi8)(_C,VZERO),i8_ch=V(unpackhi_epi8)(_C,VZERO);	\
+	VTYPE i8_l0,i8_l1,i8_l2,i8_h0,i8_h1,i8_h2;									\
+	SIMD_INTERLEAVE3_16(i8_al,i8_bl,i8_cl,i8_l0,i8_l1,i8_l2);					\
+	SIMD_INTERLEAVE3_16(i8_ah,i8_bh,i8_ch,i8_h0,i8_h1,i8_h2);					\
+	_O0=V(packus_epi16)(i8_l0,i8_l1);											\
+	_O1=V(packus_epi16)(i8_l2,i8_h0);											\
+	_O2=V(packus_epi16)(i8_h1,i8_h2);											\
+}
+
+#define SIMD_STORE3(_DST,_A,_B,_C,_BITS) {										\
+	VTYPE s3_0,s3_1,s3_2;														\
+	conc2(SIMD_INTERLEAVE3_,_BITS)(_A,_B,_C,s3_0,s3_1,s3_2);					\
+	VSTORETRIPLE(_DST,s3_0,s3_1,s3_2);											\
+}
+
+//The TV scalers' darkened pixel: each channel times 5 and shifted right.
+//At 32bpp this works on the bytes directly, the alpha byte ends up 0 as with the masks.
+#define SIMD_TV_32(_P,_SHIFT)													\
+	VAND(V(packus_epi16)(														\
+		V(srli_epi16)(V(mullo_epi16)(V(unpacklo_epi8)(_P,VZERO),VSET16(5)),_SHIFT),	\
+		V(srli_epi16)(V(mullo_epi16)(V(unpackhi_epi8)(_P,VZERO),VSET16(5)),_SHIFT)),	\
+		VSET32(0x00ffffff))
+
+//At 15/16bpp the red and green fields have at least _SHIFT zero bits below them, so
+//shifting first gives the same result as the C version while staying within 16 bits.
+#define SIMD_TV_16(_P,_SHIFT)													\
+	VOR(VOR(																	\
+		VAND(V(mullo_epi16)(V(srli_epi16)(VAND(_P,VSET16(redMask)),_SHIFT),VSET16(5)),VSET16(redMask)),	\
+		VAND(V(mullo_epi16)(V(srli_epi16)(VAND(_P,VSET16(greenMask)),_SHIFT),VSET16(5)),VSET16(greenMask))),	\
+		VAND(V(srli_epi16)(V(mullo_epi16)(VAND(_P,VSET16(blueMask)),VSET16(5)),_SHIFT),VSET16(blueMask)))
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2002-2010  The DOSBox Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+//Vectorised span of a simple scaler, included by render_simple.h once per output depth.
+//A span scales count pixels that have already been converted to the output depth,
+//writing them in the same way as the scaler's SCALERFUNC: SCALERSPANFUNC gives the
+//vector version of SCALERFUNC, built from SPAN1/SPAN2/SPAN3 and the pixel operations below.
+//This includes itself once for each vector level the compiler supports.
+
+#if !defined(SIMDNAME)
+
+#if defined(RENDER_SIMD_SSE2)
+#define SIMDNAME		SSE2
+#define SIMDTARGET
+#define VOP				_mm_
+#define VTYPE			__m128i
+#define VBYTES			16
+#define VLOAD(_SRC)		_mm_loadu_si128((const __m128i *)(_SRC))
+#define VSTORE(_DST,_V)	_mm_storeu_si128((__m128i *)(_DST),_V)
+#define VZERO			_mm_setzero_si128()
+#define VAND			_mm_and_si128
+#define VOR				_mm_or_si128
+#define VCASTPS			_mm_castsi128_ps
+#define VCASTSI			_mm_castps_si128
+#define VSTOREPAIR(_DST,_LO,_HI) {									\
+	VSTORE(_DST,_LO);												\
+	VSTORE((Bit8u *)(_DST)+VBYTES,_HI);								\
+}
+#define VSTORETRIPLE(_DST,_O0,_O1,_O2) {							\
+	VSTORE(_DST,_O0);												\
+	VSTORE((Bit8u *)(_DST)+VBYTES,_O1);								\
+	VSTORE((Bit8u *)(_DST)+VBYTES*2,_O2);							\
+}
+#include "render_simd_span.h"
+#undef SIMDNAME
+#undef SIMDTARGET
+#undef VOP
+#undef VTYPE
+#undef VBYTES
+#undef VLOAD
+#undef VSTORE
+#undef VZERO
+#undef VAND
+#undef VOR
+#undef VCASTPS
+#undef VCASTSI
+#undef VSTOREPAIR
+#undef VSTORETRIPLE
+#endif
+
+#if defined(RENDER_SIMD_AVX2)
+#define SIMDNAME		AVX2
+#define SIMDTARGET		RENDER_SIMD_AVX2_TARGET
+#define VOP				_mm256_
+#define VTYPE			__m256i
+#define VBYTES			32
+#define VLOAD(_SRC)		_mm256_loadu_si256((const __m256i *)(_SRC))
+#define VSTORE(_DST,_V)	_mm256_storeu_si256((__m256i *)(_DST),_V)
+#define VZERO			_mm256_setzero_si256()
+#define VAND			_mm256_and_si256
+#define VOR				_mm256_or_si256
+#define VCASTPS			_mm256_castsi256_ps
+#define VCASTSI			_mm256_castps_si256
+//Each 128 bit lane has produced its own run of output, so swap the halves into order
+#define VSTOREPAIR(_DST,_LO,_HI) {									\
+	VTYPE sp_lo=_LO,sp_hi=_HI;										\
+	VSTORE(_DST,_mm256_permute2x128_si256(sp_lo,sp_hi,0x20));		\
+	VSTORE((Bit8u *)(_DST)+VBYTES,_mm256_permute2x128_si256(sp_lo,sp_hi,0x31));	\
+}
+#define VSTORETRIPLE(_DST,_O0,_O1,_O2) {							\
+	VTYPE st_0=_O0,st_1=_O1,st_2=_O2;								\
+	VSTORE(_DST,_mm256_permute2x128_si256(st_0,st_1,0x20));			\
+	VSTORE((Bit8u *)(_DST)+VBYTES,_mm256_permute2x128_si256(st_2,st_0,0x30));	\
+	VSTORE((Bit8u *)(_DST)+VBYTES*2,_mm256_permute2x128_si256(st_1,st_2,0x31));	\
+}
+#include "render_simd_span.h"
+#undef SIMDNAME
+#undef SIMDTARGET
+#undef VOP
+#undef VTYPE
+#undef VBYTES
+#undef VLOAD
+#undef VSTORE
+#undef VZERO
+#undef VAND
+#undef VOR
+#undef VCASTPS
+#undef VCASTSI
+#undef VSTOREPAIR
+#undef VSTORETRIPLE
+#endif
+
+#else
+
+#if DBPP == 8
+#define PBITS 8
+#elif DBPP == 32
+#define PBITS 32
+#define VTV(_P,_SHIFT) SIMD_TV_32(_P,_SHIFT)
+#define VSETP VSET32
+#else
+#define PBITS 16
+#define VTV(_P,_SHIFT) SIMD_TV_16(_P,_SHIFT)
+#define VSETP VSET16
+#endif
+
+#define VRED(_P)	VAND(_P,VSETP(redMask))
+#define VGREEN(_P)	VAND(_P,VSETP(greenMask))
+#define VBLUE(_P)	VAND(_P,VSETP(blueMask))
+
+#define SPAN1(_LINE,_A)			VSTORE(_LINE,_A)
+#define SPAN2(_LINE,_A,_B)		SIMD_STORE2(_LINE,_A,_B,PBITS)
+#define SPAN3(_LINE,_A,_B,_C)	SIMD_STORE3(_LINE,_A,_B,_C,PBITS)
+
+static SIMDTARGET void conc3d(SCALERNAME,DBPP,SIMDNAME)(const void *s, void *l0, void *l1, void *l2, Bitu count) {
+	const PTYPE *src = (const PTYPE *)s;
+	PTYPE *line0 = (PTYPE *)l0;
+#if (SCALERHEIGHT > 1)
+	PTYPE *line1 = (PTYPE *)l1;
+#endif
+#if (SCALERHEIGHT > 2)
+	PTYPE *line2 = (PTYPE *)l2;
+#endif
+	for (;count>=VBYTES/PSIZE;count-=VBYTES/PSIZE) {
+		const VTYPE P = VLOAD(src);
+		SCALERSPANFUNC;
+		src += VBYTES/PSIZE;
+		line0 += SCALERWIDTH*VBYTES/PSIZE;
+#if (SCALERHEIGHT > 1)
+		line1 += SCALERWIDTH*VBYTES/PSIZE;
+#endif
+#if (SCALERHEIGHT > 2)
+		line2 += SCALERWIDTH*VBYTES/PSIZE;
+#endif
+	}
+	for (;count>0;count--) {
+		const PTYPE P = *src++;
+		SCALERFUNC;
+		line0 += SCALERWIDTH;
+#if (SCALERHEIGHT > 1)
+		line1 += SCALERWIDTH;
+#endif
+#if (SCALERHEIGHT > 2)
+		line2 += SCALERWIDTH;
+#endif
+	}
+}
+
+#undef PBITS
+#undef VTV
+#undef VSETP
+#undef VRED
+#undef VGREEN
+#undef VBLUE
+#undef SPAN1
+#undef SPAN2
+#undef SPAN3
+
+#endif
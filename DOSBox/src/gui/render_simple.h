@@ -55,10 +55,14 @@ static void conc4d(SCALERNAME,SBPP,DBPP,R)(const void *s) {
 #else 
 	for (Bits x=render.src.width;x>0;) {
 		if (*(Bitu const*)src == *(Bitu*)cache) {
-			x-=(sizeof(Bitu)/sizeof(SRCTYPE));
-			src+=(sizeof(Bitu)/sizeof(SRCTYPE));
-			cache+=(sizeof(Bitu)/sizeof(SRCTYPE));
-			line0+=(sizeof(Bitu)/sizeof(SRCTYPE))*SCALERWIDTH;
+			//--Modified 2026-10-17 for vectorised line comparison:
+			//skip the whole run of unchanged pixels at once
+			Bitu same = Scaler_SIMD->SameBytes(src, cache, (x*sizeof(SRCTYPE)+sizeof(Bitu)-1) & ~(sizeof(Bitu)-1)) / sizeof(SRCTYPE);
+			x-=same;
+			src+=same;
+			cache+=same;
+			line0+=same*SCALERWIDTH;
+			//--End of modifications
 #endif
 		} else {
 #if defined(SCALERLINEAR)
@@ -77,6 +81,43 @@ static void conc4d(SCALERNAME,SBPP,DBPP,R)(const void *s) {
 #endif
 #endif //defined(SCALERLINEAR)
 			hadChange = 1;
+			//--Added 2026-10-17 for dirty-tile tracking
+			const Bitu dirtyLeft = render.src.width - x;
+			//--End of modifications
+			//--Added 2026-10-17 for vectorised scalers:
+			//hand the changed pixels to the vector version of this scaler if there is one.
+			//Normal1x gains nothing from it when the pixels need converting first.
+#if defined(SCALERSPAN) && ((SBPP == DBPP) || (DBPP == 8) || (SCALERWIDTH*SCALERHEIGHT > 1))
+			ScalerSpanHandler_t span = Scaler_SIMD->Span[SCALERSPAN][PMODE];
+			if (span) {
+				Bitu count = x > 32 ? 32 : x;
+#if (SBPP == DBPP) || (DBPP == 8)
+				const void *row = src;
+#else
+				PTYPE row[32];
+				for (Bitu i=0;i<count;i++) row[i] = PMAKE(src[i]);
+#endif
+#if (SCALERHEIGHT > 2)
+				span(row, line0, line1, line2, count);
+				line2 += count*SCALERWIDTH;
+#endif
+#if (SCALERHEIGHT == 2)
+				span(row, line0, line1, 0, count);
+#endif
+#if (SCALERHEIGHT == 1)
+				span(row, line0, 0, 0, count);
+#endif
+#if (SCALERHEIGHT > 1)
+				line1 += count*SCALERWIDTH;
+#endif
+				line0 += count*SCALERWIDTH;
+				memcpy(cache, src, count*sizeof(SRCTYPE));
+				src += count;
+				cache += count;
+				x -= count;
+			} else
+#endif
+			//--End of modifications
 			for (Bitu i = x > 32 ? 32 : x;i>0;i--,x--) {
 				const SRCTYPE S = *src;
 				*cache = S;
@@ -100,6 +141,9 @@ static void conc4d(SCALERNAME,SBPP,DBPP,R)(const void *s) {
 			BituMove(((Bit8u*)line0)-copyLen+render.scale.outPitch*2,WC[1], copyLen );
 #endif
 #endif //defined(SCALERLINEAR)
+			//--Added 2026-10-17 for dirty-tile tracking
+			ScalerDirtySpan(dirtyLeft, render.src.width - x);
+			//--End of modifications
 		}
 	}
 #if defined(SCALERLINEAR) 
@@ -119,4 +163,9 @@ static void conc4d(SCALERNAME,SBPP,DBPP,R)(const void *s) {
 #define SCALERLINEAR 1
 #include "render_simple.h"
 #undef SCALERLINEAR
+//--Added 2026-10-17 for vectorised scalers: build them once for each output depth
+#if defined(SCALERSPAN) && (SBPP == DBPP)
+#include "render_simd_span.h"
+#endif
+//--End of modifications
 #endif
@@ -19,9 +19,13 @@
 #if DBPP == 8
 #define PSIZE 1
 #define PTYPE Bit8u
+//--Added 2026-10-17 for vectorised scalers
+#define PMODE scalerMode8
+//--End of modifications
 #define WC scalerWriteCache.b8
-//#define FC scalerFrameCache.b8
-#define FC (*(scalerFrameCache_t*)(&scalerSourceCache.b32[400][0])).b8
+//--Modified 2026-10-17 for dynamically sized scaler caches
+#define FC(_LINE) ((PTYPE *)scalerFrameCache + (_LINE) * scalerFrameWidth)
+//--End of modifications
 #define redMask		0
 #define	greenMask	0
 #define blueMask	0
@@ -34,9 +38,13 @@
 #elif DBPP == 15 || DBPP == 16
 #define PSIZE 2
 #define PTYPE Bit16u
+//--Added 2026-10-17 for vectorised scalers
+#define PMODE ((DBPP == 15) ? scalerMode15 : scalerMode16)
+//--End of modifications
 #define WC scalerWriteCache.b16
-//#define FC scalerFrameCache.b16
-#define FC (*(scalerFrameCache_t*)(&scalerSourceCache.b32[400][0])).b16
+//--Modified 2026-10-17 for dynamically sized scaler caches
+#define FC(_LINE) ((PTYPE *)scalerFrameCache + (_LINE) * scalerFrameWidth)
+//--End of modifications
 #if DBPP == 15
 #define	redMask		0x7C00
 #define	greenMask	0x03E0
@@ -61,9 +69,13 @@
 #elif DBPP == 32
 #define PSIZE 4
 #define PTYPE Bit32u
+//--Added 2026-10-17 for vectorised scalers
+#define PMODE scalerMode32
+//--End of modifications
 #define WC scalerWriteCache.b32
-//#define FC scalerFrameCache.b32
-#define FC (*(scalerFrameCache_t*)(&scalerSourceCache.b32[400][0])).b32
+//--Modified 2026-10-17 for dynamically sized scaler caches
+#define FC(_LINE) ((PTYPE *)scalerFrameCache + (_LINE) * scalerFrameWidth)
+//--End of modifications
 #define redMask		0xff0000
 #define greenMask	0x00ff00
 #define blueMask	0x0000ff
@@ -79,7 +91,7 @@
 
 
 #if SBPP == 8 || SBPP == 9
-#define SC scalerSourceCache.b8
+#define SC ((Bit8u *)scalerSourceCache)
 #if DBPP == 8
 #define PMAKE(_VAL) (_VAL)
 #elif DBPP == 15
@@ -93,7 +105,7 @@
 #endif
 
 #if SBPP == 15
-#define SC scalerSourceCache.b16
+#define SC ((Bit16u *)scalerSourceCache)
 #if DBPP == 15
 #define PMAKE(_VAL) (_VAL)
 #elif DBPP == 16
@@ -105,7 +117,7 @@
 #endif
 
 #if SBPP == 16
-#define SC scalerSourceCache.b16
+#define SC ((Bit16u *)scalerSourceCache)
 #if DBPP == 15
 #define PMAKE(_VAL) (((_VAL&~31)>>1)|(_VAL&31))
 #elif DBPP == 16
@@ -117,7 +129,7 @@
 #endif
 
 #if SBPP == 32
-#define SC scalerSourceCache.b32
+#define SC ((Bit32u *)scalerSourceCache)
 #if DBPP == 15
 #define PMAKE(_VAL) (PTYPE)(((_VAL&(31<<19))>>9)|((_VAL&(31<<11))>>6)|((_VAL&(31<<3))>>3))
 #elif DBPP == 16
@@ -133,23 +145,26 @@
 //  C6 C7 C8 D5
 //  D0 D1 D2 D6
 
-#define C0 fc[-1 - SCALER_COMPLEXWIDTH]
-#define C1 fc[+0 - SCALER_COMPLEXWIDTH]
-#define C2 fc[+1 - SCALER_COMPLEXWIDTH]
+//--Modified 2026-10-17 for dynamically sized scaler caches: fcWidth is a local, signed copy of
+//scalerFrameWidth in render_loops.h, so that it stays in a register and -fcWidth is negative
+#define C0 fc[-1 - fcWidth]
+#define C1 fc[+0 - fcWidth]
+#define C2 fc[+1 - fcWidth]
 #define C3 fc[-1 ]
 #define C4 fc[+0 ]
 #define C5 fc[+1 ]
-#define C6 fc[-1 + SCALER_COMPLEXWIDTH]
-#define C7 fc[+0 + SCALER_COMPLEXWIDTH]
-#define C8 fc[+1 + SCALER_COMPLEXWIDTH]
-
-#define D0 fc[-1 + 2*SCALER_COMPLEXWIDTH]
-#define D1 fc[+0 + 2*SCALER_COMPLEXWIDTH]
-#define D2 fc[+1 + 2*SCALER_COMPLEXWIDTH]
-#define D3 fc[+2 - SCALER_COMPLEXWIDTH]
+#define C6 fc[-1 + fcWidth]
+#define C7 fc[+0 + fcWidth]
+#define C8 fc[+1 + fcWidth]
+
+#define D0 fc[-1 + 2*fcWidth]
+#define D1 fc[+0 + 2*fcWidth]
+#define D2 fc[+1 + 2*fcWidth]
+#define D3 fc[+2 - fcWidth]
 #define D4 fc[+2]
-#define D5 fc[+2 + SCALER_COMPLEXWIDTH]
-#define D6 fc[+2 + 2*SCALER_COMPLEXWIDTH]
+#define D5 fc[+2 + fcWidth]
+#define D6 fc[+2 + 2*fcWidth]
+//--End of modifications
 
 
 #if RENDER_USE_ADVANCED_SCALERS>1
@@ -163,7 +178,9 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 	}
 #endif
 	const SRCTYPE * src = (SRCTYPE*)s;
-	PTYPE *fc= &FC[render.scale.inLine+1][1];
+	//--Modified 2026-10-17 for dynamically sized scaler caches
+	PTYPE *fc= &FC(render.scale.inLine+1)[1];
+	//--End of modifications
 	SRCTYPE *sc = (SRCTYPE*)(render.scale.cacheRead);
 	render.scale.cacheRead += render.scale.cachePitch;
 	Bitu b;
@@ -185,15 +202,17 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 				} while (x<SCALER_BLOCKSIZE);
 				hadChange = true;
 				/* Change the surrounding blocks */
-				CC[render.scale.inLine+0][1+b-1] |= SCALE_RIGHT;
-				CC[render.scale.inLine+0][1+b+0] |= SCALE_FULL;
-				CC[render.scale.inLine+0][1+b+1] |= SCALE_LEFT;
-				CC[render.scale.inLine+1][1+b-1] |= SCALE_RIGHT;
-				CC[render.scale.inLine+1][1+b+0] |= SCALE_FULL;
-				CC[render.scale.inLine+1][1+b+1] |= SCALE_LEFT;
-				CC[render.scale.inLine+2][1+b-1] |= SCALE_RIGHT;
-				CC[render.scale.inLine+2][1+b+0] |= SCALE_FULL;
-				CC[render.scale.inLine+2][1+b+1] |= SCALE_LEFT;
+				//--Modified 2026-10-17 for dynamically sized scaler caches
+				CC(render.scale.inLine+0)[1+b-1] |= SCALE_RIGHT;
+				CC(render.scale.inLine+0)[1+b+0] |= SCALE_FULL;
+				CC(render.scale.inLine+0)[1+b+1] |= SCALE_LEFT;
+				CC(render.scale.inLine+1)[1+b-1] |= SCALE_RIGHT;
+				CC(render.scale.inLine+1)[1+b+0] |= SCALE_FULL;
+				CC(render.scale.inLine+1)[1+b+1] |= SCALE_LEFT;
+				CC(render.scale.inLine+2)[1+b-1] |= SCALE_RIGHT;
+				CC(render.scale.inLine+2)[1+b+0] |= SCALE_FULL;
+				CC(render.scale.inLine+2)[1+b+1] |= SCALE_LEFT;
+				//--End of modifications
 				continue;
 			}
 		}
@@ -202,9 +221,11 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 		src += SCALER_BLOCKSIZE;
 	}
 	if (hadChange) {
-		CC[render.scale.inLine+0][0] = 1;
-		CC[render.scale.inLine+1][0] = 1;
-		CC[render.scale.inLine+2][0] = 1;
+		//--Modified 2026-10-17 for dynamically sized scaler caches
+		CC(render.scale.inLine+0)[0] = 1;
+		CC(render.scale.inLine+1)[0] = 1;
+		CC(render.scale.inLine+2)[0] = 1;
+		//--End of modifications
 	}
 	render.scale.inLine++;
 	render.scale.complexHandler();
@@ -218,11 +239,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 #define SCALERHEIGHT	1
 #define SCALERFUNC								\
 	line0[0] = P;
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanNormal1x
+#define SCALERSPANFUNC	SPAN1(line0,P);
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #define SCALERNAME		Normal2x
 #define SCALERWIDTH		2
@@ -232,11 +261,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 	line0[1] = P;								\
 	line1[0] = P;								\
 	line1[1] = P;
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanNormal2x
+#define SCALERSPANFUNC	SPAN2(line0,P,P); SPAN2(line1,P,P);
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #define SCALERNAME		Normal3x
 #define SCALERWIDTH		3
@@ -251,11 +288,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 	line2[0] = P;								\
 	line2[1] = P;								\
 	line2[2] = P;
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanNormal3x
+#define SCALERSPANFUNC	SPAN3(line0,P,P,P); SPAN3(line1,P,P,P); SPAN3(line2,P,P,P);
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #define SCALERNAME		NormalDw
 #define SCALERWIDTH		2
@@ -263,11 +308,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 #define SCALERFUNC								\
 	line0[0] = P;								\
 	line0[1] = P;
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanNormalDw
+#define SCALERSPANFUNC	SPAN2(line0,P,P);
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #define SCALERNAME		NormalDh
 #define SCALERWIDTH		1
@@ -275,11 +328,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 #define SCALERFUNC								\
 	line0[0] = P;								\
 	line1[0] = P;
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanNormalDh
+#define SCALERSPANFUNC	SPAN1(line0,P); SPAN1(line1,P);
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #if (DBPP > 8)
 
@@ -297,11 +358,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 	line1[0]=halfpixel;						\
 	line1[1]=halfpixel;						\
 }
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanTV2x
+#define SCALERSPANFUNC	{ const VTYPE H = VTV(P,3); SPAN2(line0,P,P); SPAN2(line1,H,H); }
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #define SCALERNAME		TV3x
 #define SCALERWIDTH		3
@@ -322,11 +391,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 	line2[1]=halfpixel;						\
 	line2[2]=halfpixel;						\
 }
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanTV3x
+#define SCALERSPANFUNC	{ const VTYPE H = VTV(P,3); const VTYPE Q = VTV(P,4); SPAN3(line0,P,P,P); SPAN3(line1,H,H,H); SPAN3(line2,Q,Q,Q); }
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #define SCALERNAME		RGB2x
 #define SCALERWIDTH		2
@@ -336,11 +413,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 	line0[1]=P & greenMask;			\
 	line1[0]=P & blueMask;				\
 	line1[1]=P;
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanRGB2x
+#define SCALERSPANFUNC	SPAN2(line0,VRED(P),VGREEN(P)); SPAN2(line1,VBLUE(P),P);
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #define SCALERNAME		RGB3x
 #define SCALERWIDTH		3
@@ -355,11 +440,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 	line2[0]=P;				\
 	line2[1]=P & blueMask;				\
 	line2[2]=P & redMask;
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanRGB3x
+#define SCALERSPANFUNC	SPAN3(line0,P,VGREEN(P),VBLUE(P)); SPAN3(line1,VGREEN(P),VRED(P),P); SPAN3(line2,P,VBLUE(P),VRED(P));
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #define SCALERNAME		Scan2x
 #define SCALERWIDTH		2
@@ -369,11 +462,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 	line0[1]=P;							\
 	line1[0]=0;							\
 	line1[1]=0;
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanScan2x
+#define SCALERSPANFUNC	SPAN2(line0,P,P); SPAN2(line1,VZERO,VZERO);
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #define SCALERNAME		Scan3x
 #define SCALERWIDTH		3
@@ -388,11 +489,19 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 	line2[0]=0;				\
 	line2[1]=0;				\
 	line2[2]=0;
+//--Added 2026-10-17 for vectorised scalers
+#define SCALERSPAN		scalerSpanScan3x
+#define SCALERSPANFUNC	SPAN3(line0,P,P,P); SPAN3(line1,VZERO,VZERO,VZERO); SPAN3(line2,VZERO,VZERO,VZERO);
+//--End of modifications
 #include "render_simple.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised scalers
+#undef SCALERSPAN
+#undef SCALERSPANFUNC
+//--End of modifications
 
 #endif		//#if RENDER_USE_ADVANCED_SCALERS>0
 
@@ -413,30 +522,44 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 #define SCALERWIDTH		2
 #define SCALERHEIGHT	2
 #include "render_templates_hq2x.h"
-#define SCALERFUNC		conc2d(Hq2x,SBPP)(line0, line1, fc)
+//--Modified 2026-10-17 for dynamically sized scaler caches and vectorised HQ patterns
+#define SCALERFUNC		conc2d(Hq2x,SBPP)(line0, line1, fc, fcWidth, *pattern)
+#define SCALERPATTERNS(_COUNT)	conc2d(HqPatterns,SBPP)(fc, fcWidth, _COUNT, patterns)
+//--End of modifications
 #include "render_loops.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised HQ patterns
+#undef SCALERPATTERNS
+//--End of modifications
 
 #define SCALERNAME		HQ3x
 #define SCALERWIDTH		3
 #define SCALERHEIGHT	3
 #include "render_templates_hq3x.h"
-#define SCALERFUNC		conc2d(Hq3x,SBPP)(line0, line1, line2, fc)
+//--Modified 2026-10-17 for dynamically sized scaler caches and vectorised HQ patterns
+#define SCALERFUNC		conc2d(Hq3x,SBPP)(line0, line1, line2, fc, fcWidth, *pattern)
+#define SCALERPATTERNS(_COUNT)	conc2d(HqPatterns,SBPP)(fc, fcWidth, _COUNT, patterns)
+//--End of modifications
 #include "render_loops.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
 #undef SCALERHEIGHT
 #undef SCALERFUNC
+//--Added 2026-10-17 for vectorised HQ patterns
+#undef SCALERPATTERNS
+//--End of modifications
 
 #include "render_templates_sai.h"
 
 #define SCALERNAME		Super2xSaI
 #define SCALERWIDTH		2
 #define SCALERHEIGHT	2
-#define SCALERFUNC		conc2d(Super2xSaI,SBPP)(line0, line1, fc)
+//--Modified 2026-10-17 for dynamically sized scaler caches
+#define SCALERFUNC		conc2d(Super2xSaI,SBPP)(line0, line1, fc, fcWidth)
+//--End of modifications
 #include "render_loops.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
@@ -446,7 +569,9 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 #define SCALERNAME		SuperEagle
 #define SCALERWIDTH		2
 #define SCALERHEIGHT	2
-#define SCALERFUNC		conc2d(SuperEagle,SBPP)(line0, line1, fc)
+//--Modified 2026-10-17 for dynamically sized scaler caches
+#define SCALERFUNC		conc2d(SuperEagle,SBPP)(line0, line1, fc, fcWidth)
+//--End of modifications
 #include "render_loops.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
@@ -456,7 +581,9 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 #define SCALERNAME		_2xSaI
 #define SCALERWIDTH		2
 #define SCALERHEIGHT	2
-#define SCALERFUNC		conc2d(_2xSaI,SBPP)(line0, line1, fc)
+//--Modified 2026-10-17 for dynamically sized scaler caches
+#define SCALERFUNC		conc2d(_2xSaI,SBPP)(line0, line1, fc, fcWidth)
+//--End of modifications
 #include "render_loops.h"
 #undef SCALERNAME
 #undef SCALERWIDTH
@@ -562,6 +689,9 @@ static void conc3d(Cache,SBPP,DBPP) (const void * s) {
 
 #undef PSIZE
 #undef PTYPE
+//--Added 2026-10-17 for vectorised scalers
+#undef PMODE
+//--End of modifications
 #undef PMAKE
 #undef WC
 #undef LC
@@ -58,6 +58,64 @@ static inline bool diffYUV(Bit32u yuv1, Bit32u yuv2)
 	return false;
 }
 
+//--Added 2026-10-17 for vectorised HQ patterns
+/* Works out the 8 neighbour pattern the HQ scalers switch on for count pixels at once.
+   Each row holds the YUV values of count+2 pixels, starting one to the left of the first,
+   and bit n of the pattern is set when neighbour n (in reading order, skipping the pixel
+   itself) differs visibly from the pixel. Pixels of the same colour have the same YUV
+   value, so this doesn't need diffYUV's callers' check for that. */
+static void HqPatterns_None(const Bit32u *yuv0, const Bit32u *yuv1, const Bit32u *yuv2, Bit8u *patterns, Bitu count) {
+	for (Bitu x=0;x<count;x++) {
+		const Bit32u yuv=yuv1[x+1];
+		patterns[x]=(diffYUV(yuv,yuv0[x])     ? 0x01 : 0) | (diffYUV(yuv,yuv0[x+1]) ? 0x02 : 0) |
+		            (diffYUV(yuv,yuv0[x+2])   ? 0x04 : 0) | (diffYUV(yuv,yuv1[x])   ? 0x08 : 0) |
+		            (diffYUV(yuv,yuv1[x+2])   ? 0x10 : 0) | (diffYUV(yuv,yuv2[x])   ? 0x20 : 0) |
+		            (diffYUV(yuv,yuv2[x+1])   ? 0x40 : 0) | (diffYUV(yuv,yuv2[x+2]) ? 0x80 : 0);
+	}
+}
+
+/* The vector versions compare every channel of several pixels at once: Y, U and V each
+   have a byte of their own. diffYUV's differences are unsigned, so its absolute values
+   only come out right for channels where the pixel's value is at least its neighbour's:
+   any channel where the neighbour's is higher counts as different. To draw the same as
+   before, a channel differs here when the neighbour's saturated difference from the
+   pixel leaves anything, or the pixel's from the neighbour is still left with something
+   after taking the threshold away. */
+#define HQ_THRESHOLDS	0x00300706
+
+#if defined(RENDER_SIMD_SSE2)
+#define HQ_NEIGHBOUR_SSE2(_ROW,_OFFSET,_BIT) {										\
+	const __m128i n=_mm_loadu_si128((const __m128i *)(_ROW+x+_OFFSET));				\
+	const __m128i over=_mm_subs_epu8(_mm_subs_epu8(yuv,n),thresholds);				\
+	const __m128i same=_mm_cmpeq_epi32(_mm_or_si128(over,_mm_subs_epu8(n,yuv)),zero);	\
+	pattern=_mm_or_si128(pattern,_mm_andnot_si128(same,_mm_set1_epi32(_BIT)));		\
+}
+
+static void HqPatterns_SSE2(const Bit32u *yuv0, const Bit32u *yuv1, const Bit32u *yuv2, Bit8u *patterns, Bitu count) {
+	const __m128i thresholds=_mm_set1_epi32(HQ_THRESHOLDS);
+	const __m128i zero=_mm_setzero_si128();
+	Bitu x=0;
+	for (;x+4<=count;x+=4) {
+		const __m128i yuv=_mm_loadu_si128((const __m128i *)(yuv1+x+1));
+		__m128i pattern=zero;
+		HQ_NEIGHBOUR_SSE2(yuv0,0,0x01);
+		HQ_NEIGHBOUR_SSE2(yuv0,1,0x02);
+		HQ_NEIGHBOUR_SSE2(yuv0,2,0x04);
+		HQ_NEIGHBOUR_SSE2(yuv1,0,0x08);
+		HQ_NEIGHBOUR_SSE2(yuv1,2,0x10);
+		HQ_NEIGHBOUR_SSE2(yuv2,0,0x20);
+		HQ_NEIGHBOUR_SSE2(yuv2,1,0x40);
+		HQ_NEIGHBOUR_SSE2(yuv2,2,0x80);
+		pattern=_mm_packus_epi16(_mm_packs_epi32(pattern,zero),zero);
+		const Bit32u bytes=_mm_cvtsi128_si32(pattern);
+		memcpy(&patterns[x],&bytes,4);
+	}
+	HqPatterns_None(yuv0+x,yuv1+x,yuv2+x,patterns+x,count-x);
+}
+#undef HQ_NEIGHBOUR_SSE2
+#endif
+//--End of modifications
+
 #endif
 
 static inline void conc2d(InitLUTs,SBPP)(void)
@@ -83,3 +141,27 @@ static inline void conc2d(InitLUTs,SBPP)(void)
 		_RGBtoYUV[color] = (Y << 16) | (u << 8) | v;
 	}
 }
+
+//--Added 2026-10-17 for vectorised HQ patterns: moved here from the HQ2x and HQ3x templates
+#undef RGBtoYUV
+#if SBPP == 32
+#define RGBtoYUV(c) _RGBtoYUV[((c & 0xf80000) >> 8) | ((c & 0x00fc00) >> 5) | ((c & 0x0000f8) >> 3)]
+#else
+#define RGBtoYUV(c) _RGBtoYUV[c]
+#endif
+
+/* Works out the patterns of count pixels from fc on, for the HQ scalers' SCALERPATTERNS.
+   Each of the three rows around them is only converted to YUV once here, rather than
+   for every pixel that has it as a neighbour. */
+static inline void conc2d(HqPatterns,SBPP)(const PTYPE * fc, const Bits fcWidth, Bitu count, Bit8u * patterns)
+{
+	if (_RGBtoYUV == 0) conc2d(InitLUTs,SBPP)();
+
+	Bit32u yuv[3][SCALER_BLOCKSIZE + 2];
+	const PTYPE * rows[3] = { fc - fcWidth - 1, fc - 1, fc + fcWidth - 1 };
+	for (Bitu row = 0; row < 3; row++) {
+		for (Bitu x = 0; x < count + 2; x++) yuv[row][x] = RGBtoYUV(rows[row][x]);
+	}
+	Scaler_SIMD->HqPatterns(yuv[0], yuv[1], yuv[2], patterns, count);
+}
+//--End of modifications
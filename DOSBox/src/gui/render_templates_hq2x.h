@@ -79,27 +79,11 @@
 
 #endif
 
-#if SBPP == 32
-#define RGBtoYUV(c) _RGBtoYUV[((c & 0xf80000) >> 8) | ((c & 0x00fc00) >> 5) | ((c & 0x0000f8) >> 3)]
-#else
-#define RGBtoYUV(c) _RGBtoYUV[c]
-#endif
-
-inline void conc2d(Hq2x,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE * fc)
+//--Modified 2026-10-17 for dynamically sized scaler caches and vectorised HQ patterns:
+//takes the frame cache width, and the pixel's pattern from SCALERPATTERNS
+inline void conc2d(Hq2x,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE * fc, const Bits fcWidth, const Bit32u pattern)
+//--End of modifications
 {
-	if (_RGBtoYUV == 0) conc2d(InitLUTs,SBPP)();
-
-	Bit32u pattern = 0;
-	const Bit32u YUV4 = RGBtoYUV(C4);
-	if (C4 != C0 && diffYUV(YUV4, RGBtoYUV(C0))) pattern |= 0x0001;
-	if (C4 != C1 && diffYUV(YUV4, RGBtoYUV(C1))) pattern |= 0x0002;
-	if (C4 != C2 && diffYUV(YUV4, RGBtoYUV(C2))) pattern |= 0x0004;
-	if (C4 != C3 && diffYUV(YUV4, RGBtoYUV(C3))) pattern |= 0x0008;
-	if (C4 != C5 && diffYUV(YUV4, RGBtoYUV(C5))) pattern |= 0x0010;
-	if (C4 != C6 && diffYUV(YUV4, RGBtoYUV(C6))) pattern |= 0x0020;
-	if (C4 != C7 && diffYUV(YUV4, RGBtoYUV(C7))) pattern |= 0x0040;
-	if (C4 != C8 && diffYUV(YUV4, RGBtoYUV(C8))) pattern |= 0x0080;
-
 	switch (pattern) {
 	case 0:
 	case 1:
@@ -1892,5 +1876,3 @@ inline void conc2d(Hq2x,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE * fc)
 		break;
 	}
 }
-
-#undef RGBtoYUV
@@ -35,7 +35,9 @@ static inline int conc2d(GetResult,SBPP)(PTYPE A, PTYPE B, PTYPE C, PTYPE D) {
 	return rmap[y][x];
 }
 
-inline void conc2d(Super2xSaI,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE * fc)
+//--Modified 2026-10-17 for dynamically sized scaler caches: takes the frame cache width
+inline void conc2d(Super2xSaI,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE * fc, const Bits fcWidth)
+//--End of modifications
 {
 	//--------------------------------------
 	if (C7 == C5 && C4 != C8) {
@@ -87,7 +89,9 @@ inline void conc2d(Super2xSaI,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE *
 		line0[0] = C4;
 }
 
-inline void conc2d(SuperEagle,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE * fc)
+//--Modified 2026-10-17 for dynamically sized scaler caches: takes the frame cache width
+inline void conc2d(SuperEagle,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE * fc, const Bits fcWidth)
+//--End of modifications
 {
 	// --------------------------------------
 	if (C4 != C8) {
@@ -147,7 +151,9 @@ inline void conc2d(SuperEagle,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE *
 	}
 }
 
-inline void conc2d(_2xSaI,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE * fc)
+//--Modified 2026-10-17 for dynamically sized scaler caches: takes the frame cache width
+inline void conc2d(_2xSaI,SBPP)(PTYPE * line0, PTYPE * line1, const PTYPE * fc, const Bits fcWidth)
+//--End of modifications
 {
 	if ((C4 == C8) && (C5 != C7)) {
 		if (((C4 == C1) && (C5 == D5)) ||
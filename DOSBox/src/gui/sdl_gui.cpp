@@ -61,7 +61,9 @@ static void getPixel(Bits x, Bits y, int &r, int &g, int &b, int shift)
 	if (x < 0) x = 0;
 	if (y < 0) y = 0;
 
-	Bit8u* src = (Bit8u *)&scalerSourceCache;
+	//--Modified 2026-10-17 for dynamically sized scaler caches
+	Bit8u* src = scalerSourceCache;
+	//--End of modifications
 	Bit32u pixel;
 	switch (render.scale.inMode) {
 	case scalerMode8:
@@ -28,6 +28,10 @@
 #include "mapper.h"
 #include "mem.h"
 #include "dbopl.h"
+//--Added 2026-10-17 for threaded OPL synthesis
+#include "SDL.h"
+#include "dbopl_thread.h"
+//--End of modifications
 
 namespace OPL2 {
 	#include "opl.cpp"
@@ -449,6 +453,9 @@ void Module::PortWrite( Bitu port, Bitu val, Bitu iolen ) {
 	if ( !mixerChan->enabled ) {
 		mixerChan->Enable(true);
 	}
+	//--Added 2026-10-17 for sleeping silent channels
+	mixerChan->WakeUp();
+	//--End of modifications
 	if ( port&1 ) {
 		switch ( mode ) {
 		case MODE_OPL2:
@@ -545,16 +552,34 @@ void Module::Init( Mode m ) {
 
 static Adlib::Module* module = 0;
 
-static void OPL_CallBack(Bitu len) {
-	module->handler->Generate( module->mixerChan, len );
+//--Added 2026-10-17 for sleeping silent channels: whether any note is keyed on,
+//including the rhythm section's, which are keyed on through 0xbd
+static bool OPL_KeyedOn(void) {
+	for (Bitu i=0xb0;i<0xb9;i++) if (module->cache[i]&0x20||module->cache[i+0x100]&0x20) return true;
+	for (Bitu i=0xbd;i<0x200;i+=0x100) if ((module->cache[i]&0x20) && (module->cache[i]&0x1f)) return true;
+	return false;
+}
+
+//Moved out of OPL_CallBack, so that the mixer can also check it while the channel sleeps
+static void OPL_CheckIdle(void) {
 	//Disable the sound generation after 30 seconds of silence
 	if ((PIC_Ticks - module->lastUsed) > 30000) {
-		Bitu i;
-		for (i=0xb0;i<0xb9;i++) if (module->cache[i]&0x20||module->cache[i+0x100]&0x20) break;
-		if (i==0xb9) module->mixerChan->Enable(false);
+		if (!OPL_KeyedOn()) module->mixerChan->Enable(false);
 		else module->lastUsed = PIC_Ticks;
 	}
 }
+//--End of modifications
+
+static void OPL_CallBack(Bitu len) {
+	module->handler->Generate( module->mixerChan, len );
+	//--Added 2026-10-17 for sleeping silent channels: a keyed on note can still be silent
+	//while it slowly attacks, so only sleep once every note has been released
+	if (OPL_KeyedOn()) module->mixerChan->WakeUp();
+	//--End of modifications
+	//--Modified 2026-10-17 for sleeping silent channels: moved to OPL_CheckIdle
+	OPL_CheckIdle();
+	//--End of modifications
+}
 
 static Bitu OPL_Read(Bitu port,Bitu iolen) {
 	return module->PortRead( port, iolen );
@@ -641,17 +666,25 @@ Module::Module( Section* configuration ) : Module_base(configuration) {
 
 	mixerChan = mixerObject.Install(OPL_CallBack,rate,"FM");
 	mixerChan->SetScale( 2.0f );
+	//--Added 2026-10-17 for sleeping silent channels
+	mixerChan->SetSleepDelay( 1000, OPL_CheckIdle );
+	//--End of modifications
+	//--Modified 2026-10-17 for threaded OPL synthesis: DBOPL can run on a thread of its own
+	bool oplthread = section->Get_bool( "oplthread" );
 	if (oplemu == "fast") {
-		handler = new DBOPL::Handler();
+		handler = oplthread ? (Adlib::Handler*)new DBOPL::ThreadedHandler() : new DBOPL::Handler();
 	} else if (oplemu == "compat") {
+		if ( oplthread )
+			LOG_MSG( "OPL:oplthread only applies to the default/fast emulation, synthesising compat on the emulation thread" );
 		if ( oplmode == OPL_opl2 ) {
 			handler = new OPL2::Handler();
 		} else {
 			handler = new OPL3::Handler();
 		}
 	} else {
-		handler = new DBOPL::Handler();
+		handler = oplthread ? (Adlib::Handler*)new DBOPL::ThreadedHandler() : new DBOPL::Handler();
 	}
+	//--End of modifications
 	handler->Init( rate );
 	bool single = false;
 	switch ( oplmode ) {
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (C) 2002-2010  The DOSBox Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+//Runs DBOPL on a synthesis thread of its own, for adlib.cpp's oplthread setting. Register
+//writes go into a log, stamped with the sample of the output they land on, which the thread
+//plays back as it renders; the mixer then takes the rendered samples from a ring. The samples a
+//tick's writes land on are stamped OPL_THREAD_LATENCY ms after the ones the mixer has taken so
+//far, so the thread can render the next tick while that tick is being emulated, and the FM
+//channel plays that much later than the rest. The thread also ends its blocks where the mixer's
+//end, that much later, since DBOPL skips channels that are silent for a whole block: so writes
+//made at the start of a tick sound exactly as they do without the thread, only later. The timers
+//aren't part of this: Adlib::Chip still does them on the emulation thread.
+//This needs SDL.h and dbopl.h.
+
+namespace DBOPL {
+	#define OPL_THREAD_LATENCY 2
+	#define OPL_LOG_SIZE 4096
+	#define OPL_RING_SIZE 8192
+	#define OPL_BLOCK 512
+	#define OPL_LOG_BLOCKEND 0xffffffff	//Logged in place of a register to end a block there
+
+	struct ThreadedHandler : public Adlib::Handler {
+		DBOPL::Handler synth;			//Only touched by the thread once it's running
+		SDL_Thread *thread;
+		SDL_sem *wake;					//Posted when the thread has more to do
+		SDL_sem *ready;					//Posted when the thread has done something while waited for
+		bool quit, waiting;
+
+		struct {
+			Bitu stamp;
+			Bit32u reg;
+			Bit8u val;
+		} log[OPL_LOG_SIZE];
+		Bitu logHead, logTail;
+
+		Bit32s ring[OPL_RING_SIZE][2];	//Always stereo, opl2 output is doubled up
+		Bitu rendered, consumed;		//Samples the thread has put in the ring, and the mixer taken
+		Bitu horizon;					//No write will land before this sample, so it's safe to render up to
+
+		//Emulation thread state
+		Bitu latency, lastStamp;
+		double tickSamples;
+		bool opl3Active;
+
+		ThreadedHandler() : thread(0), wake(0), ready(0), quit(false), waiting(false),
+			logHead(0), logTail(0), rendered(0), consumed(0), horizon(0),
+			latency(0), lastStamp(0), tickSamples(0), opl3Active(false) {
+		}
+
+		static int Main( void* data ) {
+			static_cast<ThreadedHandler*>( data )->Run();
+			return 0;
+		}
+
+		//Lets the thread render up to sample
+		void Advance( Bitu sample ) {
+			if ( (Bits)( sample - horizon ) <= 0 )
+				return;
+			__atomic_store_n( &horizon, sample, __ATOMIC_RELEASE );
+			SDL_SemPost( wake );
+		}
+
+		//Blocks until the thread next gets something done
+		void WaitForThread( void ) {
+			SDL_SemWait( ready );
+		}
+
+		void Run( void ) {
+			Bit32s block[OPL_BLOCK][2], mono[OPL_BLOCK];
+			Bitu pos = 0, tail = 0;
+			while ( !__atomic_load_n( &quit, __ATOMIC_ACQUIRE ) ) {
+				//Play back the writes that are due before the next sample
+				Bitu head = __atomic_load_n( &logHead, __ATOMIC_ACQUIRE );
+				for ( ; tail != head && (Bits)( log[tail % OPL_LOG_SIZE].stamp - pos ) <= 0; tail++ ) {
+					if ( log[tail % OPL_LOG_SIZE].reg != OPL_LOG_BLOCKEND )
+						synth.chip.WriteReg( log[tail % OPL_LOG_SIZE].reg, log[tail % OPL_LOG_SIZE].val );
+				}
+				__atomic_store_n( &logTail, tail, __ATOMIC_RELEASE );
+
+				//Then render up to the next one, as far as is safe and the ring has room for
+				Bits todo = (Bits)( __atomic_load_n( &horizon, __ATOMIC_ACQUIRE ) - pos );
+				Bits room = OPL_RING_SIZE - (Bits)( pos - __atomic_load_n( &consumed, __ATOMIC_ACQUIRE ) );
+				if ( room < todo )
+					todo = room;
+				if ( tail != head && (Bits)( log[tail % OPL_LOG_SIZE].stamp - pos ) < todo )
+					todo = (Bits)( log[tail % OPL_LOG_SIZE].stamp - pos );
+				if ( todo > OPL_BLOCK )
+					todo = OPL_BLOCK;
+
+				if ( todo > 0 ) {
+					if ( synth.chip.opl3Active ) {
+						synth.chip.GenerateBlock3( todo, block[0] );
+					} else {
+						synth.chip.GenerateBlock2( todo, mono );
+						for ( Bits i = 0; i < todo; i++ )
+							block[i][0] = block[i][1] = mono[i];
+					}
+					for ( Bits i = 0; i < todo; i++ ) {
+						ring[(pos + i) % OPL_RING_SIZE][0] = block[i][0];
+						ring[(pos + i) % OPL_RING_SIZE][1] = block[i][1];
+					}
+					pos += todo;
+					__atomic_store_n( &rendered, pos, __ATOMIC_SEQ_CST );
+				}
+				if ( __atomic_exchange_n( &waiting, false, __ATOMIC_SEQ_CST ) )
+					SDL_SemPost( ready );
+				if ( todo <= 0 )
+					SDL_SemWait( wake );
+			}
+		}
+
+		virtual Bit32u WriteAddr( Bit32u port, Bit8u val ) {
+			if ( !thread )
+				return synth.WriteAddr( port, val );
+			//As Chip::WriteAddr, with whether opl3 is active as far as the writes logged so far go
+			switch ( port & 3 ) {
+			case 0:
+				return val;
+			case 2:
+				if ( opl3Active || (val == 0x05) )
+					return 0x100 | val;
+				else
+					return val;
+			}
+			return 0;
+		}
+
+		virtual void WriteReg( Bit32u addr, Bit8u val ) {
+			if ( !thread ) {
+				synth.WriteReg( addr, val );
+				return;
+			}
+			if ( addr == 0x105 )
+				opl3Active = ( val & 1 ) != 0;
+
+			//Land on the sample as far into the tick as the write is
+			Log( consumed + latency + (Bitu)( PIC_TickIndex() * tickSamples ), addr, val );
+		}
+
+		//Logs a write for the thread to play back on sample stamp, or no earlier than the last one
+		void Log( Bitu stamp, Bit32u reg, Bit8u val ) {
+			if ( (Bits)( stamp - lastStamp ) < 0 )
+				stamp = lastStamp;
+			lastStamp = stamp;
+
+			if ( logHead - __atomic_load_n( &logTail, __ATOMIC_ACQUIRE ) >= OPL_LOG_SIZE ) {
+				//Let the thread render ahead far enough to play back everything logged so far
+				Advance( stamp );
+				while ( logHead - __atomic_load_n( &logTail, __ATOMIC_ACQUIRE ) >= OPL_LOG_SIZE ) {
+					__atomic_store_n( &waiting, true, __ATOMIC_SEQ_CST );
+					if ( logHead - __atomic_load_n( &logTail, __ATOMIC_SEQ_CST ) >= OPL_LOG_SIZE )
+						WaitForThread();
+				}
+			}
+			log[logHead % OPL_LOG_SIZE].stamp = stamp;
+			log[logHead % OPL_LOG_SIZE].reg = reg;
+			log[logHead % OPL_LOG_SIZE].val = val;
+			__atomic_store_n( &logHead, logHead + 1, __ATOMIC_RELEASE );
+		}
+
+		virtual void Generate( MixerChannel* chan, Bitu samples ) {
+			if ( !thread ) {
+				synth.Generate( chan, samples );
+				return;
+			}
+			Bit32s buffer[OPL_BLOCK][2];
+			if ( GCC_UNLIKELY(samples > OPL_BLOCK) )
+				samples = OPL_BLOCK;
+			Take( samples, buffer );
+			chan->AddSamples_s32( samples, buffer[0] );
+		}
+
+		//Takes the next samples from the ring once the thread has rendered them
+		void Take( Bitu samples, Bit32s (*buffer)[2] ) {
+			//Usually these were rendered during the tick, but the mixer can ask for more than expected
+			Advance( consumed + samples );
+			while ( (Bits)( consumed + samples - __atomic_load_n( &rendered, __ATOMIC_ACQUIRE ) ) > 0 ) {
+				__atomic_store_n( &waiting, true, __ATOMIC_SEQ_CST );
+				if ( (Bits)( consumed + samples - __atomic_load_n( &rendered, __ATOMIC_SEQ_CST ) ) > 0 )
+					WaitForThread();
+			}
+			for ( Bitu i = 0; i < samples; i++ ) {
+				buffer[i][0] = ring[(consumed + i) % OPL_RING_SIZE][0];
+				buffer[i][1] = ring[(consumed + i) % OPL_RING_SIZE][1];
+			}
+			__atomic_store_n( &consumed, consumed + samples, __ATOMIC_RELEASE );
+			Log( consumed + latency, OPL_LOG_BLOCKEND, 0 );
+			Advance( consumed + latency );
+		}
+
+		virtual void Init( Bitu rate ) {
+			synth.Init( rate );
+			tickSamples = rate / 1000.0;
+			latency = ( rate * OPL_THREAD_LATENCY ) / 1000;
+			wake = SDL_CreateSemaphore( 0 );
+			ready = SDL_CreateSemaphore( 0 );
+			thread = SDL_CreateThread( &Main, this );
+			if ( !thread ) {
+				LOG_MSG( "OPL:Could not start the synthesis thread, synthesising on the emulation thread instead" );
+				SDL_DestroySemaphore( wake );
+				SDL_DestroySemaphore( ready );
+				wake = ready = 0;
+			}
+		}
+
+		~ThreadedHandler() {
+			if ( !thread )
+				return;
+			__atomic_store_n( &quit, true, __ATOMIC_RELEASE );
+			SDL_SemPost( wake );
+			SDL_WaitThread( thread, 0 );
+			SDL_DestroySemaphore( wake );
+			SDL_DestroySemaphore( ready );
+		}
+	};
+}
@@ -378,6 +378,9 @@ static void saa1099_write_port_w( int chip, int offset, int data )
 
 static void write_cms(Bitu port, Bitu val, Bitu /* iolen */) {
 	if(cms_chan && (!cms_chan->enabled)) cms_chan->Enable(true);
+	//--Added 2026-10-17 for sleeping silent channels
+	if(cms_chan) cms_chan->WakeUp();
+	//--End of modifications
 	last_command = PIC_Ticks;
 	switch (port-base_port) {
 	case 0:
@@ -395,6 +398,13 @@ static void write_cms(Bitu port, Bitu val, Bitu /* iolen */) {
 	}
 }
 
+//--Added 2026-10-17 for sleeping silent channels: moved out of CMS_CallBack,
+//so that the mixer can also check it while the channel sleeps
+static void CMS_CheckIdle(void) {
+	if (last_command + 10000 < PIC_Ticks) if(cms_chan) cms_chan->Enable(false);
+}
+//--End of modifications
+
 static void CMS_CallBack(Bitu len) {
 	if (len > CMS_BUFFER_SIZE) return;
 
@@ -419,7 +429,9 @@ static void CMS_CallBack(Bitu len) {
 		stream++;
 	}
 	if(cms_chan) cms_chan->AddSamples_s16(len,(Bit16s *)MixTemp);
-	if (last_command + 10000 < PIC_Ticks) if(cms_chan) cms_chan->Enable(false);
+	//--Modified 2026-10-17 for sleeping silent channels: moved to CMS_CheckIdle
+	CMS_CheckIdle();
+	//--End of modifications
 }
 
 // The Gameblaster detection
@@ -474,6 +486,9 @@ public:
 
 		/* Register the Mixer CallBack */
 		cms_chan = MixerChan.Install(CMS_CallBack,sample_rate_temp,"CMS");
+		//--Added 2026-10-17 for sleeping silent channels
+		cms_chan->SetSleepDelay(1000,CMS_CheckIdle);
+		//--End of modifications
 	
 		last_command = PIC_Ticks;
 	
@@ -80,6 +80,9 @@ struct GFGus {
 		bool masked;
 		bool running;
 		float delay;
+		//--Added 2026-10-17 to cancel the timer's event by handle
+		PIC_EventHandle event;
+		//--End of modifications
 	} timers[2];
 	Bit32u rate;
 	Bitu portbase;
@@ -335,6 +338,10 @@ static void GUSReset(void) {
 		myGUS.timers[1].reached = false;
 		myGUS.timers[0].running = false;
 		myGUS.timers[1].running = false;
+		//--Added 2026-10-17 to stop the timers straight away, rather than after one last tick
+		PIC_RemoveEvent(myGUS.timers[0].event);
+		PIC_RemoveEvent(myGUS.timers[1].event);
+		//--End of modifications
 
 		myGUS.timers[0].value = 0xff;
 		myGUS.timers[1].value = 0xff;
@@ -447,8 +454,10 @@ static void GUS_TimerEvent(Bitu val) {
 		myGUS.IRQStatus|=0x4 << val;
 		GUS_CheckIRQ();
 	}
+	//--Modified 2026-10-17 to keep the event's handle
 	if (myGUS.timers[val].running) 
-		PIC_AddEvent(GUS_TimerEvent,myGUS.timers[val].delay,val);
+		myGUS.timers[val].event=PIC_AddEvent(GUS_TimerEvent,myGUS.timers[val].delay,val);
+	//--End of modifications
 }
 
  
@@ -635,6 +644,9 @@ static Bitu read_gus(Bitu port,Bitu iolen) {
 
 static void write_gus(Bitu port,Bitu val,Bitu iolen) {
 //	LOG_MSG("Write gus port %x val %x",port,val);
+	//--Added 2026-10-17 for sleeping silent channels
+	gus_chan->WakeUp();
+	//--End of modifications
 	switch(port - GUS_BASE) {
 	case 0x200:
 		myGUS.mixControl = (Bit8u)val;
@@ -652,18 +664,27 @@ static void write_gus(Bitu port,Bitu val,Bitu iolen) {
 		}
 		myGUS.timers[0].masked=(val & 0x40)>0;
 		myGUS.timers[1].masked=(val & 0x20)>0;
+		//--Modified 2026-10-17 to cancel a stopped timer's event by handle. It used to tick
+		//once more, and if the timer was started again before then, run twice as fast.
 		if (val & 0x1) {
 			if (!myGUS.timers[0].running) {
-				PIC_AddEvent(GUS_TimerEvent,myGUS.timers[0].delay,0);
+				myGUS.timers[0].event=PIC_AddEvent(GUS_TimerEvent,myGUS.timers[0].delay,0);
 				myGUS.timers[0].running=true;
 			}
-		} else myGUS.timers[0].running=false;
+		} else {
+			myGUS.timers[0].running=false;
+			PIC_RemoveEvent(myGUS.timers[0].event);
+		}
 		if (val & 0x2) {
 			if (!myGUS.timers[1].running) {
-				PIC_AddEvent(GUS_TimerEvent,myGUS.timers[1].delay,1);
+				myGUS.timers[1].event=PIC_AddEvent(GUS_TimerEvent,myGUS.timers[1].delay,1);
 				myGUS.timers[1].running=true;
 			}
-		} else myGUS.timers[1].running=false;
+		} else {
+			myGUS.timers[1].running=false;
+			PIC_RemoveEvent(myGUS.timers[1].event);
+		}
+		//--End of modifications
 		break;
 //TODO Check if 0x20a register is also available on the gus like on the interwave
 	case 0x20b:
@@ -762,6 +783,15 @@ static void GUS_CallBack(Bitu len) {
 	}
 	gus_chan->AddSamples_s16(len,buf16);
 	CheckVoiceIrq();
+	//--Added 2026-10-17 for sleeping silent channels: voices that are still running raise
+	//IRQs when they reach their ends, which the game may be counting on even if they're silent
+	for(i=0;i<myGUS.ActiveChannels;i++) {
+		if (!(guschan[i]->RampCtrl & guschan[i]->WaveCtrl & 3)) {
+			gus_chan->WakeUp();
+			break;
+		}
+	}
+	//--End of modifications
 }
 
 // Generate logarithmic to linear volume conversion tables
@@ -811,6 +841,9 @@ public:
 	
 		memset(&myGUS,0,sizeof(myGUS));
 		memset(GUSRam,0,1024*1024);
+		//--Added 2026-10-17 as no events have been scheduled yet
+		myGUS.timers[0].event=myGUS.timers[1].event=PIC_NOEVENT;
+		//--End of modifications
 	
 		myGUS.rate=section->Get_int("gusrate");
 	
@@ -864,6 +897,9 @@ public:
 		}
 		// Register the Mixer CallBack 
 		gus_chan=MixerChan.Install(GUS_CallBack,GUS_RATE,"GUS");
+		//--Added 2026-10-17 for sleeping silent channels
+		gus_chan->SetSleepDelay(1000);
+		//--End of modifications
 		myGUS.gRegData=0x1;
 		GUSReset();
 		myGUS.gRegData=0x0;
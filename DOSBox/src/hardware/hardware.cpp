@@ -21,6 +21,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+//--Added 2026-10-17 for dynamically sized scaler caches
+#include <vector>
+//--End of modifications
 #include "dosbox.h"
 #include "hardware.h"
 #include "setup.h"
@@ -35,6 +38,10 @@
 #import <libpng/png.h>
 
 #include "../libs/zmbv/zmbv.cpp"
+
+//--Added 2026-10-17 for asynchronous capture encoding
+#include "SDL.h"
+//--End of modifications
 #endif
 
 std::string capturedir;
@@ -170,7 +177,10 @@ static void CAPTURE_AddAviChunk(const char * tag, Bit32u size, void * data, Bit3
 
 #if (C_SSHOT)
 
-static void CAPTURE_VideoHeader() {
+//--Modified 2026-10-17 for asynchronous capture encoding: takes the audio rate to describe,
+//as the emulation thread keeps capture.video.audiorate up to date while frames are encoded
+static void CAPTURE_VideoHeader(Bitu audiorate) {
+//--End of modifications
 		Bit8u avi_header[AVI_HEADER_SIZE];
 		Bitu main_list;
 		Bitu header_pos=0;
@@ -254,10 +264,12 @@ static void CAPTURE_VideoHeader() {
 		AVIOUTd(0);             /* Reserved, MS says: wPriority, wLanguage */
 		AVIOUTd(0);             /* InitialFrames */
 		AVIOUTd(4);    /* Scale */
-		AVIOUTd(capture.video.audiorate*4);             /* Rate, actual rate is scale/rate */
+		//--Modified 2026-10-17 for asynchronous capture encoding
+		AVIOUTd(audiorate*4);             /* Rate, actual rate is scale/rate */
 		AVIOUTd(0);             /* Start */
-		if (!capture.video.audiorate)
-			capture.video.audiorate = 1;
+		if (!audiorate)
+			audiorate = 1;
+		//--End of modifications
 		AVIOUTd(capture.video.audiowritten/4);   /* Length */
 		AVIOUTd(0);             /* SuggestedBufferSize */
 		AVIOUTd(~0);            /* Quality */
@@ -269,8 +281,10 @@ static void CAPTURE_VideoHeader() {
 		AVIOUTd(16);            /* # of bytes to follow */
 		AVIOUTw(1);             /* Format, WAVE_ZMBV_FORMAT_PCM */
 		AVIOUTw(2);             /* Number of channels */
-		AVIOUTd(capture.video.audiorate);          /* SamplesPerSec */
-		AVIOUTd(capture.video.audiorate*4);        /* AvgBytesPerSec*/
+		//--Modified 2026-10-17 for asynchronous capture encoding
+		AVIOUTd(audiorate);          /* SamplesPerSec */
+		AVIOUTd(audiorate*4);        /* AvgBytesPerSec*/
+		//--End of modifications
 		AVIOUTw(4);             /* BlockAlign */
 		AVIOUTw(16);            /* BitsPerSample */
 		int nmain = header_pos - main_list - 4;
@@ -295,6 +309,63 @@ static void CAPTURE_VideoHeader() {
 		fseek(capture.video.handle, save_pos, SEEK_SET);
 }
 
+//--Added 2026-10-17 for asynchronous capture encoding
+/* Encoding screenshots and video frames is slow enough to hold up the emulation, so
+   CAPTURE_AddImage only copies each frame, its palette and the audio recorded since the
+   last frame into the next job of a small ring, and the encoder thread does the rest.
+   The ring is handed over the same way as the render thread's: only the emulation thread
+   advances head and only the encoder thread advances tail. When the ring is full the
+   emulation thread waits for a free job rather than skipping the frame, so that the AVI
+   comes out exactly as it would have been written straight away.
+   Files are still opened on the emulation thread, as OpenCaptureFile asks Boxer for them. */
+#define CAPTURE_QUEUE_SIZE 4
+
+typedef struct {
+	std::vector<Bit8u> data;		//pitch bytes for each source line, kept between frames
+	Bit8u pal[256*4];
+	Bitu width, height, bpp, pitch, flags;
+	float fps;
+	FILE *image;					//The file to write a screenshot of this frame to, if any
+	bool closeVideo;				//Finish the video being recorded before anything else
+	Bitu closeRate;					//The audio rate to describe in its header if so
+	FILE *newVideo;					//The file to start a new video in, if any
+	bool video;						//Whether to add this frame to the video
+	std::vector<Bit16s> audio;		//The audio to record after this frame, 2 samples each
+	Bitu audioUsed, audioRate;
+} CaptureJob_t;
+
+static struct {
+	SDL_Thread *thread;
+	SDL_sem *wake;
+	bool quit;
+	CaptureJob_t jobs[CAPTURE_QUEUE_SIZE];
+	Bitu head, tail;
+	bool failed;					//Set by the encoder thread when the video can't go on
+	//The video being recorded, as far as the emulation thread has queued it
+	bool recording;
+	Bitu width, height, bpp;
+	float fps;
+	Bitu stalls, dropped;
+} encoder;
+
+//Blocks until the encoder thread has finished every job handed to it so far.
+static void CAPTURE_WaitForEncoder(void) {
+	while (__atomic_load_n(&encoder.tail, __ATOMIC_ACQUIRE) != encoder.head)
+		SDL_Delay(1);
+}
+
+static void CAPTURE_CloseVideo(Bitu audiorate) {
+	/* Adds AVI header to the file */
+	CAPTURE_VideoHeader(audiorate);
+
+	fclose( capture.video.handle );
+	free( capture.video.index );
+	free( capture.video.buf );
+	delete capture.video.codec;
+	capture.video.handle = 0;
+}
+//--End of modifications
+
 static void CAPTURE_VideoEvent(bool pressed) {
 	if (!pressed)
 		return;
@@ -303,279 +374,431 @@ static void CAPTURE_VideoEvent(bool pressed) {
 		CaptureState &= ~CAPTURE_VIDEO;
 		LOG_MSG("Stopped capturing video.");	
 
-		/* Adds AVI header to the file */
-		CAPTURE_VideoHeader();
-
-		fclose( capture.video.handle );
-		free( capture.video.index );
-		free( capture.video.buf );
-		delete capture.video.codec;
-		capture.video.handle = 0;
+		//--Modified 2026-10-17 for asynchronous capture encoding: let the encoder finish
+		//the frames it has been given first
+		CAPTURE_WaitForEncoder();
+		if (capture.video.handle) CAPTURE_CloseVideo(capture.video.audiorate);
+		//Writing the header counts a missing audio rate as 1 from then on
+		if (!capture.video.audiorate) capture.video.audiorate = 1;
+		encoder.recording = false;
+		//--End of modifications
 	} else {
 		CaptureState |= CAPTURE_VIDEO;
 	}
 }
-#endif
 
-void CAPTURE_AddImage(Bitu width, Bitu height, Bitu bpp, Bitu pitch, Bitu flags, float fps, Bit8u * data, Bit8u * pal) {
-#if (C_SSHOT)
+//--Added 2026-10-17 for asynchronous capture encoding: the encoding half of the old
+//CAPTURE_AddImage, run on the encoder thread
+static void CAPTURE_WriteImage(const CaptureJob_t *job, Bit8u *doubleRow) {
 	Bitu i;
-	Bit8u doubleRow[SCALER_MAXWIDTH*4];
-	Bitu countWidth = width;
+	Bitu countWidth = job->width;
+	Bitu width = job->width, height = job->height, bpp = job->bpp, pitch = job->pitch, flags = job->flags;
+	const Bit8u *data = &job->data[0];
+	const Bit8u *pal = job->pal;
+	FILE *fp = job->image;
 
 	if (flags & CAPTURE_FLAG_DBLH)
 		height *= 2;
 	if (flags & CAPTURE_FLAG_DBLW)
 		width *= 2;
 
-	if (height > SCALER_MAXHEIGHT)
+	png_structp png_ptr;
+	png_infop info_ptr;
+	png_color palette[256];
+
+	/* First try to alloacte the png structures */
+	png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL,NULL, NULL);
+	if (!png_ptr) {
+		fclose(fp);
 		return;
-	if (width > SCALER_MAXWIDTH)
+	}
+	info_ptr = png_create_info_struct(png_ptr);
+	if (!info_ptr) {
+		png_destroy_write_struct(&png_ptr,(png_infopp)NULL);
+		fclose(fp);
 		return;
-	
-	if (CaptureState & CAPTURE_IMAGE) {
-		png_structp png_ptr;
-		png_infop info_ptr;
-		png_color palette[256];
+	}
 
-		CaptureState &= ~CAPTURE_IMAGE;
-		/* Open the actual file */
-		FILE * fp=OpenCaptureFile("Screenshot",".png");
-		if (!fp) goto skip_shot;
-		/* First try to alloacte the png structures */
-		png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL,NULL, NULL);
-		if (!png_ptr) goto skip_shot;
-		info_ptr = png_create_info_struct(png_ptr);
-		if (!info_ptr) {
-			png_destroy_write_struct(&png_ptr,(png_infopp)NULL);
-			goto skip_shot;
-		}
+	/* Finalize the initing of png library */
+	png_init_io(png_ptr, fp);
+	png_set_compression_level(png_ptr,Z_BEST_COMPRESSION);
 	
-		/* Finalize the initing of png library */
-		png_init_io(png_ptr, fp);
-		png_set_compression_level(png_ptr,Z_BEST_COMPRESSION);
-		
-		/* set other zlib parameters */
-		png_set_compression_mem_level(png_ptr, 8);
-		png_set_compression_strategy(png_ptr,Z_DEFAULT_STRATEGY);
-		png_set_compression_window_bits(png_ptr, 15);
-		png_set_compression_method(png_ptr, 8);
-		png_set_compression_buffer_size(png_ptr, 8192);
-	
-		if (bpp==8) {
-			png_set_IHDR(png_ptr, info_ptr, width, height,
-				8, PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE,
-				PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
-			for (i=0;i<256;i++) {
-				palette[i].red=pal[i*4+0];
-				palette[i].green=pal[i*4+1];
-				palette[i].blue=pal[i*4+2];
+	/* set other zlib parameters */
+	png_set_compression_mem_level(png_ptr, 8);
+	png_set_compression_strategy(png_ptr,Z_DEFAULT_STRATEGY);
+	png_set_compression_window_bits(png_ptr, 15);
+	png_set_compression_method(png_ptr, 8);
+	png_set_compression_buffer_size(png_ptr, 8192);
+
+	if (bpp==8) {
+		png_set_IHDR(png_ptr, info_ptr, width, height,
+			8, PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE,
+			PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+		for (i=0;i<256;i++) {
+			palette[i].red=pal[i*4+0];
+			palette[i].green=pal[i*4+1];
+			palette[i].blue=pal[i*4+2];
+		}
+		png_set_PLTE(png_ptr, info_ptr, palette,256);
+	} else {
+		png_set_bgr( png_ptr );
+		png_set_IHDR(png_ptr, info_ptr, width, height,
+			8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
+			PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+	}
+	png_write_info(png_ptr, info_ptr);
+	for (i=0;i<height;i++) {
+		const void *rowPointer;
+		const void *srcLine;
+		if (flags & CAPTURE_FLAG_DBLH)
+			srcLine=(data+(i >> 1)*pitch);
+		else
+			srcLine=(data+(i >> 0)*pitch);
+		rowPointer=srcLine;
+		switch (bpp) {
+		case 8:
+			if (flags & CAPTURE_FLAG_DBLW) {
+				for (Bitu x=0;x<countWidth;x++)
+					doubleRow[x*2+0] =
+					doubleRow[x*2+1] = ((const Bit8u *)srcLine)[x];
+				rowPointer = doubleRow;
 			}
-			png_set_PLTE(png_ptr, info_ptr, palette,256);
-		} else {
-			png_set_bgr( png_ptr );
-			png_set_IHDR(png_ptr, info_ptr, width, height,
-				8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
-				PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+			break;
+		case 15:
+			if (flags & CAPTURE_FLAG_DBLW) {
+				for (Bitu x=0;x<countWidth;x++) {
+					Bitu pixel = ((const Bit16u *)srcLine)[x];
+					doubleRow[x*6+0] = doubleRow[x*6+3] = ((pixel& 0x001f) * 0x21) >>  2;
+					doubleRow[x*6+1] = doubleRow[x*6+4] = ((pixel& 0x03e0) * 0x21) >>  7;
+					doubleRow[x*6+2] = doubleRow[x*6+5] = ((pixel& 0x7c00) * 0x21) >>  12;
+				}
+			} else {
+				for (Bitu x=0;x<countWidth;x++) {
+					Bitu pixel = ((const Bit16u *)srcLine)[x];
+					doubleRow[x*3+0] = ((pixel& 0x001f) * 0x21) >>  2;
+					doubleRow[x*3+1] = ((pixel& 0x03e0) * 0x21) >>  7;
+					doubleRow[x*3+2] = ((pixel& 0x7c00) * 0x21) >>  12;
+				}
+			}
+			rowPointer = doubleRow;
+			break;
+		case 16:
+			if (flags & CAPTURE_FLAG_DBLW) {
+				for (Bitu x=0;x<countWidth;x++) {
+					Bitu pixel = ((const Bit16u *)srcLine)[x];
+					doubleRow[x*6+0] = doubleRow[x*6+3] = ((pixel& 0x001f) * 0x21) >> 2;
+					doubleRow[x*6+1] = doubleRow[x*6+4] = ((pixel& 0x07e0) * 0x41) >> 9;
+					doubleRow[x*6+2] = doubleRow[x*6+5] = ((pixel& 0xf800) * 0x21) >> 13;
+				}
+			} else {
+				for (Bitu x=0;x<countWidth;x++) {
+					Bitu pixel = ((const Bit16u *)srcLine)[x];
+					doubleRow[x*3+0] = ((pixel& 0x001f) * 0x21) >>  2;
+					doubleRow[x*3+1] = ((pixel& 0x07e0) * 0x41) >>  9;
+					doubleRow[x*3+2] = ((pixel& 0xf800) * 0x21) >>  13;
+				}
+			}
+			rowPointer = doubleRow;
+			break;
+		case 32:
+			if (flags & CAPTURE_FLAG_DBLW) {
+				for (Bitu x=0;x<countWidth;x++) {
+					doubleRow[x*6+0] = doubleRow[x*6+3] = ((const Bit8u *)srcLine)[x*4+0];
+					doubleRow[x*6+1] = doubleRow[x*6+4] = ((const Bit8u *)srcLine)[x*4+1];
+					doubleRow[x*6+2] = doubleRow[x*6+5] = ((const Bit8u *)srcLine)[x*4+2];
+				}
+			} else {
+				for (Bitu x=0;x<countWidth;x++) {
+					doubleRow[x*3+0] = ((const Bit8u *)srcLine)[x*4+0];
+					doubleRow[x*3+1] = ((const Bit8u *)srcLine)[x*4+1];
+					doubleRow[x*3+2] = ((const Bit8u *)srcLine)[x*4+2];
+				}
+			}
+			rowPointer = doubleRow;
+			break;
 		}
-		png_write_info(png_ptr, info_ptr);
-		for (i=0;i<height;i++) {
-			void *rowPointer;
-			void *srcLine;
+		png_write_row(png_ptr, (png_bytep)rowPointer);
+	}
+	/* Finish writing */
+	png_write_end(png_ptr, 0);
+	/*Destroy PNG structs*/
+	png_destroy_write_struct(&png_ptr, &info_ptr);
+	/*close file*/
+	fclose(fp);
+}
+
+//Returns false if the video can't go on.
+static bool CAPTURE_EncodeVideo(const CaptureJob_t *job, Bit8u *doubleRow) {
+	Bitu i;
+	Bitu width = job->width, height = job->height, bpp = job->bpp, pitch = job->pitch, flags = job->flags;
+	const Bit8u *data = &job->data[0];
+	zmbv_format_t format;
+
+	if (flags & CAPTURE_FLAG_DBLH)
+		height *= 2;
+	if (flags & CAPTURE_FLAG_DBLW)
+		width *= 2;
+
+	switch (bpp) {
+	case 8:format = ZMBV_FORMAT_8BPP;break;
+	case 15:format = ZMBV_FORMAT_15BPP;break;
+	case 16:format = ZMBV_FORMAT_16BPP;break;
+	case 32:format = ZMBV_FORMAT_32BPP;break;
+	default:
+		return false;
+	}
+	if (job->newVideo) {
+		capture.video.handle = job->newVideo;
+		capture.video.codec = new VideoCodec();
+		if (!capture.video.codec)
+			return false;
+		if (!capture.video.codec->SetupCompress( width, height)) 
+			return false;
+		capture.video.bufSize = capture.video.codec->NeededSize(width, height, format);
+		capture.video.buf = malloc( capture.video.bufSize );
+		if (!capture.video.buf)
+			return false;
+		capture.video.index = (Bit8u*)malloc( 16*4096 );
+		if (!capture.video.buf)
+			return false;
+		capture.video.indexsize = 16*4096;
+		capture.video.indexused = 8;
+
+		capture.video.width = width;
+		capture.video.height = height;
+		capture.video.bpp = bpp;
+		capture.video.fps = job->fps;
+		for (i=0;i<AVI_HEADER_SIZE;i++)
+			fputc(0,capture.video.handle);
+		capture.video.frames = 0;
+		capture.video.written = 0;
+		capture.video.audiowritten = 0;
+	}
+	int codecFlags;
+	if (capture.video.frames % 300 == 0)
+		codecFlags = 1;
+	else codecFlags = 0;
+	if (!capture.video.codec->PrepareCompressFrame( codecFlags, format, (char *)job->pal, capture.video.buf, capture.video.bufSize))
+		return false;
+
+	for (i=0;i<height;i++) {
+		void * rowPointer;
+		if (flags & CAPTURE_FLAG_DBLW) {
+			const void *srcLine;
+			Bitu x;
+			Bitu countWidth = width >> 1;
 			if (flags & CAPTURE_FLAG_DBLH)
 				srcLine=(data+(i >> 1)*pitch);
 			else
 				srcLine=(data+(i >> 0)*pitch);
-			rowPointer=srcLine;
-			switch (bpp) {
+			switch ( bpp) {
 			case 8:
-				if (flags & CAPTURE_FLAG_DBLW) {
-   					for (Bitu x=0;x<countWidth;x++)
-						doubleRow[x*2+0] =
-						doubleRow[x*2+1] = ((Bit8u *)srcLine)[x];
-					rowPointer = doubleRow;
-				}
+				for (x=0;x<countWidth;x++)
+					((Bit8u *)doubleRow)[x*2+0] =
+					((Bit8u *)doubleRow)[x*2+1] = ((const Bit8u *)srcLine)[x];
 				break;
 			case 15:
-				if (flags & CAPTURE_FLAG_DBLW) {
-					for (Bitu x=0;x<countWidth;x++) {
-						Bitu pixel = ((Bit16u *)srcLine)[x];
-						doubleRow[x*6+0] = doubleRow[x*6+3] = ((pixel& 0x001f) * 0x21) >>  2;
-						doubleRow[x*6+1] = doubleRow[x*6+4] = ((pixel& 0x03e0) * 0x21) >>  7;
-						doubleRow[x*6+2] = doubleRow[x*6+5] = ((pixel& 0x7c00) * 0x21) >>  12;
-					}
-				} else {
-					for (Bitu x=0;x<countWidth;x++) {
-						Bitu pixel = ((Bit16u *)srcLine)[x];
-						doubleRow[x*3+0] = ((pixel& 0x001f) * 0x21) >>  2;
-						doubleRow[x*3+1] = ((pixel& 0x03e0) * 0x21) >>  7;
-						doubleRow[x*3+2] = ((pixel& 0x7c00) * 0x21) >>  12;
-					}
-				}
-				rowPointer = doubleRow;
-				break;
 			case 16:
-				if (flags & CAPTURE_FLAG_DBLW) {
-					for (Bitu x=0;x<countWidth;x++) {
-						Bitu pixel = ((Bit16u *)srcLine)[x];
-						doubleRow[x*6+0] = doubleRow[x*6+3] = ((pixel& 0x001f) * 0x21) >> 2;
-						doubleRow[x*6+1] = doubleRow[x*6+4] = ((pixel& 0x07e0) * 0x41) >> 9;
-						doubleRow[x*6+2] = doubleRow[x*6+5] = ((pixel& 0xf800) * 0x21) >> 13;
-					}
-				} else {
-					for (Bitu x=0;x<countWidth;x++) {
-						Bitu pixel = ((Bit16u *)srcLine)[x];
-						doubleRow[x*3+0] = ((pixel& 0x001f) * 0x21) >>  2;
-						doubleRow[x*3+1] = ((pixel& 0x07e0) * 0x41) >>  9;
-						doubleRow[x*3+2] = ((pixel& 0xf800) * 0x21) >>  13;
-					}
-				}
-				rowPointer = doubleRow;
+				for (x=0;x<countWidth;x++)
+					((Bit16u *)doubleRow)[x*2+0] =
+					((Bit16u *)doubleRow)[x*2+1] = ((const Bit16u *)srcLine)[x];
 				break;
 			case 32:
-				if (flags & CAPTURE_FLAG_DBLW) {
-					for (Bitu x=0;x<countWidth;x++) {
-						doubleRow[x*6+0] = doubleRow[x*6+3] = ((Bit8u *)srcLine)[x*4+0];
-						doubleRow[x*6+1] = doubleRow[x*6+4] = ((Bit8u *)srcLine)[x*4+1];
-						doubleRow[x*6+2] = doubleRow[x*6+5] = ((Bit8u *)srcLine)[x*4+2];
-					}
-				} else {
-					for (Bitu x=0;x<countWidth;x++) {
-						doubleRow[x*3+0] = ((Bit8u *)srcLine)[x*4+0];
-						doubleRow[x*3+1] = ((Bit8u *)srcLine)[x*4+1];
-						doubleRow[x*3+2] = ((Bit8u *)srcLine)[x*4+2];
-					}
-				}
-				rowPointer = doubleRow;
+				for (x=0;x<countWidth;x++)
+					((Bit32u *)doubleRow)[x*2+0] =
+					((Bit32u *)doubleRow)[x*2+1] = ((const Bit32u *)srcLine)[x];
 				break;
 			}
-			png_write_row(png_ptr, (png_bytep)rowPointer);
+			rowPointer=doubleRow;
+		} else {
+			if (flags & CAPTURE_FLAG_DBLH)
+				rowPointer=(void *)(data+(i >> 1)*pitch);
+			else
+				rowPointer=(void *)(data+(i >> 0)*pitch);
 		}
-		/* Finish writing */
-		png_write_end(png_ptr, 0);
-		/*Destroy PNG structs*/
-		png_destroy_write_struct(&png_ptr, &info_ptr);
-		/*close file*/
-		fclose(fp);
+		capture.video.codec->CompressLines( 1, &rowPointer );
+	}
+	int written = capture.video.codec->FinishCompressFrame();
+	if (written < 0)
+		return false;
+	CAPTURE_AddAviChunk( "00dc", written, capture.video.buf, codecFlags & 1 ? 0x10 : 0x0);
+	capture.video.frames++;
+//	LOG_MSG("Frame %d video %d audio %d",capture.video.frames, written, job->audioUsed *4 );
+	if ( job->audioUsed ) {
+		CAPTURE_AddAviChunk( "01wb", job->audioUsed * 4, (void *)&job->audio[0], 0);
+		capture.video.audiowritten = job->audioUsed*4;
+	}
+
+	/* Adds AVI header to the file */
+	CAPTURE_VideoHeader(job->audioRate);
+	return true;
+}
+
+static int CAPTURE_EncoderMain(void *) {
+	std::vector<Bit8u> doubleRow;
+	for (;;) {
+		SDL_SemWait(encoder.wake);
+		if (__atomic_load_n(&encoder.quit, __ATOMIC_ACQUIRE))
+			return 0;
+		Bitu tail = encoder.tail;
+		while (tail != __atomic_load_n(&encoder.head, __ATOMIC_ACQUIRE)) {
+			const CaptureJob_t *job = &encoder.jobs[tail % CAPTURE_QUEUE_SIZE];
+			//Sized for the doubled frame, as the old stack buffer was
+			Bitu rowBytes = job->width * 4 * ((job->flags & CAPTURE_FLAG_DBLW) ? 2 : 1);
+			if (doubleRow.size() < rowBytes) doubleRow.resize(rowBytes);
+
+			if (job->image)
+				CAPTURE_WriteImage(job, &doubleRow[0]);
+			if (job->closeVideo && capture.video.handle)
+				CAPTURE_CloseVideo(job->closeRate);
+			if (job->video) {
+				if (__atomic_load_n(&encoder.failed, __ATOMIC_ACQUIRE))
+					__atomic_add_fetch(&encoder.dropped, 1, __ATOMIC_RELAXED);
+				else if (!CAPTURE_EncodeVideo(job, &doubleRow[0]))
+					__atomic_store_n(&encoder.failed, true, __ATOMIC_RELEASE);
+			}
+			tail++;
+			__atomic_store_n(&encoder.tail, tail, __ATOMIC_RELEASE);
+		}
+	}
+}
+
+static void CAPTURE_StartEncoder(void) {
+	encoder.head = encoder.tail = 0;
+	encoder.wake = SDL_CreateSemaphore(0);
+	encoder.thread = SDL_CreateThread(&CAPTURE_EncoderMain, 0);
+	if (!encoder.thread) {
+		LOG_MSG("CAPTURE:Could not start the encoder thread, encoding on the emulation thread instead");
+		SDL_DestroySemaphore(encoder.wake);
+		encoder.wake = 0;
+	}
+}
+
+static void CAPTURE_StopEncoder(void) {
+	if (!encoder.thread)
+		return;
+	CAPTURE_WaitForEncoder();
+	__atomic_store_n(&encoder.quit, true, __ATOMIC_RELEASE);
+	SDL_SemPost(encoder.wake);
+	SDL_WaitThread(encoder.thread, 0);
+	SDL_DestroySemaphore(encoder.wake);
+	encoder.thread = 0;
+	encoder.wake = 0;
+	encoder.quit = false;
+}
+//--End of modifications
+#endif
+
+//--Modified 2026-10-17 for asynchronous capture encoding: the frame is copied into the next
+//encoder job here, and encoded on the encoder thread by CAPTURE_WriteImage/CAPTURE_EncodeVideo
+void CAPTURE_AddImage(Bitu width, Bitu height, Bitu bpp, Bitu pitch, Bitu flags, float fps, Bit8u * data, Bit8u * pal) {
+#if (C_SSHOT)
+	if (!(CaptureState & (CAPTURE_IMAGE|CAPTURE_VIDEO)))
+		return;
+	//A video the encoder couldn't go on with stops here, as it did straight away before
+	if (GCC_UNLIKELY(__atomic_load_n(&encoder.failed, __ATOMIC_ACQUIRE))) {
+		CAPTURE_WaitForEncoder();
+		__atomic_store_n(&encoder.failed, false, __ATOMIC_RELAXED);
+		CaptureState &= ~CAPTURE_VIDEO;
+	}
+	if (encoder.head - __atomic_load_n(&encoder.tail, __ATOMIC_ACQUIRE) >= CAPTURE_QUEUE_SIZE) {
+		encoder.stalls++;
+		while (encoder.head - __atomic_load_n(&encoder.tail, __ATOMIC_ACQUIRE) >= CAPTURE_QUEUE_SIZE)
+			SDL_Delay(1);
+	}
+	CaptureJob_t *job = &encoder.jobs[encoder.head % CAPTURE_QUEUE_SIZE];
+	job->image = 0;
+	job->closeVideo = false;
+	job->newVideo = 0;
+	job->video = false;
+
+	if (CaptureState & CAPTURE_IMAGE) {
+		CaptureState &= ~CAPTURE_IMAGE;
+		/* Open the actual file */
+		job->image = OpenCaptureFile("Screenshot",".png");
 	}
-skip_shot:
 	if (CaptureState & CAPTURE_VIDEO) {
-		zmbv_format_t format;
-		/* Disable capturing if any of the test fails */
-		if (capture.video.handle && (
-			capture.video.width != width ||
-			capture.video.height != height ||
-			capture.video.bpp != bpp ||
-			capture.video.fps != fps)) 
+		/* Start a new video if the frame doesn't fit the one being recorded */
+		if (encoder.recording && (
+			encoder.width != width ||
+			encoder.height != height ||
+			encoder.bpp != bpp ||
+			encoder.fps != fps)) 
 		{
-			CAPTURE_VideoEvent(true);
+			LOG_MSG("Stopped capturing video.");
+			job->closeVideo = true;
+			job->closeRate = capture.video.audiorate;
+			if (!capture.video.audiorate) capture.video.audiorate = 1;
+			encoder.recording = false;
 		}
 		CaptureState &= ~CAPTURE_VIDEO;
-		switch (bpp) {
-		case 8:format = ZMBV_FORMAT_8BPP;break;
-		case 15:format = ZMBV_FORMAT_15BPP;break;
-		case 16:format = ZMBV_FORMAT_16BPP;break;
-		case 32:format = ZMBV_FORMAT_32BPP;break;
-		default:
-			goto skip_video;
-		}
-		if (!capture.video.handle) {
-			capture.video.handle = OpenCaptureFile("Video",".avi");
-			if (!capture.video.handle)
-				goto skip_video;
-			capture.video.codec = new VideoCodec();
-			if (!capture.video.codec)
-				goto skip_video;
-			if (!capture.video.codec->SetupCompress( width, height)) 
-				goto skip_video;
-			capture.video.bufSize = capture.video.codec->NeededSize(width, height, format);
-			capture.video.buf = malloc( capture.video.bufSize );
-			if (!capture.video.buf)
-				goto skip_video;
-			capture.video.index = (Bit8u*)malloc( 16*4096 );
-			if (!capture.video.buf)
-				goto skip_video;
-			capture.video.indexsize = 16*4096;
-			capture.video.indexused = 8;
-
-			capture.video.width = width;
-			capture.video.height = height;
-			capture.video.bpp = bpp;
-			capture.video.fps = fps;
-			for (i=0;i<AVI_HEADER_SIZE;i++)
-				fputc(0,capture.video.handle);
-			capture.video.frames = 0;
-			capture.video.written = 0;
-			capture.video.audioused = 0;
-			capture.video.audiowritten = 0;
-		}
-		int codecFlags;
-		if (capture.video.frames % 300 == 0)
-			codecFlags = 1;
-		else codecFlags = 0;
-		if (!capture.video.codec->PrepareCompressFrame( codecFlags, format, (char *)pal, capture.video.buf, capture.video.bufSize))
-			goto skip_video;
-
-		for (i=0;i<height;i++) {
-			void * rowPointer;
-			if (flags & CAPTURE_FLAG_DBLW) {
-				void *srcLine;
-				Bitu x;
-				Bitu countWidth = width >> 1;
-				if (flags & CAPTURE_FLAG_DBLH)
-					srcLine=(data+(i >> 1)*pitch);
-				else
-					srcLine=(data+(i >> 0)*pitch);
-				switch ( bpp) {
-				case 8:
-					for (x=0;x<countWidth;x++)
-						((Bit8u *)doubleRow)[x*2+0] =
-						((Bit8u *)doubleRow)[x*2+1] = ((Bit8u *)srcLine)[x];
-					break;
-				case 15:
-				case 16:
-					for (x=0;x<countWidth;x++)
-						((Bit16u *)doubleRow)[x*2+0] =
-						((Bit16u *)doubleRow)[x*2+1] = ((Bit16u *)srcLine)[x];
-					break;
-				case 32:
-					for (x=0;x<countWidth;x++)
-						((Bit32u *)doubleRow)[x*2+0] =
-						((Bit32u *)doubleRow)[x*2+1] = ((Bit32u *)srcLine)[x];
-					break;
+		if (bpp == 8 || bpp == 15 || bpp == 16 || bpp == 32) {
+			if (!encoder.recording) {
+				job->newVideo = OpenCaptureFile("Video",".avi");
+				if (job->newVideo) {
+					encoder.recording = true;
+					encoder.width = width;
+					encoder.height = height;
+					encoder.bpp = bpp;
+					encoder.fps = fps;
+					capture.video.audioused = 0;
 				}
-                rowPointer=doubleRow;
-			} else {
-				if (flags & CAPTURE_FLAG_DBLH)
-					rowPointer=(data+(i >> 1)*pitch);
-				else
-					rowPointer=(data+(i >> 0)*pitch);
 			}
-			capture.video.codec->CompressLines( 1, &rowPointer );
-		}
-		int written = capture.video.codec->FinishCompressFrame();
-		if (written < 0)
-			goto skip_video;
-		CAPTURE_AddAviChunk( "00dc", written, capture.video.buf, codecFlags & 1 ? 0x10 : 0x0);
-		capture.video.frames++;
-//		LOG_MSG("Frame %d video %d audio %d",capture.video.frames, written, capture.video.audioused *4 );
-		if ( capture.video.audioused ) {
-			CAPTURE_AddAviChunk( "01wb", capture.video.audioused * 4, capture.video.audiobuf, 0);
-			capture.video.audiowritten = capture.video.audioused*4;
-			capture.video.audioused = 0;
+			if (encoder.recording) {
+				job->video = true;
+				job->audio.assign(&capture.video.audiobuf[0][0], &capture.video.audiobuf[0][0] + capture.video.audioused*2);
+				job->audioUsed = capture.video.audioused;
+				job->audioRate = capture.video.audiorate;
+				capture.video.audioused = 0;
+				//Writing the header counts a missing audio rate as 1 from then on
+				if (!capture.video.audiorate) capture.video.audiorate = 1;
+				/* Set flag again for next frame */
+				CaptureState |= CAPTURE_VIDEO;
+			}
 		}
+	}
+	if (!job->image && !job->closeVideo && !job->video)
+		return;
 
-		/* Adds AVI header to the file */
-		CAPTURE_VideoHeader();
-
-		/* Everything went okay, set flag again for next frame */
-		CaptureState |= CAPTURE_VIDEO;
+	job->width = width;
+	job->height = height;
+	job->bpp = bpp;
+	job->pitch = pitch;
+	job->flags = flags;
+	job->fps = fps;
+	job->data.assign(data, data + height * pitch);
+	if (pal) memcpy(job->pal, pal, sizeof(job->pal));
+
+	if (encoder.thread) {
+		__atomic_store_n(&encoder.head, encoder.head + 1, __ATOMIC_RELEASE);
+		SDL_SemPost(encoder.wake);
+	} else {
+		//Without the encoder thread the job is done here and now, and never queued
+		std::vector<Bit8u> doubleRow(width * 4 * ((flags & CAPTURE_FLAG_DBLW) ? 2 : 1));
+		if (job->image)
+			CAPTURE_WriteImage(job, &doubleRow[0]);
+		if (job->closeVideo && capture.video.handle)
+			CAPTURE_CloseVideo(job->closeRate);
+		if (job->video && !CAPTURE_EncodeVideo(job, &doubleRow[0]))
+			CaptureState &= ~CAPTURE_VIDEO;
 	}
-skip_video:
 #endif
 	return;
 }
 
+//Returns how many frames are waiting to be encoded, how many times the emulation has had
+//to wait for the encoder to catch up, and how many video frames it couldn't record.
+void CAPTURE_GetEncoderStats(Bitu *queued, Bitu *stalls, Bitu *dropped) {
+#if (C_SSHOT)
+	*queued = encoder.head - __atomic_load_n(&encoder.tail, __ATOMIC_ACQUIRE);
+	*stalls = encoder.stalls;
+	*dropped = __atomic_load_n(&encoder.dropped, __ATOMIC_RELAXED);
+#else
+	*queued = *stalls = *dropped = 0;
+#endif
+}
+//--End of modifications
+
 
 #if (C_SSHOT)
 static void CAPTURE_ScreenShotEvent(bool pressed) {
@@ -761,11 +984,19 @@ public:
 #if (C_SSHOT)
 		MAPPER_AddHandler(CAPTURE_ScreenShotEvent,MK_f5,MMOD1,"scrshot","Screenshot");
 		MAPPER_AddHandler(CAPTURE_VideoEvent,MK_f5,MMOD1|MMOD2,"video","Video");
+		//--Added 2026-10-17 for asynchronous capture encoding
+		CAPTURE_StartEncoder();
+		//--End of modifications
 #endif
 	}
 	~HARDWARE(){
 		if (capture.wave.handle) CAPTURE_WaveEvent(true);
 		if (capture.midi.handle) CAPTURE_MidiEvent(true);
+		//--Added 2026-10-17 for asynchronous capture encoding: finishes any frames still queued
+#if (C_SSHOT)
+		CAPTURE_StopEncoder();
+#endif
+		//--End of modifications
 	}
 };
 
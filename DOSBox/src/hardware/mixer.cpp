@@ -54,17 +54,13 @@
 //--End of modifications
 
 #define MIXER_SSIZE 4
-#define MIXER_SHIFT 14
-#define MIXER_REMAIN ((1<<MIXER_SHIFT)-1)
-#define MIXER_VOLSHIFT 13
-
-static INLINE Bit16s MIXER_CLIP(Bits SAMP) {
-	if (SAMP < MAX_AUDIO) {
-		if (SAMP > MIN_AUDIO)
-			return SAMP;
-		else return MIN_AUDIO;
-	} else return MAX_AUDIO;
-}
+//--Modified 2026-10-17 for vectorised mixing: MIXER_SHIFT, MIXER_REMAIN, MIXER_VOLSHIFT
+//and MIXER_CLIP are defined in mixer_simd.h, along with the loops that use them
+#include "mixer_simd.h"
+//--End of modifications
+//--Added 2026-10-17 for polyphase resampling
+#include "mixer_polyphase.h"
+//--End of modifications
 
 static struct {
 	Bit32s work[MIXER_BUFSIZE][2];
@@ -78,8 +74,38 @@ static struct {
 	Bit32u blocksize;
 } mixer;
 
+//--Added 2026-10-17 for a lock-free mixer output
+/* The samples finished each tick are clipped into this ring for MIXER_CallBack, so that
+   mixer.work and the channels belong to the emulation thread alone and neither side
+   ever has to take SDL_LockAudio. The emulation thread only advances write and the
+   audio callback only advances read; both count samples and wrap at MIXER_BUFSIZE.
+   mixer.tick_add and mixer.needed are shared too, but only as hints for the callback's
+   buffer-fill logic, so those go through relaxed atomics. */
+static struct {
+	Bit16s buf[MIXER_BUFSIZE][2];
+	Bitu read, write;
+	Bitu underruns;		//Callbacks that found fewer samples than they needed
+	Bitu overruns;		//Times samples were thrown away because too many had piled up
+} mixerOutput;
+//--End of modifications
+
 Bit8u MixTemp[MIXER_BUFSIZE];
 
+//--Added 2026-10-17 for polyphase resampling
+/* The names of the channels to resample through a polyphase filter, or all for every one */
+static std::string mixer_polyphase;
+
+static bool MIXER_WantsPolyphase(const char * name) {
+	std::string list=mixer_polyphase;
+	char * words=(char *)list.c_str();
+	char * word;
+	while ((word=StripWord(words)) && *word) {
+		if (!strcasecmp(word,"all") || !strcasecmp(word,name)) return true;
+	}
+	return false;
+}
+//--End of modifications
+
 MixerChannel * MIXER_AddChannel(MIXER_Handler handler,Bitu freq,const char * name) {
 	MixerChannel * chan=new MixerChannel();
 	chan->scale = 1.0f;
@@ -89,6 +115,16 @@ MixerChannel * MIXER_AddChannel(MIXER_Handler handler,Bitu freq,const char * nam
 	chan->next=mixer.channels;
 	chan->SetVolume(1,1);
 	chan->enabled=false;
+	//--Added 2026-10-17 for sleeping silent channels
+	chan->sleep_after=0;
+	chan->silent=0;
+	chan->sleeping=false;
+	chan->idle=0;
+	//--End of modifications
+	//--Added 2026-10-17 for polyphase resampling
+	chan->fir=0;
+	if (MIXER_WantsPolyphase(name)) chan->SetPolyphase(true);
+	//--End of modifications
 	mixer.channels=chan;
 	return chan;
 }
@@ -141,130 +177,117 @@ void MixerChannel::Enable(bool _yesno) {
 	enabled=_yesno;
 	if (enabled) {
 		freq_index=MIXER_REMAIN;
-		SDL_LockAudio();
+		//--Modified 2026-10-17 for a lock-free mixer output: mixer.done is no longer
+		//touched by the audio callback
 		if (done<mixer.done) done=mixer.done;
-		SDL_UnlockAudio();
+		//--End of modifications
+		//--Added 2026-10-17 for sleeping silent channels
+		WakeUp();
+		//--End of modifications
 	}
 }
 
+//--Added 2026-10-17 for sleeping silent channels
+void MixerChannel::SetSleepDelay(Bitu ms,MIXER_IdleHandler _idle) {
+	sleep_after=(ms*mixer.freq)/1000;
+	idle=_idle;
+	WakeUp();
+}
+//--End of modifications
+
 void MixerChannel::SetFreq(Bitu _freq) {
 	freq_add=(_freq<<MIXER_SHIFT)/mixer.freq;
+	//--Added 2026-10-17 for polyphase resampling
+	if (fir) MIXER_MakeFIR(*fir,freq_add);
+	//--End of modifications
+}
+
+//--Added 2026-10-17 for polyphase resampling
+void MixerChannel::SetPolyphase(bool _yesno) {
+	if (_yesno && !fir) {
+		fir=new MixerFIR;
+		fir->cutoff_add=0;
+		MIXER_MakeFIR(*fir,freq_add);
+		MIXER_ClearFIR(*fir);
+	} else if (!_yesno && fir) {
+		delete fir;
+		fir=0;
+	}
 }
 
+MixerChannel::~MixerChannel() {
+	delete fir;
+}
+//--End of modifications
+
 void MixerChannel::Mix(Bitu _needed) {
 	needed=_needed;
+	//--Added 2026-10-17 for sleeping silent channels
+	if (sleeping && enabled) {
+		AddSilence();
+		if (idle) idle();
+		return;
+	}
+	//--End of modifications
 	while (enabled && needed>done) {
 		Bitu todo=needed-done;
 		todo *= freq_add;
 		todo  = (todo >> MIXER_SHIFT) + ((todo & MIXER_REMAIN)!=0);
 		handler(todo);
 	}
+	//--Added 2026-10-17 for sleeping silent channels
+	if (sleep_after && silent>=sleep_after) sleeping=true;
+	//--End of modifications
 }
 
 void MixerChannel::AddSilence(void) {
 	if (done<needed) {
+		//--Added 2026-10-17 for sleeping silent channels
+		if (sleep_after) silent+=needed-done;
+		//--End of modifications
+		//--Added 2026-10-17 for polyphase resampling
+		if (fir) MIXER_ClearFIR(*fir);
+		//--End of modifications
 		done=needed;
 		last[0]=last[1]=0;
 		freq_index=MIXER_REMAIN;
 	}
 }
 
+//--Added 2026-10-17 for sleeping silent channels
+/* Whether a block of source data is all at the silent level */
+template<class Type,bool stereo,bool signeddata,bool nativeorder>
+static bool MIXER_IsSilent(Bitu len, const Type* data) {
+	Type silence=0;
+	if (!signeddata) {
+		if (sizeof(Type)==1) silence=(Type)0x80;
+		else if (nativeorder) silence=(Type)0x8000;
+		else host_writew((HostPt)&silence,0x8000);
+	}
+	if (stereo) len*=2;
+	for (Bitu i=0;i<len;i++) {
+		if (data[i]!=silence) return false;
+	}
+	return true;
+}
+//--End of modifications
+
 template<class Type,bool stereo,bool signeddata,bool nativeorder>
 inline void MixerChannel::AddSamples(Bitu len, const Type* data) {
-	Bits diff[2];
-	Bitu mixpos=mixer.pos+done;
-	freq_index&=MIXER_REMAIN;
-	Bitu pos=0;Bitu new_pos;
-
-	goto thestart;
-	for (;;) {
-		new_pos=freq_index >> MIXER_SHIFT;
-		if (pos<new_pos) {
-			last[0]+=diff[0];
-			if (stereo) last[1]+=diff[1];
-			pos=new_pos;
-thestart:
-			if (pos>=len) return;
-			if ( sizeof( Type) == 1) {
-				if (!signeddata) {
-					if (stereo) {
-						diff[0]=(((Bit8s)(data[pos*2+0] ^ 0x80)) << 8)-last[0];
-						diff[1]=(((Bit8s)(data[pos*2+1] ^ 0x80)) << 8)-last[1];
-					} else {
-						diff[0]=(((Bit8s)(data[pos] ^ 0x80)) << 8)-last[0];
-					}
-				} else {
-					if (stereo) {
-						diff[0]=(data[pos*2+0] << 8)-last[0];
-						diff[1]=(data[pos*2+1] << 8)-last[1];
-					} else {
-						diff[0]=(data[pos] << 8)-last[0];
-					}
-				}
-			//16bit and 32bit both contain 16bit data internally
-			} else  {
-				if (signeddata) {
-					if (stereo) {
-						if (nativeorder) {
-							diff[0]=data[pos*2+0]-last[0];
-							diff[1]=data[pos*2+1]-last[1];
-						} else {
-							if ( sizeof( Type) == 2) {
-								diff[0]=(Bit16s)host_readw((HostPt)&data[pos*2+0])-last[0];
-								diff[1]=(Bit16s)host_readw((HostPt)&data[pos*2+1])-last[1];
-							} else {
-								diff[0]=(Bit32s)host_readd((HostPt)&data[pos*2+0])-last[0];
-								diff[1]=(Bit32s)host_readd((HostPt)&data[pos*2+1])-last[1];
-							}
-						}
-					} else {
-						if (nativeorder) {
-							diff[0]=data[pos]-last[0];
-						} else {
-							if ( sizeof( Type) == 2) {
-								diff[0]=(Bit16s)host_readw((HostPt)&data[pos])-last[0];
-							} else {
-								diff[0]=(Bit32s)host_readd((HostPt)&data[pos])-last[0];
-							}
-						}
-					}
-				} else {
-					if (stereo) {
-						if (nativeorder) {
-							diff[0]=(Bits)data[pos*2+0]-32768-last[0];
-							diff[1]=(Bits)data[pos*2+1]-32768-last[1];
-						} else {
-							if ( sizeof( Type) == 2) {
-								diff[0]=(Bits)host_readw((HostPt)&data[pos*2+0])-32768-last[0];
-								diff[1]=(Bits)host_readw((HostPt)&data[pos*2+1])-32768-last[1];
-							} else {
-								diff[0]=(Bits)host_readd((HostPt)&data[pos*2+0])-32768-last[0];
-								diff[1]=(Bits)host_readd((HostPt)&data[pos*2+1])-32768-last[1];
-							}
-						}
-					} else {
-						if (nativeorder) {
-							diff[0]=(Bits)data[pos]-32768-last[0];
-						} else {
-							if ( sizeof( Type) == 2) {
-								diff[0]=(Bits)host_readw((HostPt)&data[pos])-32768-last[0];
-							} else {
-								diff[0]=(Bits)host_readd((HostPt)&data[pos])-32768-last[0];
-							}
-						}
-					}
-				}
-			}
-		}
-		Bits diff_mul=freq_index & MIXER_REMAIN;
-		freq_index+=freq_add;
-		mixpos&=MIXER_BUFMASK;
-		Bits sample=last[0]+((diff[0]*diff_mul) >> MIXER_SHIFT);
-		mixer.work[mixpos][0]+=sample*volmul[0];
-		if (stereo) sample=last[1]+((diff[1]*diff_mul) >> MIXER_SHIFT);
-		mixer.work[mixpos][1]+=sample*volmul[1];
-		mixpos++;done++;
+	//--Modified 2026-10-17 for vectorised mixing: the loop this had is MIXER_AddSamples_C
+	Bitu added;
+	if (fir) added=MIXER_AddSamplesFIR<Type,stereo,signeddata,nativeorder>(mixer.work, mixer.pos+done, len, data,
+		*fir, freq_index, freq_add, volmul);
+	else added=MIXER_AddSamples<Type,stereo,signeddata,nativeorder>(mixer.work, mixer.pos+done, len, data,
+		last, freq_index, freq_add, volmul);
+	done+=added;
+	//--End of modifications
+	//--Added 2026-10-17 for sleeping silent channels
+	if (sleep_after) {
+		if (MIXER_IsSilent<Type,stereo,signeddata,nativeorder>(len,data)) silent+=added;
+		else silent=0;
 	}
+	//--End of modifications
 }
 
 void MixerChannel::AddStretched(Bitu len,Bit16s * data) {
@@ -273,6 +296,9 @@ void MixerChannel::AddStretched(Bitu len,Bit16s * data) {
 		return;
 	}
 	Bitu outlen=needed-done;Bits diff;
+	//--Added 2026-10-17 for sleeping silent channels: stretched blocks always count as sound
+	silent=0;
+	//--End of modifications
 	freq_index=0;
 	Bitu temp_add=(len << MIXER_SHIFT)/outlen;
 	Bitu mixpos=mixer.pos+done;done=needed;
@@ -345,14 +371,14 @@ void MixerChannel::AddSamples_s32_nonnative(Bitu len,const Bit32s * data) {
 }
 
 void MixerChannel::FillUp(void) {
-	SDL_LockAudio();
+	//--Modified 2026-10-17 for a lock-free mixer output: mixer.needed now only counts
+	//the current tick's samples, as it always has without sound
 	if (!enabled || done<mixer.done) {
-		SDL_UnlockAudio();
 		return;
 	}
 	float index=PIC_TickIndex();
 	Mix((Bitu)(index*mixer.needed));
-	SDL_UnlockAudio();
+	//--End of modifications
 }
 
 extern bool ticksLocked;
@@ -375,32 +401,28 @@ static void MIXER_MixData(Bitu needed) {
 		if (added>1024) 
 			added=1024;
 		Bitu readpos=(mixer.pos+mixer.done)&MIXER_BUFMASK;
-		for (Bitu i=0;i<added;i++) {
-			Bits sample=mixer.work[readpos][0] >> MIXER_VOLSHIFT;
-			convert[i][0]=MIXER_CLIP(sample);
-			sample=mixer.work[readpos][1] >> MIXER_VOLSHIFT;
-			convert[i][1]=MIXER_CLIP(sample);
-			readpos=(readpos+1)&MIXER_BUFMASK;
+		//--Modified 2026-10-17 for vectorised mixing
+		for (Bitu i=0;i<added;) {
+			Bitu run=MIXER_BUFSIZE-readpos;
+			if (run>added-i) run=added-i;
+			MIXER_Clip(&convert[i], &mixer.work[readpos], run);
+			readpos=(readpos+run)&MIXER_BUFMASK;
+			i+=run;
 		}
+		//--End of modifications
 		CAPTURE_AddWave( mixer.freq, added, (Bit16s*)convert );
 	}
 	//Reset the the tick_add for constant speed
+	//--Modified 2026-10-17 for a lock-free mixer output
 	if( Mixer_irq_important() )
-		mixer.tick_add = ((mixer.freq) << MIXER_SHIFT)/1000;
+		__atomic_store_n(&mixer.tick_add, ((mixer.freq) << MIXER_SHIFT)/1000, __ATOMIC_RELAXED);
+	//--End of modifications
 	mixer.done = needed;
 }
 
-static void MIXER_Mix(void) {
-	SDL_LockAudio();
-	MIXER_MixData(mixer.needed);
-	mixer.tick_remain+=mixer.tick_add;
-	mixer.needed+=(mixer.tick_remain>>MIXER_SHIFT);
-	mixer.tick_remain&=MIXER_REMAIN;
-	SDL_UnlockAudio();
-}
-
-static void MIXER_Mix_NoSound(void) {
-	MIXER_MixData(mixer.needed);
+//--Added 2026-10-17 for a lock-free mixer output
+/* Clear the piece we've just generated and set up the next tick */
+static void MIXER_NextTick(void) {
 	/* Clear piece we've just generated */
 	for (Bitu i=0;i<mixer.needed;i++) {
 		mixer.work[mixer.pos][0]=0;
@@ -413,45 +435,80 @@ static void MIXER_Mix_NoSound(void) {
 		else chan->done=0;
 	}
 	/* Set values for next tick */
-	mixer.tick_remain+=mixer.tick_add;
-	mixer.needed=mixer.tick_remain>>MIXER_SHIFT;
+	mixer.tick_remain+=__atomic_load_n(&mixer.tick_add, __ATOMIC_RELAXED);
+	__atomic_store_n(&mixer.needed, mixer.tick_remain>>MIXER_SHIFT, __ATOMIC_RELAXED);
 	mixer.tick_remain&=MIXER_REMAIN;
 	mixer.done=0;
 }
 
+static void MIXER_Mix(void) {
+	MIXER_MixData(mixer.needed);
+	/* Hand the finished samples over to the audio callback, if there's room for them */
+	Bitu write=mixerOutput.write;
+	Bitu room=MIXER_BUFSIZE-(write-__atomic_load_n(&mixerOutput.read, __ATOMIC_ACQUIRE));
+	Bitu count=mixer.needed;
+	if (count>room) {
+		count=room;
+		__atomic_add_fetch(&mixerOutput.overruns, 1, __ATOMIC_RELAXED);
+	}
+	Bitu readpos=mixer.pos;
+	for (Bitu i=0;i<count;) {
+		Bitu writepos=(write+i)&MIXER_BUFMASK;
+		Bitu run=MIXER_BUFSIZE-(readpos>writepos ? readpos : writepos);
+		if (run>count-i) run=count-i;
+		MIXER_Clip(&mixerOutput.buf[writepos], &mixer.work[readpos], run);
+		readpos=(readpos+run)&MIXER_BUFMASK;
+		i+=run;
+	}
+	__atomic_store_n(&mixerOutput.write, write+count, __ATOMIC_RELEASE);
+	MIXER_NextTick();
+}
+
+static void MIXER_Mix_NoSound(void) {
+	MIXER_MixData(mixer.needed);
+	MIXER_NextTick();
+}
+//--End of modifications
+
+//--Modified 2026-10-17 for a lock-free mixer output: reads from mixerOutput without taking
+//any locks, and leaves mixer.work and the channels to the emulation thread
 static void MIXER_CallBack(void * userdata, Uint8 *stream, int len) {
 	Bitu need=(Bitu)len/MIXER_SSIZE;
 	Bit16s * output=(Bit16s *)stream;
 	Bitu reduce;
 	Bitu pos, index, index_add;
-	Bits sample;
+	/* What the emulation thread has finished for us, and what it's working on */
+	Bitu done=__atomic_load_n(&mixerOutput.write, __ATOMIC_ACQUIRE)-mixerOutput.read;
+	Bitu pending=done+__atomic_load_n(&mixer.needed, __ATOMIC_RELAXED);
+	Bit32u tick_add=__atomic_load_n(&mixer.tick_add, __ATOMIC_RELAXED);
 	/* Enough room in the buffer ? */
-	if (mixer.done < need) {
-//		LOG_MSG("Full underrun need %d, have %d, min %d", need, mixer.done, mixer.min_needed);
-		if((need - mixer.done) > (need >>7) ) //Max 1 procent stretch.
+	if (done < need) {
+//		LOG_MSG("Full underrun need %d, have %d, min %d", need, done, mixer.min_needed);
+		__atomic_add_fetch(&mixerOutput.underruns, 1, __ATOMIC_RELAXED);
+		if((need - done) > (need >>7) ) //Max 1 procent stretch.
 			return;
-		reduce = mixer.done;
+		reduce = done;
 		index_add = (reduce << MIXER_SHIFT) / need;
-		mixer.tick_add = ((mixer.freq+mixer.min_needed) << MIXER_SHIFT)/1000;
-	} else if (mixer.done < mixer.max_needed) {
-		Bitu left = mixer.done - need;
+		tick_add = ((mixer.freq+mixer.min_needed) << MIXER_SHIFT)/1000;
+	} else if (done < mixer.max_needed) {
+		Bitu left = done - need;
 		if (left < mixer.min_needed) {
 			if( !Mixer_irq_important() ) {
-				Bitu needed = mixer.needed - need;
+				Bitu needed = pending - need;
 				Bitu diff = (mixer.min_needed>needed?mixer.min_needed:needed) - left;
-				mixer.tick_add = ((mixer.freq+(diff*3)) << MIXER_SHIFT)/1000;
+				tick_add = ((mixer.freq+(diff*3)) << MIXER_SHIFT)/1000;
 				left = 0; //No stretching as we compensate with the tick_add value
 			} else {
 				left = (mixer.min_needed - left);
 				left = 1 + (2*left) / mixer.min_needed; //left=1,2,3
 			}
-//			LOG_MSG("needed underrun need %d, have %d, min %d, left %d", need, mixer.done, mixer.min_needed, left);
+//			LOG_MSG("needed underrun need %d, have %d, min %d, left %d", need, done, mixer.min_needed, left);
 			reduce = need - left;
 			index_add = (reduce << MIXER_SHIFT) / need;
 		} else {
 			reduce = need;
 			index_add = (1 << MIXER_SHIFT);
-//			LOG_MSG("regular run need %d, have %d, min %d, left %d", need, mixer.done, mixer.min_needed, left);
+//			LOG_MSG("regular run need %d, have %d, min %d, left %d", need, done, mixer.min_needed, left);
 
 			/* Mixer tick value being updated:
 			 * 3 cases:
@@ -462,68 +519,59 @@ static void MIXER_CallBack(void * userdata, Uint8 *stream, int len) {
 			Bitu diff = left - mixer.min_needed;
 			if(diff > (mixer.min_needed<<1)) diff = mixer.min_needed<<1;
 			if(diff > (mixer.min_needed>>1))
-				mixer.tick_add = ((mixer.freq-(diff/5)) << MIXER_SHIFT)/1000;
+				tick_add = ((mixer.freq-(diff/5)) << MIXER_SHIFT)/1000;
 			else if (diff > (mixer.min_needed>>4))
-				mixer.tick_add = ((mixer.freq-(diff>>3)) << MIXER_SHIFT)/1000;
+				tick_add = ((mixer.freq-(diff>>3)) << MIXER_SHIFT)/1000;
 			else
-				mixer.tick_add = (mixer.freq<< MIXER_SHIFT)/1000;
+				tick_add = (mixer.freq<< MIXER_SHIFT)/1000;
 		}
 	} else {
 		/* There is way too much data in the buffer */
-//		LOG_MSG("overflow run need %d, have %d, min %d", need, mixer.done, mixer.min_needed);
-		if (mixer.done > MIXER_BUFSIZE)
+//		LOG_MSG("overflow run need %d, have %d, min %d", need, done, mixer.min_needed);
+		__atomic_add_fetch(&mixerOutput.overruns, 1, __ATOMIC_RELAXED);
+		if (done > MIXER_BUFSIZE)
 			index_add = MIXER_BUFSIZE - 2*mixer.min_needed;
 		else 
-			index_add = mixer.done - 2*mixer.min_needed;
+			index_add = done - 2*mixer.min_needed;
 		index_add = (index_add << MIXER_SHIFT) / need;
-		reduce = mixer.done - 2* mixer.min_needed;
-		mixer.tick_add = ((mixer.freq-(mixer.min_needed/5)) << MIXER_SHIFT)/1000;
-	}
-	/* Reduce done count in all channels */
-	for (MixerChannel * chan=mixer.channels;chan;chan=chan->next) {
-		if (chan->done>reduce) chan->done-=reduce;
-		else chan->done=0;
+		reduce = done - 2* mixer.min_needed;
+		tick_add = ((mixer.freq-(mixer.min_needed/5)) << MIXER_SHIFT)/1000;
 	}
    
 	// Reset mixer.tick_add when irqs are important
 	if( Mixer_irq_important() )
-		mixer.tick_add=(mixer.freq<< MIXER_SHIFT)/1000;
+		tick_add=(mixer.freq<< MIXER_SHIFT)/1000;
+	__atomic_store_n(&mixer.tick_add, tick_add, __ATOMIC_RELAXED);
 
-	mixer.done -= reduce;
-	mixer.needed -= reduce;
-	pos = mixer.pos;
-	mixer.pos = (mixer.pos + reduce) & MIXER_BUFMASK;
+	pos = mixerOutput.read;
 	index = 0;
 	if(need != reduce) {
 		while (need--) {
 			Bitu i = (pos + (index >> MIXER_SHIFT )) & MIXER_BUFMASK;
 			index += index_add;
-			sample=mixer.work[i][0]>>MIXER_VOLSHIFT;
-			*output++=MIXER_CLIP(sample);
-			sample=mixer.work[i][1]>>MIXER_VOLSHIFT;
-			*output++=MIXER_CLIP(sample);
-		}
-		/* Clean the used buffer */
-		while (reduce--) {
-			pos &= MIXER_BUFMASK;
-			mixer.work[pos][0]=0;
-			mixer.work[pos][1]=0;
-			pos++;
+			*output++=mixerOutput.buf[i][0];
+			*output++=mixerOutput.buf[i][1];
 		}
 	} else {
-		while (reduce--) {
+		while (need--) {
 			pos &= MIXER_BUFMASK;
-			sample=mixer.work[pos][0]>>MIXER_VOLSHIFT;
-			*output++=MIXER_CLIP(sample);
-			sample=mixer.work[pos][1]>>MIXER_VOLSHIFT;
-			*output++=MIXER_CLIP(sample);
-			mixer.work[pos][0]=0;
-			mixer.work[pos][1]=0;
+			*output++=mixerOutput.buf[pos][0];
+			*output++=mixerOutput.buf[pos][1];
 			pos++;
 		}
 	}
+	/* Give the samples we've used back to the emulation thread */
+	__atomic_store_n(&mixerOutput.read, mixerOutput.read + reduce, __ATOMIC_RELEASE);
 }
 
+//Returns how many times the audio callback has run short of samples, and how many times
+//samples have had to be thrown away because the audio callback wasn't keeping up.
+void MIXER_GetBufferStats(Bitu *underruns, Bitu *overruns) {
+	*underruns = __atomic_load_n(&mixerOutput.underruns, __ATOMIC_RELAXED);
+	*overruns = __atomic_load_n(&mixerOutput.overruns, __ATOMIC_RELAXED);
+}
+//--End of modifications
+
 static void MIXER_Stop(Section* sec) {
 }
 
@@ -632,12 +680,18 @@ void MIXER_Init(Section* sec) {
 	mixer.freq=section->Get_int("rate");
 	mixer.nosound=section->Get_bool("nosound");
 	mixer.blocksize=section->Get_int("blocksize");
+	//--Added 2026-10-17 for polyphase resampling
+	mixer_polyphase=section->Get_string("polyphase");
+	//--End of modifications
 
 	/* Initialize the internal stuff */
 	mixer.channels=0;
 	mixer.pos=0;
 	mixer.done=0;
 	memset(mixer.work,0,sizeof(mixer.work));
+	//--Added 2026-10-17 for a lock-free mixer output
+	memset(&mixerOutput,0,sizeof(mixerOutput));
+	//--End of modifications
 	
     mixer.mastervol[0]=1.0f;
 	mixer.mastervol[1]=1.0f;
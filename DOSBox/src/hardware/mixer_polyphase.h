@@ -0,0 +1,217 @@
+/*
+ *  Copyright (C) 2002-2010  The DOSBox Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+//Band-limited resampling for mixer channels, as an alternative to the linear interpolation
+//in mixer_simd.h. Each output sample is filtered from the MIXER_FIR_TAPS source samples around
+//it, with a Kaiser-windowed sinc that cuts off below the lower of the two rates, so that
+//upsampling doesn't leave images of the source above its Nyquist frequency and downsampling
+//doesn't alias. The filter is precomputed at MIXER_FIR_PHASES fractional positions between
+//source samples, as 16 bit coefficients that sum to 1, and the output uses the nearest one.
+//The filter runs MIXER_FIR_TAPS/2 source samples behind, where linear interpolation runs one
+//behind. The _C filter is the plain loop; the SSE2 one does 8 taps at a time with pmaddwd.
+//This needs mem.h, mixer.h and mixer_simd.h.
+
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define MIXER_FIR_TAPS 32
+#define MIXER_FIR_PHASEBITS 8
+#define MIXER_FIR_PHASES (1<<MIXER_FIR_PHASEBITS)
+#define MIXER_FIR_SHIFT 15
+
+struct MixerFIR {
+	Bitu cutoff_add;	//The freq_add the table was made for, no lower than one source sample
+	Bit16s table[MIXER_FIR_PHASES+1][MIXER_FIR_TAPS];
+	Bit16s history[2][MIXER_FIR_TAPS-1];	//The source samples before the next block
+};
+
+static double MIXER_BesselI0(double x) {
+	double sum=1.0,term=1.0;
+	for (Bitu k=1;k<64 && term>sum*1e-12;k++) {
+		term*=(x/(2.0*k))*(x/(2.0*k));
+		sum+=term;
+	}
+	return sum;
+}
+
+/* Works out the filter for resampling at freq_add steps. Upsampling always uses the same
+   filter, so this only does any work when the channel starts or its downsampling ratio
+   changes. */
+static void MIXER_MakeFIR(MixerFIR &fir, Bitu freq_add) {
+	Bitu cutoff_add=(freq_add > (1 << MIXER_SHIFT)) ? freq_add : (1 << MIXER_SHIFT);
+	if (fir.cutoff_add==cutoff_add) return;
+	fir.cutoff_add=cutoff_add;
+
+	//The transition band is as narrow as this many taps can manage with a Kaiser window
+	//of this beta, which keeps the stopband about 60dB down
+	const double beta=6.0;
+	const double transition=0.12;
+	double ratio=(double)(1 << MIXER_SHIFT)/cutoff_add;
+	double cutoff=0.5*ratio-transition/2;
+	if (cutoff<0.25*ratio) cutoff=0.25*ratio;
+	const double half=MIXER_FIR_TAPS/2;
+
+	for (Bitu phase=0;phase<=MIXER_FIR_PHASES;phase++) {
+		double taps[MIXER_FIR_TAPS],sum=0;
+		for (Bitu i=0;i<MIXER_FIR_TAPS;i++) {
+			//How far this tap's sample is from where the output sample falls
+			double x=(double)i+1.0-half-(double)phase/MIXER_FIR_PHASES;
+			double window=1.0-(x/half)*(x/half);
+			window=(window>0) ? MIXER_BesselI0(beta*sqrt(window))/MIXER_BesselI0(beta) : 0;
+			double sinc=(x==0) ? 1.0 : sin(M_PI*2*cutoff*x)/(M_PI*2*cutoff*x);
+			taps[i]=2*cutoff*sinc*window;
+			sum+=taps[i];
+		}
+		//Normalise the taps to unity gain, and put any rounding left over on the biggest one
+		Bits total=0;
+		Bitu biggest=0;
+		for (Bitu i=0;i<MIXER_FIR_TAPS;i++) {
+			Bits tap=(Bits)floor(taps[i]/sum*(1 << MIXER_FIR_SHIFT)+0.5);
+			fir.table[phase][i]=(Bit16s)tap;
+			total+=tap;
+			if (taps[i]>taps[biggest]) biggest=i;
+		}
+		fir.table[phase][biggest]+=(Bit16s)((1 << MIXER_FIR_SHIFT)-total);
+	}
+}
+
+static void MIXER_ClearFIR(MixerFIR &fir) {
+	memset(fir.history,0,sizeof(fir.history));
+}
+
+/* Converts one value of source data into a 16 bit sample, as MIXER_AddSamples_C does */
+template<class Type,bool signeddata,bool nativeorder>
+static INLINE Bit16s MIXER_FIRSample(const Type *data) {
+	Bits sample;
+	if (sizeof(Type) == 1) {
+		if (!signeddata) sample=((Bit8s)(*data ^ 0x80)) << 8;
+		else sample=*data << 8;
+	} else if (nativeorder) {
+		if (!signeddata) sample=(Bits)*data-32768;
+		else sample=*data;
+	} else if (sizeof(Type) == 2) {
+		if (!signeddata) sample=(Bits)host_readw((HostPt)data)-32768;
+		else sample=(Bit16s)host_readw((HostPt)data);
+	} else {
+		if (!signeddata) sample=(Bits)host_readd((HostPt)data)-32768;
+		else sample=(Bit32s)host_readd((HostPt)data);
+	}
+	//32 bit data isn't meant to be any wider than 16 bit, but it's clipped in case it is
+	return MIXER_CLIP(sample);
+}
+
+/* Filters the taps from left, and from right for stereo data, with coefs */
+template<bool stereo>
+static INLINE void MIXER_FIRFilter_C(const Bit16s *left, const Bit16s *right, const Bit16s *coefs, Bit32s *out) {
+	Bit32s sum[2]={0,0};
+	for (Bitu i=0;i<MIXER_FIR_TAPS;i++) {
+		sum[0]+=left[i]*coefs[i];
+		if (stereo) sum[1]+=right[i]*coefs[i];
+	}
+	out[0]=sum[0];
+	out[1]=sum[1];
+}
+
+#if defined(MIXER_SIMD_SSE2)
+template<bool stereo>
+static INLINE void MIXER_FIRFilter_SSE2(const Bit16s *left, const Bit16s *right, const Bit16s *coefs, Bit32s *out) {
+	__m128i sumLeft=_mm_setzero_si128(),sumRight=_mm_setzero_si128();
+	for (Bitu i=0;i<MIXER_FIR_TAPS;i+=8) {
+		__m128i c=_mm_loadu_si128((const __m128i *)&coefs[i]);
+		sumLeft=_mm_add_epi32(sumLeft,_mm_madd_epi16(_mm_loadu_si128((const __m128i *)&left[i]),c));
+		if (stereo) sumRight=_mm_add_epi32(sumRight,_mm_madd_epi16(_mm_loadu_si128((const __m128i *)&right[i]),c));
+	}
+	//Add up the left sums into the first lane and the right ones into the second
+	__m128i sum=_mm_add_epi32(_mm_unpacklo_epi32(sumLeft,sumRight),_mm_unpackhi_epi32(sumLeft,sumRight));
+	sum=_mm_add_epi32(sum,_mm_shuffle_epi32(sum,_MM_SHUFFLE(1,0,3,2)));
+	_mm_storel_epi64((__m128i *)out,sum);
+}
+#endif
+
+/* Resamples len source samples at freq_add steps from freq_index through the filter, and adds
+   them at volmul into work from mixpos on, wrapping around the end of it. Returns how many it
+   added. Unlike MIXER_AddSamples_C, freq_index carries on into the next block from where this
+   one left off, rather than always starting with its first source sample: when downsampling,
+   that would otherwise slip a sample every so often. */
+template<class Type,bool stereo,bool signeddata,bool nativeorder,bool vector>
+static Bitu MIXER_AddSamplesFIR_Filter(Bit32s (*work)[2], Bitu mixpos, Bitu len, const Type* data,
+	MixerFIR &fir, Bitu &freq_index, Bitu freq_add, const Bit32s *volmul) {
+	static Bit16s source[2][MIXER_FIR_TAPS-1+MIXER_BUFSIZE];
+	const Bitu channels=stereo ? 2 : 1;
+	if (!len || !freq_add) return 0;
+	if (len>MIXER_BUFSIZE) {
+		Bitu done=MIXER_AddSamplesFIR_Filter<Type,stereo,signeddata,nativeorder,vector>(work, mixpos, MIXER_BUFSIZE, data, fir, freq_index, freq_add, volmul);
+		return done+MIXER_AddSamplesFIR_Filter<Type,stereo,signeddata,nativeorder,vector>(work, mixpos+done, len-MIXER_BUFSIZE,
+			data+MIXER_BUFSIZE*channels, fir, freq_index, freq_add, volmul);
+	}
+
+	for (Bitu c=0;c<channels;c++) {
+		memcpy(source[c],fir.history[c],sizeof(fir.history[c]));
+		for (Bitu i=0;i<len;i++)
+			source[c][MIXER_FIR_TAPS-1+i]=MIXER_FIRSample<Type,signeddata,nativeorder>(&data[i*channels+c]);
+	}
+
+	//Every output sample up to the one that would need the source sample after the block
+	Bitu count=(freq_index < (len << MIXER_SHIFT)) ?
+		((len << MIXER_SHIFT) - freq_index + freq_add - 1) / freq_add : 0;
+	const Bits round=1 << (MIXER_FIR_SHIFT-1);
+	for (Bitu i=0;i<count;i++,freq_index+=freq_add) {
+		//The taps end at the newest source sample, which is pos in the block
+		Bitu pos=freq_index >> MIXER_SHIFT;
+		Bitu phase=((freq_index & MIXER_REMAIN) + (1 << (MIXER_SHIFT-MIXER_FIR_PHASEBITS-1))) >> (MIXER_SHIFT-MIXER_FIR_PHASEBITS);
+		Bit32s out[2];
+#if defined(MIXER_SIMD_SSE2)
+		if (vector) MIXER_FIRFilter_SSE2<stereo>(&source[0][pos], &source[1][pos], fir.table[phase], out);
+		else
+#endif
+		MIXER_FIRFilter_C<stereo>(&source[0][pos], &source[1][pos], fir.table[phase], out);
+		mixpos&=MIXER_BUFMASK;
+		Bits sample=(out[0]+round) >> MIXER_FIR_SHIFT;
+		work[mixpos][0]+=sample*volmul[0];
+		if (stereo) sample=(out[1]+round) >> MIXER_FIR_SHIFT;
+		work[mixpos][1]+=sample*volmul[1];
+		mixpos++;
+	}
+
+	for (Bitu c=0;c<channels;c++)
+		memcpy(fir.history[c],&source[c][len],sizeof(fir.history[c]));
+	freq_index-=len << MIXER_SHIFT;
+	return count;
+}
+
+template<class Type,bool stereo,bool signeddata,bool nativeorder>
+static Bitu MIXER_AddSamplesFIR_C(Bit32s (*work)[2], Bitu mixpos, Bitu len, const Type* data,
+	MixerFIR &fir, Bitu &freq_index, Bitu freq_add, const Bit32s *volmul) {
+	return MIXER_AddSamplesFIR_Filter<Type,stereo,signeddata,nativeorder,false>(work, mixpos, len, data, fir, freq_index, freq_add, volmul);
+}
+
+#if defined(MIXER_SIMD_SSE2)
+template<class Type,bool stereo,bool signeddata,bool nativeorder>
+static Bitu MIXER_AddSamplesFIR_SSE2(Bit32s (*work)[2], Bitu mixpos, Bitu len, const Type* data,
+	MixerFIR &fir, Bitu &freq_index, Bitu freq_add, const Bit32s *volmul) {
+	return MIXER_AddSamplesFIR_Filter<Type,stereo,signeddata,nativeorder,true>(work, mixpos, len, data, fir, freq_index, freq_add, volmul);
+}
+
+#define MIXER_AddSamplesFIR	MIXER_AddSamplesFIR_SSE2
+#else
+#define MIXER_AddSamplesFIR	MIXER_AddSamplesFIR_C
+#endif
@@ -0,0 +1,321 @@
+/*
+ *  Copyright (C) 2002-2010  The DOSBox Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+//Sample conversion, resampling and accumulation for MixerChannel::AddSamples in mixer.cpp,
+//and the clipping of mixed samples down to 16 bits. The _C versions are the loops the mixer
+//has always used. The SSE2 versions convert a whole block of 8 or 16 bit samples at a time
+//and interpolate and accumulate four output samples at a time, with exactly the same integer
+//arithmetic: they are used whenever the compiler targets SSE2, which every x86-64 CPU has.
+//This needs mem.h and mixer.h.
+
+#define MIXER_SHIFT 14
+#define MIXER_REMAIN ((1<<MIXER_SHIFT)-1)
+#define MIXER_VOLSHIFT 13
+
+static INLINE Bit16s MIXER_CLIP(Bits SAMP) {
+	if (SAMP < MAX_AUDIO) {
+		if (SAMP > MIN_AUDIO)
+			return SAMP;
+		else return MIN_AUDIO;
+	} else return MAX_AUDIO;
+}
+
+#if defined(__SSE2__)
+#define MIXER_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/* Resamples len source samples at freq_add steps from freq_index, and adds them at volmul
+   into work from mixpos on, wrapping around the end of it. last holds the source sample
+   before the block, and is left holding the last one used. Returns the samples it added. */
+template<class Type,bool stereo,bool signeddata,bool nativeorder>
+static Bitu MIXER_AddSamples_C(Bit32s (*work)[2], Bitu mixpos, Bitu len, const Type* data,
+	Bits *last, Bitu &freq_index, Bitu freq_add, const Bit32s *volmul) {
+	Bits diff[2];
+	Bitu done=0;
+	freq_index&=MIXER_REMAIN;
+	Bitu pos=0;Bitu new_pos;
+
+	goto thestart;
+	for (;;) {
+		new_pos=freq_index >> MIXER_SHIFT;
+		if (pos<new_pos) {
+			last[0]+=diff[0];
+			if (stereo) last[1]+=diff[1];
+			pos=new_pos;
+thestart:
+			if (pos>=len) return done;
+			if ( sizeof( Type) == 1) {
+				if (!signeddata) {
+					if (stereo) {
+						diff[0]=(((Bit8s)(data[pos*2+0] ^ 0x80)) << 8)-last[0];
+						diff[1]=(((Bit8s)(data[pos*2+1] ^ 0x80)) << 8)-last[1];
+					} else {
+						diff[0]=(((Bit8s)(data[pos] ^ 0x80)) << 8)-last[0];
+					}
+				} else {
+					if (stereo) {
+						diff[0]=(data[pos*2+0] << 8)-last[0];
+						diff[1]=(data[pos*2+1] << 8)-last[1];
+					} else {
+						diff[0]=(data[pos] << 8)-last[0];
+					}
+				}
+			//16bit and 32bit both contain 16bit data internally
+			} else  {
+				if (signeddata) {
+					if (stereo) {
+						if (nativeorder) {
+							diff[0]=data[pos*2+0]-last[0];
+							diff[1]=data[pos*2+1]-last[1];
+						} else {
+							if ( sizeof( Type) == 2) {
+								diff[0]=(Bit16s)host_readw((HostPt)&data[pos*2+0])-last[0];
+								diff[1]=(Bit16s)host_readw((HostPt)&data[pos*2+1])-last[1];
+							} else {
+								diff[0]=(Bit32s)host_readd((HostPt)&data[pos*2+0])-last[0];
+								diff[1]=(Bit32s)host_readd((HostPt)&data[pos*2+1])-last[1];
+							}
+						}
+					} else {
+						if (nativeorder) {
+							diff[0]=data[pos]-last[0];
+						} else {
+							if ( sizeof( Type) == 2) {
+								diff[0]=(Bit16s)host_readw((HostPt)&data[pos])-last[0];
+							} else {
+								diff[0]=(Bit32s)host_readd((HostPt)&data[pos])-last[0];
+							}
+						}
+					}
+				} else {
+					if (stereo) {
+						if (nativeorder) {
+							diff[0]=(Bits)data[pos*2+0]-32768-last[0];
+							diff[1]=(Bits)data[pos*2+1]-32768-last[1];
+						} else {
+							if ( sizeof( Type) == 2) {
+								diff[0]=(Bits)host_readw((HostPt)&data[pos*2+0])-32768-last[0];
+								diff[1]=(Bits)host_readw((HostPt)&data[pos*2+1])-32768-last[1];
+							} else {
+								diff[0]=(Bits)host_readd((HostPt)&data[pos*2+0])-32768-last[0];
+								diff[1]=(Bits)host_readd((HostPt)&data[pos*2+1])-32768-last[1];
+							}
+						}
+					} else {
+						if (nativeorder) {
+							diff[0]=(Bits)data[pos]-32768-last[0];
+						} else {
+							if ( sizeof( Type) == 2) {
+								diff[0]=(Bits)host_readw((HostPt)&data[pos])-32768-last[0];
+							} else {
+								diff[0]=(Bits)host_readd((HostPt)&data[pos])-32768-last[0];
+							}
+						}
+					}
+				}
+			}
+		}
+		Bits diff_mul=freq_index & MIXER_REMAIN;
+		freq_index+=freq_add;
+		mixpos&=MIXER_BUFMASK;
+		Bits sample=last[0]+((diff[0]*diff_mul) >> MIXER_SHIFT);
+		work[mixpos][0]+=sample*volmul[0];
+		if (stereo) sample=last[1]+((diff[1]*diff_mul) >> MIXER_SHIFT);
+		work[mixpos][1]+=sample*volmul[1];
+		mixpos++;done++;
+	}
+}
+
+/* Clips count mixed samples down to 16 bits */
+static void MIXER_Clip_C(Bit16s (*dest)[2], const Bit32s (*src)[2], Bitu count) {
+	for (Bitu i=0;i<count;i++) {
+		Bits sample=src[i][0] >> MIXER_VOLSHIFT;
+		dest[i][0]=MIXER_CLIP(sample);
+		sample=src[i][1] >> MIXER_VOLSHIFT;
+		dest[i][1]=MIXER_CLIP(sample);
+	}
+}
+
+#if defined(MIXER_SIMD_SSE2)
+/* The low 32 bits of each product, which is all the mixer keeps of them */
+static INLINE __m128i MIXER_MulLo32_SSE2(__m128i a, __m128i b) {
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)),
+		_mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+}
+
+/* Converts 8 values of source data into 16 bit samples, as the _C version does.
+   host_readw is a plain load on x86, so the data's byte order doesn't matter here. */
+template<class Type,bool signeddata>
+static INLINE __m128i MIXER_Load8_SSE2(const Type *data) {
+	if (sizeof(Type) == 1) {
+		__m128i v = _mm_loadl_epi64((const __m128i *)data);
+		if (!signeddata) v = _mm_xor_si128(v, _mm_set1_epi8((char)0x80));
+		return _mm_unpacklo_epi8(_mm_setzero_si128(), v);
+	} else {
+		__m128i v = _mm_loadu_si128((const __m128i *)data);
+		if (!signeddata) v = _mm_xor_si128(v, _mm_set1_epi16((short)0x8000));
+		return v;
+	}
+}
+
+/* Converts len samples of 8 or 16 bit source data into left and right pairs, one Bit32s
+   each, with mono samples going to both */
+template<class Type,bool stereo,bool signeddata,bool nativeorder>
+static void MIXER_Convert_SSE2(Bitu len, const Type *data, Bit32s (*out)[2]) {
+	Bitu i=0;
+	if (stereo) {
+		for (;i+4<=len;i+=4) {
+			__m128i v = MIXER_Load8_SSE2<Type,signeddata>(&data[i*2]);
+			_mm_storeu_si128((__m128i *)&out[i], _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+			_mm_storeu_si128((__m128i *)&out[i+2], _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+		}
+	} else {
+		for (;i+8<=len;i+=8) {
+			__m128i v = MIXER_Load8_SSE2<Type,signeddata>(&data[i]);
+			__m128i lo = _mm_unpacklo_epi16(v, v), hi = _mm_unpackhi_epi16(v, v);
+			_mm_storeu_si128((__m128i *)&out[i], _mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16));
+			_mm_storeu_si128((__m128i *)&out[i+2], _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16));
+			_mm_storeu_si128((__m128i *)&out[i+4], _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16));
+			_mm_storeu_si128((__m128i *)&out[i+6], _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16));
+		}
+	}
+	for (;i<len;i++) {
+		//The _C version's conversions, for the samples left over
+		for (Bitu c=0;c<2;c++) {
+			const Type value=data[stereo ? i*2+c : i];
+			Bits sample;
+			if (sizeof(Type) == 1) {
+				if (!signeddata) sample=((Bit8s)(value ^ 0x80)) << 8;
+				else sample=value << 8;
+			} else {
+				if (!signeddata) sample=(Bits)value-32768;
+				else sample=value;
+			}
+			out[i][c]=sample;
+		}
+	}
+}
+
+/* Interpolates count samples from the converted source at freq_add steps from freq_index,
+   and adds them at volmul into work, which must not wrap. source[0] holds the sample before
+   the block, and the block itself follows it. When upsampling every source sample gets used
+   in turn, and when downsampling a new one gets used for each output sample, which is how
+   the _C version's running last and diff work out. */
+static void MIXER_Interpolate_SSE2(Bit32s (*work)[2], const Bit32s (*source)[2],
+	Bitu freq_index, Bitu freq_add, Bitu count, const Bit32s *volmul) {
+	//Interpolated samples stay within 16 bits, so they can be multiplied by the volume 15 bits
+	//of it at a time, keeping the low 32 bits of the product as the _C version does
+	const __m128i volumeLow = _mm_set_epi32(volmul[1] & 0x7fff, volmul[0] & 0x7fff, volmul[1] & 0x7fff, volmul[0] & 0x7fff);
+	const __m128i volumeHigh = _mm_set_epi32((volmul[1] >> 15) & 0xffff, (volmul[0] >> 15) & 0xffff,
+		(volmul[1] >> 15) & 0xffff, (volmul[0] >> 15) & 0xffff);
+	const bool upsampling = freq_add <= (1 << MIXER_SHIFT);
+	for (;count >= 2;count -= 2, freq_index += freq_add*2, work += 2) {
+		//Two output samples, left and right, at a time
+		__m128i prev, cur;
+		Bitu next = freq_index + freq_add;
+		Bitu fraction = freq_index & MIXER_REMAIN, nextFraction = next & MIXER_REMAIN;
+		Bitu pos = freq_index >> MIXER_SHIFT, nextPos = next >> MIXER_SHIFT;
+		if (upsampling) {
+			if (nextPos == pos + 1) {
+				prev = _mm_loadu_si128((const __m128i *)&source[pos]);
+				cur = _mm_loadu_si128((const __m128i *)&source[pos+1]);
+			} else {
+				prev = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)&source[pos]),
+					_mm_loadl_epi64((const __m128i *)&source[nextPos]));
+				cur = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)&source[pos+1]),
+					_mm_loadl_epi64((const __m128i *)&source[nextPos+1]));
+			}
+		} else {
+			Bitu prevPos = (freq_index >= freq_add) ? ((freq_index - freq_add) >> MIXER_SHIFT) + 1 : 0;
+			prev = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)&source[prevPos]),
+				_mm_loadl_epi64((const __m128i *)&source[pos+1]));
+			cur = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)&source[pos+1]),
+				_mm_loadl_epi64((const __m128i *)&source[nextPos+1]));
+		}
+		//Samples are at most 16 bits and the fraction 14, so the products fit in 32 bits
+		__m128i fractions = _mm_set_epi32(nextFraction, nextFraction, fraction, fraction);
+		__m128i sample = _mm_add_epi32(prev, _mm_srai_epi32(
+			MIXER_MulLo32_SSE2(_mm_sub_epi32(cur, prev), fractions), MIXER_SHIFT));
+		__m128i *out = (__m128i *)work;
+		sample = _mm_add_epi32(_mm_madd_epi16(sample, volumeLow), _mm_slli_epi32(_mm_madd_epi16(sample, volumeHigh), 15));
+		_mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), sample));
+	}
+	if (count) {
+		Bitu cur = (freq_index >> MIXER_SHIFT) + 1, prev;
+		if (upsampling) prev = cur - 1;
+		else prev = (freq_index >= freq_add) ? ((freq_index - freq_add) >> MIXER_SHIFT) + 1 : 0;
+		Bits diff_mul = freq_index & MIXER_REMAIN;
+		for (Bitu c=0;c<2;c++) {
+			Bits sample = source[prev][c] + (((source[cur][c] - source[prev][c]) * diff_mul) >> MIXER_SHIFT);
+			work[0][c] += sample*volmul[c];
+		}
+	}
+}
+
+template<class Type,bool stereo,bool signeddata,bool nativeorder>
+static Bitu MIXER_AddSamples_SSE2(Bit32s (*work)[2], Bitu mixpos, Bitu len, const Type* data,
+	Bits *last, Bitu &freq_index, Bitu freq_add, const Bit32s *volmul) {
+	//32 bit data can be wider than 16 bits, which the vector arithmetic relies on samples not being
+	if (sizeof(Type) == 4 || len > MIXER_BUFSIZE || !freq_add ||
+		(Bit16s)last[0] != last[0] || (stereo && (Bit16s)last[1] != last[1]))
+		return MIXER_AddSamples_C<Type,stereo,signeddata,nativeorder>(work, mixpos, len, data, last, freq_index, freq_add, volmul);
+
+	static Bit32s source[MIXER_BUFSIZE+1][2];
+	freq_index&=MIXER_REMAIN;
+	if (!len) return 0;
+
+	//A mono channel's last right sample is whatever it happened to be left at, and goes unused
+	source[0][0]=last[0];
+	source[0][1]=stereo ? last[1] : last[0];
+	MIXER_Convert_SSE2<Type,stereo,signeddata,nativeorder>(len, data, &source[1]);
+
+	//Every output sample up to the one that would need the source sample after the block
+	Bitu count=((len << MIXER_SHIFT) - freq_index + freq_add - 1) / freq_add;
+	for (Bitu todo=count;todo;) {
+		mixpos&=MIXER_BUFMASK;
+		Bitu run=MIXER_BUFSIZE - mixpos;
+		if (run > todo) run = todo;
+		MIXER_Interpolate_SSE2(&work[mixpos], source, freq_index, freq_add, run, volmul);
+		freq_index+=freq_add*run;
+		mixpos+=run;
+		todo-=run;
+	}
+	Bitu lastpos=((freq_index - freq_add) >> MIXER_SHIFT) + 1;
+	last[0]=source[lastpos][0];
+	if (stereo) last[1]=source[lastpos][1];
+	return count;
+}
+
+static void MIXER_Clip_SSE2(Bit16s (*dest)[2], const Bit32s (*src)[2], Bitu count) {
+	for (;count >= 4;count -= 4, src += 4, dest += 4) {
+		__m128i lo = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)src), MIXER_VOLSHIFT);
+		__m128i hi = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)(src + 2)), MIXER_VOLSHIFT);
+		_mm_storeu_si128((__m128i *)dest, _mm_packs_epi32(lo, hi));
+	}
+	MIXER_Clip_C(dest, src, count);
+}
+
+#define MIXER_AddSamples	MIXER_AddSamples_SSE2
+#define MIXER_Clip			MIXER_Clip_SSE2
+#else
+#define MIXER_AddSamples	MIXER_AddSamples_C
+#define MIXER_Clip			MIXER_Clip_C
+#endif
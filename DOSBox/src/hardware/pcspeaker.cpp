@@ -163,6 +163,9 @@ static void ForwardPIT(float newindex) {
 }
 
 void PCSPEAKER_SetCounter(Bitu cntr,Bitu mode) {
+	//--Added 2026-10-17 for sleeping silent channels
+	if(spkr.chan) spkr.chan->WakeUp();
+	//--End of modifications
 	if (!spkr.last_ticks) {
 		if(spkr.chan) spkr.chan->Enable(true);
 		spkr.last_index=0;
@@ -218,6 +221,9 @@ void PCSPEAKER_SetCounter(Bitu cntr,Bitu mode) {
 }
 
 void PCSPEAKER_SetType(Bitu mode) {
+	//--Added 2026-10-17 for sleeping silent channels
+	if(spkr.chan) spkr.chan->WakeUp();
+	//--End of modifications
 	if (!spkr.last_ticks) {
 		if(spkr.chan) spkr.chan->Enable(true);
 		spkr.last_index=0;
@@ -247,6 +253,27 @@ void PCSPEAKER_SetType(Bitu mode) {
 	};
 }
 
+//--Added 2026-10-17 for sleeping silent channels: moved out of PCSPEAKER_CallBack,
+//so that the mixer can also check it while the channel sleeps
+static void PCSPEAKER_CheckIdle(void) {
+	//Turn off speaker after 10 seconds of idle or one second idle when in off mode
+	bool turnoff = false;
+	Bitu test_ticks = PIC_Ticks;
+	if ((spkr.last_ticks + 10000) < test_ticks) turnoff = true;
+	if((spkr.mode == SPKR_OFF) && ((spkr.last_ticks + 1000) < test_ticks)) turnoff = true;
+
+	if(turnoff){
+		if(spkr.volwant == 0) { 
+			spkr.last_ticks = 0;
+			if(spkr.chan) spkr.chan->Enable(false);
+		} else {
+			if(spkr.volwant > 0) spkr.volwant--; else spkr.volwant++;
+		
+		}
+	} 
+}
+//--End of modifications
+
 static void PCSPEAKER_CallBack(Bitu len) {
 	Bit16s * stream=(Bit16s*)MixTemp;
 	ForwardPIT(1);
@@ -304,22 +331,9 @@ static void PCSPEAKER_CallBack(Bitu len) {
 	}
 	if(spkr.chan) spkr.chan->AddSamples_m16(len,(Bit16s*)MixTemp);
 
-	//Turn off speaker after 10 seconds of idle or one second idle when in off mode
-	bool turnoff = false;
-	Bitu test_ticks = PIC_Ticks;
-	if ((spkr.last_ticks + 10000) < test_ticks) turnoff = true;
-	if((spkr.mode == SPKR_OFF) && ((spkr.last_ticks + 1000) < test_ticks)) turnoff = true;
-
-	if(turnoff){
-		if(spkr.volwant == 0) { 
-			spkr.last_ticks = 0;
-			if(spkr.chan) spkr.chan->Enable(false);
-		} else {
-			if(spkr.volwant > 0) spkr.volwant--; else spkr.volwant++;
-		
-		}
-	} 
-
+	//--Modified 2026-10-17 for sleeping silent channels: moved to PCSPEAKER_CheckIdle
+	PCSPEAKER_CheckIdle();
+	//--End of modifications
 }
 class PCSPEAKER:public Module_base {
 private:
@@ -342,6 +356,9 @@ public:
 		spkr.used=0;
 		/* Register the sound channel */
 		spkr.chan=MixerChan.Install(&PCSPEAKER_CallBack,spkr.rate,"SPKR");
+		//--Added 2026-10-17 for sleeping silent channels
+		spkr.chan->SetSleepDelay(1000,PCSPEAKER_CheckIdle);
+		//--End of modifications
 	}
 	~PCSPEAKER(){
 		Section_prop * section=static_cast<Section_prop *>(m_configuration);
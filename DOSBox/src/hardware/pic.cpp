@@ -59,19 +59,63 @@ Bitu PIC_IRQActive;
 static IRQ_Block irqs[16];
 static PIC_Controller pics[2];
 static bool PIC_Special_Mode = false; //Saves one compare in the pic_run_irqloop
+//--Modified 2026-10-17 to replace the sorted event list with a binary heap.
+//Adding an event used to walk the whole list, which got expensive with many devices
+//scheduling events at once. A handful of events is still quickest in the list though,
+//so the queue only becomes a heap once adding an event has to walk past PIC_LIST_MAX
+//of them, and goes back to being a list once it's down to PIC_LIST_MIN. In the heap,
+//entries with equal indexes are ordered by when they were added, which reproduces the
+//firing order of the list exactly.
 struct PICEntry {
 	float index;
+	Bit32u generation;		//Incremented whenever the entry is freed, to invalidate handles
 	Bitu value;
 	PIC_EventHandler pic_event;
+	PICEntry * next;		//Next entry in the free list, or in the queue while it's a list
+	Bitu heap_pos;			//Position of this entry in pic_queue.heap, while the queue is a heap
+};
+
+//Chains the entries with the same handler and value hash together while the queue is a heap.
+//These are kept apart from the entries, which the list goes through.
+struct PICChainLink {
 	PICEntry * next;
+	PICEntry * prev;
 };
 
+//The sort keys live in the heap itself, so that reordering doesn't have to visit the entries,
+//and so do the handler and value, so that finding a device's events doesn't either.
+struct PICHeapNode {
+	float index;
+	Bit32u sequence;		//Insertion order, used to break ties between equal indexes
+	PICEntry * entry;
+	PIC_EventHandler pic_event;
+	Bitu value;
+};
+
+/* In the PICQueue benchmark, the mix with 32 GUS-like voices runs 1.3-1.4x as fast as the old
+   list with the heap taking over anywhere from 8 to 32 events, but only 1.06x at 48. Mixes of a
+   few devices never have more than 8 events queued, so they stay a list either way. */
+#define PIC_LIST_MAX 16
+#define PIC_LIST_MIN 8
+#define PIC_CHAIN_BUCKETS 64
+
 static struct {
 	PICEntry entries[PIC_QUEUESIZE];
 	PICEntry * free_entry;
-	PICEntry * next_entry;
+	PICEntry * next_entry;	//The next event to fire, in the heap as well as the list
+	bool heaped;
+	Bitu size;				//Only counted while the queue is a heap
+	PICHeapNode heap[PIC_QUEUESIZE];
+	Bit32u next_sequence;
+	PICEntry * chains[PIC_CHAIN_BUCKETS];
+	PICChainLink links[PIC_QUEUESIZE];
 } pic_queue;
 
+/* Event handles combine the entry's slot with its generation */
+#define PIC_HANDLE_SLOT_BITS 10
+#define PIC_HANDLE_SLOT_MASK ((1 << PIC_HANDLE_SLOT_BITS) - 1)
+//--End of modifications
+
 static void write_command(Bitu port,Bitu val,Bitu iolen) {
 	PIC_Controller * pic=&pics[port==0x20 ? 0 : 1];
 	Bitu irq_base=port==0x20 ? 0 : 8;
@@ -353,30 +397,166 @@ void PIC_SetIRQMask(Bitu irq, bool masked) {
 	}
 }
 
-static void AddEntry(PICEntry * entry) {
-	PICEntry * find_entry=pic_queue.next_entry;
-	if (GCC_UNLIKELY(find_entry ==0)) {
-		entry->next=0;
-		pic_queue.next_entry=entry;
-	} else if (find_entry->index>entry->index) {
+//--Modified 2026-10-17 to replace the sorted event list with a binary heap.
+static INLINE bool NodePrecedes(const PICHeapNode & a,const PICHeapNode & b) {
+	if (a.index != b.index) return a.index < b.index;
+	return (Bit32s)(a.sequence - b.sequence) < 0;
+}
+
+static INLINE void PlaceNode(const PICHeapNode & node,Bitu pos) {
+	pic_queue.heap[pos]=node;
+	node.entry->heap_pos=pos;
+}
+
+static void SiftUp(Bitu pos) {
+	PICHeapNode node=pic_queue.heap[pos];
+	while (pos>0) {
+		Bitu parent=(pos-1)/2;
+		if (!NodePrecedes(node,pic_queue.heap[parent])) break;
+		PlaceNode(pic_queue.heap[parent],pos);
+		pos=parent;
+	}
+	PlaceNode(node,pos);
+}
+
+static void SiftDown(Bitu pos) {
+	PICHeapNode node=pic_queue.heap[pos];
+	for (;;) {
+		Bitu child=pos*2+1;
+		if (child>=pic_queue.size) break;
+		if (child+1<pic_queue.size && NodePrecedes(pic_queue.heap[child+1],pic_queue.heap[child])) child++;
+		if (!NodePrecedes(pic_queue.heap[child],node)) break;
+		PlaceNode(pic_queue.heap[child],pos);
+		pos=child;
+	}
+	PlaceNode(node,pos);
+}
+
+/* Lets PIC_RemoveSpecificEvents find a device's event in the heap without looking at the rest */
+static INLINE PICEntry * * EventChain(PIC_EventHandler handler,Bitu val) {
+	Bitu hash=(Bitu)(uintptr_t)handler ^ (val * 0x9e3779b1);
+	return &pic_queue.chains[(hash ^ (hash >> 6) ^ (hash >> 12)) % PIC_CHAIN_BUCKETS];
+}
+
+static INLINE PICChainLink & ChainLink(const PICEntry * entry) {
+	return pic_queue.links[entry-pic_queue.entries];
+}
+
+static INLINE void ChainEntry(PICEntry * entry) {
+	PICEntry * * chain=EventChain(entry->pic_event,entry->value);
+	PICChainLink & link=ChainLink(entry);
+	link.prev=0;
+	link.next=*chain;
+	if (link.next) ChainLink(link.next).prev=entry;
+	*chain=entry;
+}
+
+/* The list is sorted, so it's a heap already. Its entries get numbered in order, after any
+   that have been in the heap before. */
+static void MakeHeap(void) {
+	Bitu pos=0;
+	for (Bitu i=0;i<PIC_CHAIN_BUCKETS;i++) pic_queue.chains[i]=0;
+	for (PICEntry * entry=pic_queue.next_entry;entry;entry=entry->next,pos++) {
+		PICHeapNode node={ entry->index, pic_queue.next_sequence++, entry, entry->pic_event, entry->value };
+		PlaceNode(node,pos);
+		ChainEntry(entry);
+	}
+	pic_queue.size=pos;
+	pic_queue.heaped=true;
+}
+
+static void MakeList(void) {
+	for (Bitu i=1;i<pic_queue.size;i++) {
+		PICHeapNode node=pic_queue.heap[i];
+		Bitu pos=i;
+		for (;pos>0 && NodePrecedes(node,pic_queue.heap[pos-1]);pos--) pic_queue.heap[pos]=pic_queue.heap[pos-1];
+		pic_queue.heap[pos]=node;
+	}
+	pic_queue.next_entry=0;
+	for (Bitu i=pic_queue.size;i-->0;) {
+		PICEntry * entry=pic_queue.heap[i].entry;
+		entry->next=pic_queue.next_entry;
 		pic_queue.next_entry=entry;
-		entry->next=find_entry;
-	} else while (find_entry) {
-		if (find_entry->next) {
-			/* See if the next index comes later than this one */
-			if (find_entry->next->index > entry->index) {
-				entry->next=find_entry->next;
-				find_entry->next=entry;
-				break;
-			} else {
-				find_entry=find_entry->next;
-			}
+	}
+	pic_queue.heaped=false;
+}
+
+static INLINE PIC_EventHandle EntryHandle(const PICEntry * entry) {
+	return ((Bitu)entry->generation << PIC_HANDLE_SLOT_BITS) | (Bitu)(entry-pic_queue.entries);
+}
+
+static INLINE void FreeEntry(PICEntry * entry) {
+	entry->generation++;
+	entry->next=pic_queue.free_entry;
+	pic_queue.free_entry=entry;
+}
+
+/* Takes the entry at pos out of the heap */
+static void RemoveNode(Bitu pos) {
+	PICEntry * entry=pic_queue.heap[pos].entry;
+	PICChainLink & link=ChainLink(entry);
+	if (link.prev) ChainLink(link.prev).next=link.next;
+	else *EventChain(entry->pic_event,entry->value)=link.next;
+	if (link.next) ChainLink(link.next).prev=link.prev;
+	FreeEntry(entry);
+	if (--pic_queue.size!=pos) {
+		PICHeapNode last=pic_queue.heap[pic_queue.size];
+		PlaceNode(last,pos);
+		if (pos>0 && NodePrecedes(last,pic_queue.heap[(pos-1)/2])) SiftUp(pos);
+		else SiftDown(pos);
+	}
+	pic_queue.next_entry=pic_queue.size ? pic_queue.heap[0].entry : 0;
+}
+
+/* Adds the entry to the heap, unless the heap is small enough to go back to being a list */
+static bool AddHeapEntry(PICEntry * entry) GCC_ATTRIBUTE(noinline);
+static bool AddHeapEntry(PICEntry * entry) {
+	if (pic_queue.size<=PIC_LIST_MIN) {
+		MakeList();
+		return false;
+	}
+	PICHeapNode node={ entry->index, pic_queue.next_sequence++, entry, entry->pic_event, entry->value };
+	pic_queue.heap[pic_queue.size]=node;
+	SiftUp(pic_queue.size++);
+	ChainEntry(entry);
+	pic_queue.next_entry=pic_queue.heap[0].entry;
+	return true;
+}
+
+static void AddEntry(PICEntry * entry) {
+	if (GCC_LIKELY(!pic_queue.heaped) || !AddHeapEntry(entry)) {
+		PICEntry * find_entry=pic_queue.next_entry;
+		if (GCC_UNLIKELY(find_entry ==0)) {
+			entry->next=0;
+			pic_queue.next_entry=entry;
+		} else if (find_entry->index>entry->index) {
+			pic_queue.next_entry=entry;
+			entry->next=find_entry;
 		} else {
-			entry->next=find_entry->next;
-			find_entry->next=entry;
-			break;
+			Bitu walked=0;
+			while (find_entry) {
+				if (find_entry->next) {
+					if (find_entry->next->index > entry->index) {
+						entry->next=find_entry->next;
+						find_entry->next=entry;
+						break;
+					} else {
+						find_entry=find_entry->next;
+						walked++;
+					}
+				} else {
+					entry->next=find_entry->next;
+					find_entry->next=entry;
+					break;
+				}
+			}
+			if (GCC_UNLIKELY(walked>=PIC_LIST_MAX)) MakeHeap();
 		}
 	}
+
+	/* Events added while the queue is being run, when the cycles have been handed back
+	   already, can't end them any sooner */
+	if (!CPU_Cycles) return;
 	Bits cycles=PIC_MakeCycles(pic_queue.next_entry->index-PIC_TickIndex());
 	if (cycles<CPU_Cycles) {
 		CPU_CycleLeft+=CPU_Cycles;
@@ -386,10 +566,10 @@ static void AddEntry(PICEntry * entry) {
 static bool InEventService = false;
 static float srv_lag = 0;
 
-void PIC_AddEvent(PIC_EventHandler handler,float delay,Bitu val) {
+PIC_EventHandle PIC_AddEvent(PIC_EventHandler handler,float delay,Bitu val) {
 	if (GCC_UNLIKELY(!pic_queue.free_entry)) {
 		LOG(LOG_PIC,LOG_ERROR)("Event queue full");
-		return;
+		return PIC_NOEVENT;
 	}
 	PICEntry * entry=pic_queue.free_entry;
 	if(InEventService) entry->index = delay + srv_lag;
@@ -399,56 +579,71 @@ void PIC_AddEvent(PIC_EventHandler handler,float delay,Bitu val) {
 	entry->value=val;
 	pic_queue.free_entry=pic_queue.free_entry->next;
 	AddEntry(entry);
+	return EntryHandle(entry);
 }
 
-void PIC_RemoveSpecificEvents(PIC_EventHandler handler, Bitu val) {
+bool PIC_RemoveEvent(PIC_EventHandle handle) {
+	Bitu slot=handle & PIC_HANDLE_SLOT_MASK;
+	if (slot>=PIC_QUEUESIZE) return false;
+	PICEntry * entry=&pic_queue.entries[slot];
+	/* The event has already fired or been removed */
+	if (EntryHandle(entry)!=handle) return false;
+	if (GCC_UNLIKELY(pic_queue.heaped)) {
+		RemoveNode(entry->heap_pos);
+	} else {
+		PICEntry * * link=&pic_queue.next_entry;
+		while (*link!=entry) link=&(*link)->next;
+		*link=entry->next;
+		FreeEntry(entry);
+	}
+	return true;
+}
+
+/* Finds the matching entries before removing any, as removing them reorders the heap */
+static void RemoveMatchingHeapEvents(PIC_EventHandler handler,bool match_value,Bitu val) GCC_ATTRIBUTE(noinline);
+static void RemoveMatchingHeapEvents(PIC_EventHandler handler,bool match_value,Bitu val) {
+	PICEntry * matches[PIC_QUEUESIZE];
+	Bitu count=0;
+	for (Bitu i=0;i<pic_queue.size;i++) {
+		const PICHeapNode & node=pic_queue.heap[i];
+		if (GCC_UNLIKELY(node.pic_event==handler) && (!match_value || node.value==val)) matches[count++]=node.entry;
+	}
+	for (Bitu i=0;i<count;i++) RemoveNode(matches[i]->heap_pos);
+}
+
+static INLINE void RemoveMatchingEvents(PIC_EventHandler handler,bool match_value,Bitu val) {
+	if (GCC_UNLIKELY(pic_queue.heaped)) {
+		RemoveMatchingHeapEvents(handler,match_value,val);
+		return;
+	}
 	PICEntry * entry=pic_queue.next_entry;
-	PICEntry * prev_entry;
-	prev_entry = 0;
+	PICEntry * prev_entry=0;
 	while (entry) {
-		if (GCC_UNLIKELY((entry->pic_event == handler)) && (entry->value == val)) {
-			if (prev_entry) {
-				prev_entry->next=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=prev_entry->next;
-				continue;
-			} else {
-				pic_queue.next_entry=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=pic_queue.next_entry;
-				continue;
-			}
+		PICEntry * next_entry=entry->next;
+		if (GCC_UNLIKELY(entry->pic_event==handler) && (!match_value || entry->value==val)) {
+			if (prev_entry) prev_entry->next=next_entry;
+			else pic_queue.next_entry=next_entry;
+			FreeEntry(entry);
+		} else prev_entry=entry;
+		entry=next_entry;
+	}
+}
+
+void PIC_RemoveSpecificEvents(PIC_EventHandler handler, Bitu val) {
+	if (GCC_UNLIKELY(pic_queue.heaped)) {
+		PICEntry * entry=*EventChain(handler,val);
+		while (entry) {
+			PICEntry * next_entry=ChainLink(entry).next;
+			if (entry->pic_event==handler && entry->value==val) RemoveNode(entry->heap_pos);
+			entry=next_entry;
 		}
-		prev_entry=entry;
-		entry=entry->next;
-	}	
+		return;
+	}
+	RemoveMatchingEvents(handler,true,val);
 }
 
 void PIC_RemoveEvents(PIC_EventHandler handler) {
-	PICEntry * entry=pic_queue.next_entry;
-	PICEntry * prev_entry;
-	prev_entry=0;
-	while (entry) {
-		if (GCC_UNLIKELY(entry->pic_event==handler)) {
-			if (prev_entry) {
-				prev_entry->next=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=prev_entry->next;
-				continue;
-			} else {
-				pic_queue.next_entry=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=pic_queue.next_entry;
-				continue;
-			}
-		}
-		prev_entry=entry;
-		entry=entry->next;
-	}	
+	RemoveMatchingEvents(handler,false,0);
 }
 
 
@@ -464,14 +659,14 @@ bool PIC_RunQueue(void) {
 	InEventService = true;
 	while (pic_queue.next_entry && (pic_queue.next_entry->index*CPU_CycleMax<=index_nd)) {
 		PICEntry * entry=pic_queue.next_entry;
-		pic_queue.next_entry=entry->next;
-
 		srv_lag = entry->index;
+		/* Free the entry before calling the handler, so that its handle is
+		   already stale and the handler can reuse the entry straight away */
+		if (GCC_LIKELY(!pic_queue.heaped)) {
+			pic_queue.next_entry=entry->next;
+			FreeEntry(entry);
+		} else RemoveNode(0);
 		(entry->pic_event)(entry->value); // call the event handler
-
-		/* Put the entry in the free list */
-		entry->next=pic_queue.free_entry;
-		pic_queue.free_entry=entry;
 	}
 	InEventService = false;
 
@@ -489,6 +684,7 @@ bool PIC_RunQueue(void) {
 	if 	(PIC_IRQCheck)	PIC_runIRQs();
 	return true;
 }
+//--End of modifications
 
 /* The TIMER Part */
 struct TickerBlock {
@@ -526,11 +722,20 @@ void TIMER_AddTick(void) {
 	CPU_Cycles=0;
 	PIC_Ticks++;
 	/* Go through the list of scheduled events and lower their index with 1000 */
-	PICEntry * entry=pic_queue.next_entry;
-	while (entry) {
-		entry->index -= 1.0f;
-		entry=entry->next;
+	//--Modified 2026-10-17: lowering every index by the same amount leaves the heap ordered.
+	if (pic_queue.heaped) {
+		for (Bitu i=0;i<pic_queue.size;i++) {
+			pic_queue.heap[i].index -= 1.0f;
+			pic_queue.heap[i].entry->index -= 1.0f;
+		}
+	} else {
+		PICEntry * entry=pic_queue.next_entry;
+		while (entry) {
+			entry->index -= 1.0f;
+			entry=entry->next;
+		}
 	}
+	//--End of modifications
 	/* Call our list of ticker handlers */
 	TickerBlock * ticker=firstticker;
 	while (ticker) {
@@ -594,7 +799,10 @@ public:
 		}
 		pic_queue.entries[PIC_QUEUESIZE-1].next=0;
 		pic_queue.free_entry=&pic_queue.entries[0];
+		//--Added 2026-10-17 for the event heap
 		pic_queue.next_entry=0;
+		pic_queue.heaped=false;
+		//--End of modifications
 	}
 	~PIC(){
 	}
@@ -100,6 +100,9 @@ struct SB_INFO {
 		Bitu bits;
 		DmaChannel * chan;
 		Bitu remain_size;
+		//--Added 2026-10-17 to cancel the transfer's events by handle
+		PIC_EventHandle end_event,silent_event;
+		//--End of modifications
 	} dma;
 	bool speaker;
 	bool midi;
@@ -123,6 +126,9 @@ struct SB_INFO {
 		} in,out;
 		Bit8u test_register;
 		Bitu write_busy;
+		//--Added 2026-10-17 to cancel the reset's event by handle
+		PIC_EventHandle reset_event;
+		//--End of modifications
 	} dsp;
 	struct {
 		Bit16s data[DSP_DACSIZE+1];
@@ -238,7 +244,9 @@ static void DSP_SetSpeaker(bool how) {
 	if (sb.type==SBT_16) return;
 	sb.chan->Enable(how);
 	if (sb.speaker) {
-		PIC_RemoveEvents(DMA_Silent_Event);
+		//--Modified 2026-10-17 to cancel the event by handle
+		PIC_RemoveEvent(sb.dma.silent_event);
+		//--End of modifications
 		CheckDMAEnd();
 	} else {
 		
@@ -503,7 +511,9 @@ static void GenerateDMASound(Bitu size) {
 	}
 	sb.dma.left-=read;
 	if (!sb.dma.left) {
-		PIC_RemoveEvents(END_DMA_Event);
+		//--Modified 2026-10-17 to cancel the event by handle
+		PIC_RemoveEvent(sb.dma.end_event);
+		//--End of modifications
 		if (!sb.dma.autoinit) {
 			LOG(LOG_SB,LOG_NORMAL)("Single cycle transfer ended");
 			sb.mode=MODE_NONE;
@@ -554,7 +564,9 @@ static void DMA_Silent_Event(Bitu val) {
 	if (sb.dma.left) {
 		Bitu bigger=(sb.dma.left > sb.dma.min) ? sb.dma.min : sb.dma.left;
 		float delay=(bigger*1000.0f)/sb.dma.rate;
-		PIC_AddEvent(DMA_Silent_Event,delay,bigger);
+		//--Modified 2026-10-17 to keep the event's handle
+		sb.dma.silent_event=PIC_AddEvent(DMA_Silent_Event,delay,bigger);
+		//--End of modifications
 	}
 
 }
@@ -568,12 +580,20 @@ static void CheckDMAEnd(void) {
 	if (!sb.speaker && sb.type!=SBT_16) {
 		Bitu bigger=(sb.dma.left > sb.dma.min) ? sb.dma.min : sb.dma.left;
 		float delay=(bigger*1000.0f)/sb.dma.rate;
-		PIC_AddEvent(DMA_Silent_Event,delay,bigger);
+		//--Modified 2026-10-17 to keep the event's handle: a transfer only ever needs one
+		//of these pending, so any earlier one is replaced
+		PIC_RemoveEvent(sb.dma.silent_event);
+		sb.dma.silent_event=PIC_AddEvent(DMA_Silent_Event,delay,bigger);
+		//--End of modifications
 		LOG(LOG_SB,LOG_NORMAL)("Silent DMA Transfer scheduling IRQ in %.3f milliseconds",delay);
 	} else if (sb.dma.left<sb.dma.min) {
 		float delay=(sb.dma.left*1000.0f)/sb.dma.rate;
 		LOG(LOG_SB,LOG_NORMAL)("Short transfer scheduling IRQ in %.3f milliseconds",delay);	
-		PIC_AddEvent(END_DMA_Event,delay,sb.dma.left);
+		//--Modified 2026-10-17 to keep the event's handle: a transfer only ever needs one
+		//of these pending, so any earlier one is replaced
+		PIC_RemoveEvent(sb.dma.end_event);
+		sb.dma.end_event=PIC_AddEvent(END_DMA_Event,delay,sb.dma.left);
+		//--End of modifications
 	}
 }
 
@@ -630,7 +650,9 @@ static void DSP_DoDMATransfer(DMA_MODES mode,Bitu freq,bool stereo) {
 	sb.dma.min=(sb.dma.rate*3)/1000;
 	sb.chan->SetFreq(freq);
 	sb.dma.mode=mode;
-	PIC_RemoveEvents(END_DMA_Event);
+	//--Modified 2026-10-17 to cancel the event by handle
+	PIC_RemoveEvent(sb.dma.end_event);
+	//--End of modifications
 	sb.dma.chan->Register_Callback(DSP_DMA_CallBack);
 #if (C_DEBUG)
 	LOG(LOG_SB,LOG_NORMAL)("DMA Transfer:%s %s %s freq %d rate %d size %d",
@@ -703,7 +725,9 @@ static void DSP_Reset(void) {
 	sb.dsp.cmd_len=0;
 	sb.dsp.in.pos=0;
 	sb.dsp.write_busy=0;
-	PIC_RemoveEvents(DSP_FinishReset);
+	//--Modified 2026-10-17 to cancel the event by handle
+	PIC_RemoveEvent(sb.dsp.reset_event);
+	//--End of modifications
 
 	sb.dma.left=0;
 	sb.dma.total=0;
@@ -724,7 +748,9 @@ static void DSP_Reset(void) {
 	sb.irq.pending_16bit=false;
 	sb.chan->SetFreq(22050);
 //	DSP_SetSpeaker(false);
-	PIC_RemoveEvents(END_DMA_Event);
+	//--Modified 2026-10-17 to cancel the event by handle
+	PIC_RemoveEvent(sb.dma.end_event);
+	//--End of modifications
 }
 
 static void DSP_DoReset(Bit8u val) {
@@ -734,8 +760,10 @@ static void DSP_DoReset(Bit8u val) {
 		sb.dsp.state=DSP_S_RESET;
 	} else if (((val&1)==0) && (sb.dsp.state==DSP_S_RESET)) {	// reset off
 		sb.dsp.state=DSP_S_RESET_WAIT;
-		PIC_RemoveEvents(DSP_FinishReset);
-		PIC_AddEvent(DSP_FinishReset,20.0f/1000.0f,0);	// 20 microseconds
+		//--Modified 2026-10-17 to cancel and keep the event by handle
+		PIC_RemoveEvent(sb.dsp.reset_event);
+		sb.dsp.reset_event=PIC_AddEvent(DSP_FinishReset,20.0f/1000.0f,0);	// 20 microseconds
+		//--End of modifications
 	}
 }
 
@@ -901,7 +929,9 @@ static void DSP_DoCommand(void) {
 //		DSP_ChangeMode(MODE_NONE);
 //		Games sometimes already program a new dma before stopping, gives noise
 		sb.mode=MODE_DMA_PAUSE;
-		PIC_RemoveEvents(END_DMA_Event);
+		//--Modified 2026-10-17 to cancel the event by handle
+		PIC_RemoveEvent(sb.dma.end_event);
+		//--End of modifications
 		break;
 	case 0xd1:	/* Enable Speaker */
 		DSP_SetSpeaker(true);
@@ -1558,6 +1588,10 @@ public:
 		sb.dsp.state=DSP_S_NORMAL;
 		sb.dsp.out.lastval=0xaa;
 		sb.dma.chan=NULL;
+		//--Added 2026-10-17 as no events have been scheduled yet
+		sb.dma.end_event=sb.dma.silent_event=PIC_NOEVENT;
+		sb.dsp.reset_event=PIC_NOEVENT;
+		//--End of modifications
 
 		for (i=4;i<=0xf;i++) {
 			if (i==8 || i==9) continue;
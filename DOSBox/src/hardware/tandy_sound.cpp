@@ -108,6 +108,9 @@ static void SN76496Write(Bitu /*port*/,Bitu data,Bitu /*iolen*/) {
 		tandy.chan->Enable(true);
 		tandy.enabled=true;
 	}
+	//--Added 2026-10-17 for sleeping silent channels
+	tandy.chan->WakeUp();
+	//--End of modifications
 
 	/* update the output buffer before changing the registers */
 
@@ -177,11 +180,20 @@ static void SN76496Write(Bitu /*port*/,Bitu data,Bitu /*iolen*/) {
 	}
 }
 
-static void SN76496Update(Bitu length) {
+//--Added 2026-10-17 for sleeping silent channels: moved out of SN76496Update,
+//so that the mixer can also check it while the channel sleeps
+static void SN76496CheckIdle(void) {
 	if ((tandy.last_write+5000)<PIC_Ticks) {
 		tandy.enabled=false;
 		tandy.chan->Enable(false);
 	}
+}
+//--End of modifications
+
+static void SN76496Update(Bitu length) {
+	//--Modified 2026-10-17 for sleeping silent channels: moved to SN76496CheckIdle
+	SN76496CheckIdle();
+	//--End of modifications
 	int i;
 	struct SN76496 *R = &sn;
 	Bit16s * buffer=(Bit16s *)MixTemp;
@@ -516,6 +528,9 @@ public:
 
 		Bit32u sample_rate = section->Get_int("tandyrate");
 		tandy.chan=MixerChan.Install(&SN76496Update,sample_rate,"TANDY");
+		//--Added 2026-10-17 for sleeping silent channels
+		tandy.chan->SetSleepDelay(1000,SN76496CheckIdle);
+		//--End of modifications
 
 		WriteHandler[0].Install(0xc0,SN76496Write,IO_MB,2);
 
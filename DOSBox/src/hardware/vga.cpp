@@ -94,7 +94,9 @@ void VGA_StartResize(Bitu delay /*=50*/) {
 		if (vga.mode==M_ERROR) delay = 5;
 		/* Start a resize after delay (default 50 ms) */
 		if (delay==0) VGA_SetupDrawing(0);
-		else PIC_AddEvent(VGA_SetupDrawing,(float)delay);
+		//--Modified 2026-10-17 to keep the event's handle
+		else vga.draw.events.setup=PIC_AddEvent(VGA_SetupDrawing,(float)delay);
+		//--End of modifications
 	}
 }
 
@@ -176,6 +178,12 @@ void VGA_SetCGA4Table(Bit8u val0,Bit8u val1,Bit8u val2,Bit8u val3) {
 void VGA_Init(Section* sec) {
 //	Section_prop * section=static_cast<Section_prop *>(sec);
 	vga.draw.resizing=false;
+	//--Added 2026-10-17 as no drawing events have been scheduled yet
+	vga.draw.events.setup=vga.draw.events.vertical_timer=PIC_NOEVENT;
+	vga.draw.events.display_start_latch=vga.draw.events.panning_latch=PIC_NOEVENT;
+	vga.draw.events.other_vert_interrupt[0]=vga.draw.events.other_vert_interrupt[1]=PIC_NOEVENT;
+	vga.draw.events.draw=PIC_NOEVENT;
+	//--End of modifications
 	vga.mode=M_ERROR;			//For first init
 	SVGA_Setup_Driver();
 	VGA_SetupMemory(sec);
@@ -26,6 +26,9 @@
 
 void VGA_ATTR_SetPalette(Bit8u index,Bit8u val) {
 	vga.attr.palette[index] = val;
+	//--Added 2026-10-17 for per-cell text rendering
+	vga.draw.cell_changes++;
+	//--End of modifications
 	if (vga.attr.mode_control & 0x80) val = (val&0xf) | (vga.attr.color_select << 4);
 	val &= 63;
 	val |= (vga.attr.color_select & 0xc) << 4;
@@ -246,7 +246,9 @@ void vga_write_p3d5(Bitu port,Bitu val,Bitu iolen) {
 			if (abs((Bits)val-(Bits)crtc(vertical_display_end))<3) {
 				// delay small vde changes a bit to avoid screen resizing
 				// if they are reverted in a short timeframe
-				PIC_RemoveEvents(VGA_SetupDrawing);
+				//--Modified 2026-10-17 to cancel the event by handle
+				PIC_RemoveEvent(vga.draw.events.setup);
+				//--End of modifications
 				vga.draw.resizing=false;
 				crtc(vertical_display_end)=val;
 				VGA_StartResize(150);
@@ -21,12 +21,18 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+//--Added 2026-10-17 for per-cell text rendering
+#include <vector>
+//--End of modifications
 #include "dosbox.h"
 #include "video.h"
 #include "render.h"
 #include "../gui/render_scalers.h"
 #include "vga.h"
 #include "pic.h"
+//--Added 2026-10-17 for vectorised pixel expansion
+#include "vga_draw_simd.h"
+//--End of modifications
 
 //--Added 2011-04-18 by Alun Bestor to fix endianness issues in Tandy/CGA line-printing
 #import <CoreFoundation/CFByteOrder.h>
@@ -56,12 +62,9 @@ static Bit8u * VGA_Draw_1BPP_Line(Bitu vidstart, Bitu line) {
 
 static Bit8u * VGA_Draw_2BPP_Line(Bitu vidstart, Bitu line) {
 	const Bit8u *base = vga.tandy.draw_base + ((line & vga.tandy.line_mask) << vga.tandy.line_shift);
-	Bit32u * draw=(Bit32u *)TempLine;
-	for (Bitu x=0;x<vga.draw.blocks;x++) {
-		Bitu val = base[vidstart & vga.tandy.addr_mask];
-		vidstart++;
-		*draw++=CGA_4_Table[val];
-	}
+	//--Modified 2026-10-17 for vectorised pixel expansion
+	VGA_Expand2BPP((Bit32u *)TempLine, base, vidstart, vga.tandy.addr_mask, vga.draw.blocks);
+	//--End of modifications
 	return TempLine;
 }
 
@@ -125,66 +128,36 @@ static Bit8u * VGA_Draw_CGA16_Line(Bitu vidstart, Bitu line) {
 
 static Bit8u * VGA_Draw_4BPP_Line(Bitu vidstart, Bitu line) {
 	const Bit8u *base = vga.tandy.draw_base + ((line & vga.tandy.line_mask) << vga.tandy.line_shift);
-	Bit32u * draw=(Bit32u *)TempLine;
-	for (Bitu x=0;x<vga.draw.blocks;x++) {
-		Bitu val1 = base[vidstart & vga.tandy.addr_mask];
-		++vidstart;
-		Bitu val2 = base[vidstart & vga.tandy.addr_mask];
-		++vidstart;
-		
-		//--Modified 2011-04-19 by Alun Bestor to fix swapped pixel columns on PowerPC Macs
-		*draw++=CFSwapInt32HostToLittle((val1 & 0x0f) << 8  |
-				(val1 & 0xf0) >> 4  |
-				(val2 & 0x0f) << 24 |
-				(val2 & 0xf0) << 12);
-		//--End of modifications
-	}
+	//--Modified 2026-10-17 for vectorised pixel expansion
+	VGA_Expand4BPP((Bit32u *)TempLine, base, vidstart, vga.tandy.addr_mask, vga.draw.blocks);
+	//--End of modifications
 	return TempLine;
 }
 
 static Bit8u * VGA_Draw_4BPP_Line_Double(Bitu vidstart, Bitu line) {
 	const Bit8u *base = vga.tandy.draw_base + ((line & vga.tandy.line_mask) << vga.tandy.line_shift);
-	Bit32u * draw=(Bit32u *)TempLine;
-	for (Bitu x=0;x<vga.draw.blocks;x++) {
-		Bitu val = base[vidstart & vga.tandy.addr_mask];
-		++vidstart;
-		
-		//--Modified 2011-04-19 by Alun Bestor to fix swapped pixel columns on PowerPC Macs
-		*draw++=CFSwapInt32HostToLittle((val & 0xf0) >> 4  |
-				(val & 0xf0) << 4  |
-				(val & 0x0f) << 16 |
-				(val & 0x0f) << 24);
-		//--End of modifications
-	}
+	//--Modified 2026-10-17 for vectorised pixel expansion
+	VGA_Expand4BPPDouble((Bit32u *)TempLine, base, vidstart, vga.tandy.addr_mask, vga.draw.blocks);
+	//--End of modifications
 	return TempLine;
 }
 
 #ifdef VGA_KEEP_CHANGES
-static Bit8u * VGA_Draw_Changes_Line(Bitu vidstart, Bitu line) {
-	Bitu checkMask = vga.changes.checkMask;
-	Bit8u *map = vga.changes.map;
-	Bitu start = (vidstart >> VGA_CHANGE_SHIFT);
-	Bitu end = ((vidstart + vga.draw.line_length ) >> VGA_CHANGE_SHIFT);
-	for (; start <= end;start++) {
-		if ( map[start] & checkMask ) {
-			Bitu offset = vidstart & vga.draw.linear_mask;
-			if(vga.draw.linear_mask-offset < vga.draw.line_length)
-				memcpy(vga.draw.linear_base+vga.draw.linear_mask+1, vga.draw.linear_base, vga.draw.line_length);
-			Bit8u *ret = &vga.draw.linear_base[ offset ];
-#if !defined(C_UNALIGNED_MEMORY)
-			if (GCC_UNLIKELY( ((Bitu)ret) & (sizeof(Bitu)-1)) ) {
-				memcpy( TempLine, ret, vga.draw.line_length );
-				return TempLine;
-			}
-#endif
-			return ret;
-		}
+//--Modified 2026-10-17 for VRAM write tracking: rather than drawing the line when it has changed,
+//this just says whether any of the memory it's drawn from was written since it was last drawn.
+static INLINE bool VGA_Changes_Line(Bitu vidstart) {
+	const Bit32u *map = vga.changes.map;
+	Bit32u checkFrame = vga.changes.checkFrame;
+	Bitu wrap = vga.draw.linear_mask >> VGA_CHANGE_SHIFT;
+	Bitu start = vidstart & vga.draw.linear_mask;
+	Bitu end = (start + vga.draw.line_length - 1) >> VGA_CHANGE_SHIFT;
+	for (start >>= VGA_CHANGE_SHIFT; start <= end; start++) {
+		if (map[start & wrap] >= checkFrame)
+			return true;
 	}
-//	memset( TempLine, 0x30, vga.changes.lineWidth );
-//	return TempLine;
-	return 0;
+	return false;
 }
-
+//--End of modifications
 #endif
 
 static Bit8u * VGA_Draw_Linear_Line(Bitu vidstart, Bitu /*line*/) {
@@ -375,32 +348,130 @@ static const Bit8u* VGA_Text_Memwrap(Bitu vidstart) {
 }
 
 static Bit32u FontMask[2]={0xffffffff,0x0};
+
+//--Added 2026-10-17 for per-cell text rendering
+/* The text line handlers keep the last line they drew at each scanline of the display,
+   along with the character, attribute and blink state each cell of it was drawn from,
+   and only redraw the cells where those have changed. Palette, font and text table
+   changes count up vga.draw.cell_changes, and a scanline drawn before the last of them
+   is redrawn in full, even when they happen in the middle of a frame. Everything else
+   that affects how a cell looks is compared once a frame by VGA_TEXT_CheckCells, which
+   has every cell redrawn if any of it changed. The cell the cursor was drawn over is
+   always redrawn on the next frame. */
+#define TEXT_CELL_DIRTY 0xffffffff
+#define TEXT_CELL(_CHR,_COL) ((_CHR) | ((_COL) << 8) | ((FontMask[(_COL) >> 7] & 1) << 16))
+#define TEXT_CELL_PITCH 18
+static struct {
+	std::vector<Bit8u> lines;
+	std::vector<Bit32u> cells;
+	std::vector<Bitu> glyphLines;
+	std::vector<Bitu> changeLines;
+	std::vector<Bit32u> scratch;
+	Bitu blocks, height;
+	VGA_Line_Handler drawLine;
+	Bit8u fonts[2][256*32];
+	Bit8u modeControl, underline;
+} textCells;
+
+static void VGA_TEXT_ClearCells(void) {
+	std::fill(textCells.cells.begin(), textCells.cells.end(), TEXT_CELL_DIRTY);
+	std::fill(textCells.glyphLines.begin(), textCells.glyphLines.end(), ~(Bitu)0);
+}
+
+/* Called at the start of each text mode frame: resizes the scanlines for the current
+   mode, and marks them all for redrawing if anything but the text itself has changed. */
+static void VGA_TEXT_CheckCells(void) {
+	Bitu blocks = vga.draw.blocks, height = vga.draw.lines_total;
+	bool changed = false;
+	if (blocks != textCells.blocks || height != textCells.height) {
+		textCells.blocks = blocks;
+		textCells.height = height;
+		textCells.lines.resize(blocks * height * TEXT_CELL_PITCH);
+		textCells.cells.resize(blocks * height);
+		textCells.glyphLines.resize(height);
+		textCells.changeLines.resize(height);
+		textCells.scratch.resize(blocks);
+		changed = true;
+	}
+	for (Bitu i = 0; i < 2; i++) {
+		if (!vga.draw.font_tables[i]) continue;
+		if (memcmp(textCells.fonts[i], vga.draw.font_tables[i], sizeof(textCells.fonts[i]))) {
+			memcpy(textCells.fonts[i], vga.draw.font_tables[i], sizeof(textCells.fonts[i]));
+			changed = true;
+		}
+	}
+	if (textCells.drawLine != VGA_DrawLine ||
+		textCells.modeControl != vga.attr.mode_control ||
+		textCells.underline != vga.crtc.underline_location) {
+		textCells.drawLine = VGA_DrawLine;
+		textCells.modeControl = vga.attr.mode_control;
+		textCells.underline = vga.crtc.underline_location;
+		changed = true;
+	}
+	if (changed) VGA_TEXT_ClearCells();
+}
+
+/* Returns where to draw the current scanline and the cells it was last drawn from.
+   Lines outside the display, like those past a mid-frame mode change, are drawn in
+   full into TempLine instead. */
+static Bit8u * VGA_TEXT_CellLine(Bitu line, Bit32u ** cells) {
+	Bitu index = vga.draw.lines_done;
+	if (GCC_UNLIKELY(index >= textCells.height || vga.draw.blocks != textCells.blocks)) {
+		std::fill(textCells.scratch.begin(), textCells.scratch.end(), TEXT_CELL_DIRTY);
+		textCells.scratch.resize(vga.draw.blocks, TEXT_CELL_DIRTY);
+		*cells = &textCells.scratch[0];
+		return TempLine;
+	}
+	*cells = &textCells.cells[index * textCells.blocks];
+	if (textCells.glyphLines[index] != line || textCells.changeLines[index] != vga.draw.cell_changes) {
+		std::fill(*cells, *cells + textCells.blocks, TEXT_CELL_DIRTY);
+		textCells.glyphLines[index] = line;
+		textCells.changeLines[index] = vga.draw.cell_changes;
+	}
+	return &textCells.lines[index * textCells.blocks * TEXT_CELL_PITCH];
+}
+
+/* Marks a scanline to be redrawn in full next time, after it was drawn without its cells. */
+static void VGA_TEXT_DirtyLine(void) {
+	if (vga.draw.lines_done < textCells.height)
+		textCells.glyphLines[vga.draw.lines_done] = ~(Bitu)0;
+}
+//--End of modifications
+
 static Bit8u * VGA_TEXT_Draw_Line(Bitu vidstart, Bitu line) {
 	Bits font_addr;
-	Bit32u * draw=(Bit32u *)TempLine;
+	//--Modified 2026-10-17 for per-cell text rendering
+	Bit32u * cells;
+	Bit8u * out=VGA_TEXT_CellLine(line, &cells);
+	Bit32u * draw=(Bit32u *)out;
 	const Bit8u* vidmem = VGA_Text_Memwrap(vidstart);
-	for (Bitu cx=0;cx<vga.draw.blocks;cx++) {
+	for (Bitu cx=0;cx<vga.draw.blocks;cx++,draw+=2) {
 		Bitu chr=vidmem[cx*2];
 		Bitu col=vidmem[cx*2+1];
+		Bit32u cell=TEXT_CELL(chr,col);
+		if (cells[cx]==cell) continue;
+		cells[cx]=cell;
 		Bitu font=vga.draw.font_tables[(col >> 3)&1][chr*32+line];
 		Bit32u mask1=TXT_Font_Table[font>>4] & FontMask[col >> 7];
 		Bit32u mask2=TXT_Font_Table[font&0xf] & FontMask[col >> 7];
 		Bit32u fg=TXT_FG_Table[col&0xf];
 		Bit32u bg=TXT_BG_Table[col>>4];
-		*draw++=(fg&mask1) | (bg&~mask1);
-		*draw++=(fg&mask2) | (bg&~mask2);
+		draw[0]=(fg&mask1) | (bg&~mask1);
+		draw[1]=(fg&mask2) | (bg&~mask2);
 	}
 	if (!vga.draw.cursor.enabled || !(vga.draw.cursor.count&0x8)) goto skip_cursor;
 	font_addr = (vga.draw.cursor.address-vidstart) >> 1;
 	if (font_addr>=0 && font_addr<(Bits)vga.draw.blocks) {
 		if (line<vga.draw.cursor.sline) goto skip_cursor;
 		if (line>vga.draw.cursor.eline) goto skip_cursor;
-		draw=(Bit32u *)&TempLine[font_addr*8];
+		draw=(Bit32u *)&out[font_addr*8];
 		Bit32u att=TXT_FG_Table[vga.tandy.draw_base[vga.draw.cursor.address+1]&0xf];
 		*draw++=att;*draw++=att;
+		cells[font_addr]=TEXT_CELL_DIRTY;
 	}
 skip_cursor:
-	return TempLine;
+	return out;
+	//--End of modifications
 }
 
 static Bit8u * VGA_TEXT_Herc_Draw_Line(Bitu vidstart, Bitu line) {
@@ -560,57 +631,97 @@ skip_cursor:
 
 static Bit8u * VGA_TEXT_Xlat16_Draw_Line_9(Bitu vidstart, Bitu line) {
 	Bits font_addr;
-	Bit16u * draw=(Bit16u *)TempLine;
 	bool underline=(Bitu)(vga.crtc.underline_location&0x1f)==line;
 	Bit8u pel_pan=(Bit8u)vga.draw.panning;
 	if ((vga.attr.mode_control&0x20) && (vga.draw.lines_done>=vga.draw.split_line)) pel_pan=0;
 	const Bit8u* vidmem = VGA_Text_Memwrap(vidstart);
-	Bit8u chr=vidmem[0];
-	Bit8u col=vidmem[1];
-	Bit8u font=(vga.draw.font_tables[(col >> 3)&1][chr*32+line])<<pel_pan;
-	if (underline && ((col&0x07) == 0x01)) font=0xff;
-	Bit8u fg=col&0xf;
-	Bit8u bg=(Bit8u)(TXT_BG_Table[col>>4]&0xff);
-	Bitu draw_blocks=vga.draw.blocks;
-	draw_blocks++;
-	for (Bitu cx=1;cx<draw_blocks;cx++) {
-		if (pel_pan) {
-			chr=vidmem[cx*2];
-			col=vidmem[cx*2+1];
-			if (underline && ((col&0x07) == 0x01)) font|=0xff>>(8-pel_pan);
-			else font|=vga.draw.font_tables[(col >> 3)&1][chr*32+line]>>(8-pel_pan);
-			fg=col&0xf;
-			bg=(Bit8u)(TXT_BG_Table[col>>4]&0xff);
-		} else {
-			chr=vidmem[(cx-1)*2];
-			col=vidmem[(cx-1)*2+1];
+	//--Modified 2026-10-17 for per-cell text rendering: without panning each cell
+	//is drawn from one character, so only changed cells need drawing.
+	//Panned lines straddle two characters a cell and are drawn in full as before.
+	Bit32u * cells=0;
+	Bit8u * out;
+	Bit8u fg,bg;
+	if (!pel_pan) {
+		out=VGA_TEXT_CellLine(line, &cells);
+		for (Bitu cx=0;cx<vga.draw.blocks;cx++) {
+			Bit8u chr=vidmem[cx*2];
+			Bit8u col=vidmem[cx*2+1];
+			Bit32u cell=TEXT_CELL(chr,col);
+			if (cells[cx]==cell) continue;
+			cells[cx]=cell;
+			Bit16u * draw=(Bit16u *)&out[cx*18];
+			Bit8u font;
 			if (underline && ((col&0x07) == 0x01)) font=0xff;
 			else font=vga.draw.font_tables[(col >> 3)&1][chr*32+line];
 			fg=col&0xf;
 			bg=(Bit8u)(TXT_BG_Table[col>>4]&0xff);
+			if (FontMask[col>>7]==0) font=0;
+			Bit8u mask=0x80;
+			for (int i = 0; i < 7; i++) {
+				*draw++=vga.dac.xlat16[font&mask?fg:bg];
+				mask>>=1;
+			}
+			Bit16u lastval=vga.dac.xlat16[font&mask?fg:bg];
+			*draw++=lastval;
+			*draw++=(((vga.attr.mode_control&0x04) && ((chr<0xc0) || (chr>0xdf))) && 
+				!(underline && ((col&0x07) == 0x01))) ? 
+				(vga.dac.xlat16[bg]) : lastval;
 		}
-		if (FontMask[col>>7]==0) font=0;
-		Bit8u mask=0x80;
-		for (int i = 0; i < 7; i++) {
-			*draw++=vga.dac.xlat16[font&mask?fg:bg];
-			mask>>=1;
-		}
-		Bit16u lastval=vga.dac.xlat16[font&mask?fg:bg];
-		*draw++=lastval;
-		*draw++=(((vga.attr.mode_control&0x04) && ((chr<0xc0) || (chr>0xdf))) && 
-			!(underline && ((col&0x07) == 0x01))) ? 
-			(vga.dac.xlat16[bg]) : lastval;
-		if (pel_pan) {
-			if (underline && ((col&0x07) == 0x01)) font=0xff;
-			else font=(vga.draw.font_tables[(col >> 3)&1][chr*32+line])<<pel_pan;
+	} else {
+		VGA_TEXT_DirtyLine();
+		out=TempLine;
+		Bit16u * draw=(Bit16u *)TempLine;
+		Bit8u chr=vidmem[0];
+		Bit8u col=vidmem[1];
+		Bit8u font=(vga.draw.font_tables[(col >> 3)&1][chr*32+line])<<pel_pan;
+		if (underline && ((col&0x07) == 0x01)) font=0xff;
+		fg=col&0xf;
+		bg=(Bit8u)(TXT_BG_Table[col>>4]&0xff);
+		Bitu draw_blocks=vga.draw.blocks;
+		draw_blocks++;
+		for (Bitu cx=1;cx<draw_blocks;cx++) {
+			if (pel_pan) {
+				chr=vidmem[cx*2];
+				col=vidmem[cx*2+1];
+				if (underline && ((col&0x07) == 0x01)) font|=0xff>>(8-pel_pan);
+				else font|=vga.draw.font_tables[(col >> 3)&1][chr*32+line]>>(8-pel_pan);
+				fg=col&0xf;
+				bg=(Bit8u)(TXT_BG_Table[col>>4]&0xff);
+			} else {
+				chr=vidmem[(cx-1)*2];
+				col=vidmem[(cx-1)*2+1];
+				if (underline && ((col&0x07) == 0x01)) font=0xff;
+				else font=vga.draw.font_tables[(col >> 3)&1][chr*32+line];
+				fg=col&0xf;
+				bg=(Bit8u)(TXT_BG_Table[col>>4]&0xff);
+			}
+			if (FontMask[col>>7]==0) font=0;
+			Bit8u mask=0x80;
+			for (int i = 0; i < 7; i++) {
+				*draw++=vga.dac.xlat16[font&mask?fg:bg];
+				mask>>=1;
+			}
+			Bit16u lastval=vga.dac.xlat16[font&mask?fg:bg];
+			*draw++=lastval;
+			*draw++=(((vga.attr.mode_control&0x04) && ((chr<0xc0) || (chr>0xdf))) && 
+				!(underline && ((col&0x07) == 0x01))) ? 
+				(vga.dac.xlat16[bg]) : lastval;
+			if (pel_pan) {
+				if (underline && ((col&0x07) == 0x01)) font=0xff;
+				else font=(vga.draw.font_tables[(col >> 3)&1][chr*32+line])<<pel_pan;
+			}
 		}
 	}
+	//--End of modifications
 	if (!vga.draw.cursor.enabled || !(vga.draw.cursor.count&0x8)) goto skip_cursor;
 	font_addr = (vga.draw.cursor.address-vidstart) >> 1;
 	if (font_addr>=0 && font_addr<(Bits)vga.draw.blocks) {
 		if (line<vga.draw.cursor.sline) goto skip_cursor;
 		if (line>vga.draw.cursor.eline) goto skip_cursor;
-		draw=(Bit16u*)&TempLine[font_addr*18];
+		//--Modified 2026-10-17 for per-cell text rendering
+		Bit16u * draw=(Bit16u*)&out[font_addr*18];
+		if (cells) cells[font_addr]=TEXT_CELL_DIRTY;
+		//--End of modifications
 		fg=vga.tandy.draw_base[vga.draw.cursor.address+1]&0xf;
 		for(int i = 0; i < 8; i++) {
 			*draw++ = vga.dac.xlat16[fg];
@@ -619,24 +730,18 @@ static Bit8u * VGA_TEXT_Xlat16_Draw_Line_9(Bitu vidstart, Bitu line) {
 		//	*draw = vga.dac.xlat16[fg];
 	}
 skip_cursor:
-	return TempLine;
+	//--Modified 2026-10-17 for per-cell text rendering
+	return out;
+	//--End of modifications
 }
 
 #ifdef VGA_KEEP_CHANGES
+//--Modified 2026-10-17 for VRAM write tracking: every line has now been drawn or skipped,
+//so the next frame only needs the lines written since this one started
 static INLINE void VGA_ChangesEnd(void ) {
-	if ( vga.changes.active ) {
-//		vga.changes.active = false;
-		Bitu end = vga.draw.address >> VGA_CHANGE_SHIFT;
-		Bitu total = 4 + end - vga.changes.start;
-		Bit32u clearMask = vga.changes.clearMask;
-		total >>= 2;
-		Bit32u *clear = (Bit32u *)&vga.changes.map[  vga.changes.start & ~3 ];
-		while ( total-- ) {
-			clear[0] &= clearMask;
-			clear++;
-		}
-	}
+	vga.changes.drawnFrame = vga.changes.frame;
 }
+//--End of modifications
 #endif
 
 
@@ -658,6 +763,14 @@ static void VGA_DrawSingleLine(Bitu /*blah*/) {
 		// draw blanked line (DoWhackaDo, Alien Carnage, TV sports Football)
 		memset(TempLine, 0, sizeof(TempLine));
 		RENDER_DrawLine(TempLine);
+	//--Added 2026-10-17 for VRAM write tracking: blanked lines need drawing again once unblanked,
+	//the others only if they were written to
+#ifdef VGA_KEEP_CHANGES
+		vga.changes.redraw = true;
+	} else if (vga.changes.active && !VGA_Changes_Line(vga.draw.address)) {
+		RENDER_DrawLine(0);
+#endif
+	//--End of modifications
 	} else {
 		Bit8u * data=VGA_DrawLine( vga.draw.address, vga.draw.address_line );	
 		RENDER_DrawLine(data);
@@ -671,33 +784,49 @@ static void VGA_DrawSingleLine(Bitu /*blah*/) {
 	vga.draw.lines_done++;
 	if (vga.draw.split_line==vga.draw.lines_done) VGA_ProcessSplit();
 	if (vga.draw.lines_done < vga.draw.lines_total) {
-		PIC_AddEvent(VGA_DrawSingleLine,(float)vga.draw.delay.htotal);
-	} else RENDER_EndUpdate(false);
+		//--Modified 2026-10-17 to keep the event's handle
+		vga.draw.events.draw=PIC_AddEvent(VGA_DrawSingleLine,(float)vga.draw.delay.htotal);
+		//--End of modifications
+	//--Modified 2026-10-17 for VRAM write tracking
+	} else {
+#ifdef VGA_KEEP_CHANGES
+		VGA_ChangesEnd();
+#endif
+		RENDER_EndUpdate(false);
+	}
+	//--End of modifications
 }
 
 static void VGA_DrawPart(Bitu lines) {
 	while (lines--) {
-		Bit8u * data=VGA_DrawLine( vga.draw.address, vga.draw.address_line );
-		RENDER_DrawLine(data);
+		//--Modified 2026-10-17 for VRAM write tracking: lines that weren't written to skip
+		//both drawing and the renderer's comparison with what it drew last time
+#ifdef VGA_KEEP_CHANGES
+		if (vga.changes.active && !VGA_Changes_Line(vga.draw.address)) {
+			RENDER_DrawLine(0);
+		} else
+#endif
+		{
+			Bit8u * data=VGA_DrawLine( vga.draw.address, vga.draw.address_line );
+			RENDER_DrawLine(data);
+		}
+		//--End of modifications
 		vga.draw.address_line++;
 		if (vga.draw.address_line>=vga.draw.address_line_total) {
 			vga.draw.address_line=0;
 			vga.draw.address+=vga.draw.address_add;
 		}
 		vga.draw.lines_done++;
-		if (vga.draw.split_line==vga.draw.lines_done) {
-#ifdef VGA_KEEP_CHANGES
-			VGA_ChangesEnd( );
-#endif
-			VGA_ProcessSplit();
-#ifdef VGA_KEEP_CHANGES
-			vga.changes.start = vga.draw.address >> VGA_CHANGE_SHIFT;
-#endif
-		}
+		//--Modified 2026-10-17 for VRAM write tracking: the lines after the split are checked
+		//the same way, so there is no need to end the changes here
+		if (vga.draw.split_line==vga.draw.lines_done) VGA_ProcessSplit();
+		//--End of modifications
 	}
 	if (--vga.draw.parts_left) {
-		PIC_AddEvent(VGA_DrawPart,(float)vga.draw.delay.parts,
+		//--Modified 2026-10-17 to keep the event's handle
+		vga.draw.events.draw=PIC_AddEvent(VGA_DrawPart,(float)vga.draw.delay.parts,
 			 (vga.draw.parts_left!=1) ? vga.draw.parts_lines  : (vga.draw.lines_total - vga.draw.lines_done));
+		//--End of modifications
 	} else {
 #ifdef VGA_KEEP_CHANGES
 		VGA_ChangesEnd();
@@ -719,29 +848,52 @@ void VGA_SetBlinking(Bitu enabled) {
 		vga.tandy.mode_control&=~0x20;
 	}
 	for (Bitu i=0;i<8;i++) TXT_BG_Table[i+8]=(b+i) | ((b+i) << 8)| ((b+i) <<16) | ((b+i) << 24);
+	//--Added 2026-10-17 for per-cell text rendering
+	vga.draw.cell_changes++;
+	//--End of modifications
 }
 
 #ifdef VGA_KEEP_CHANGES
+//--Modified 2026-10-17 for VRAM write tracking
+/* Whether every write that can change what this mode draws gets marked: only the page handlers
+   write to fastmem, and they all mark what they write. Writes to video memory are only marked
+   in fastmem's offsets by the chained handler, and not at all through the mapped handlers. */
+static bool VGA_ChangesTracked(void) {
+	if (VGA_DrawLine != VGA_Draw_Linear_Line && VGA_DrawLine != VGA_Draw_Xlat16_Linear_Line)
+		return false;
+	if (vga.draw.linear_base == vga.fastmem)
+		return true;
+	if (vga.config.chained && vga.config.compatible_chain4)
+		return false;
+#ifdef VGA_LFB_MAPPED
+	return (vga.mode == M_VGA) && !vga.config.chained;
+#else
+	return true;
+#endif
+}
+
+/* Decides whether this frame can skip the lines that weren't written since the last frame
+   drawn completely: not if the renderer wants every line, or if anything else changed
+   which memory the lines are drawn from or how they look. */
 static void INLINE VGA_ChangesStart( void ) {
-	vga.changes.start = vga.draw.address >> VGA_CHANGE_SHIFT;
-	vga.changes.last = vga.changes.start;
-	if ( vga.changes.lastAddress != vga.draw.address ) {
-//		LOG_MSG("Address");
-		VGA_DrawLine = VGA_Draw_Linear_Line;
-		vga.changes.lastAddress = vga.draw.address;
-	} else if ( render.fullFrame ) {
-//		LOG_MSG("Full Frame");
-		VGA_DrawLine = VGA_Draw_Linear_Line;
-	} else {
-//		LOG_MSG("Changes");
-		VGA_DrawLine = VGA_Draw_Changes_Line;
-	}
-	vga.changes.active = true;
-	vga.changes.checkMask = vga.changes.writeMask;
-	vga.changes.clearMask = ~( 0x01010101 << (vga.changes.frame & 7));
+	bool redraw = vga.changes.redraw || render.fullFrame || !VGA_ChangesTracked() ||
+		(vga.changes.lastAddress != vga.draw.address) ||
+		(vga.changes.lastAddressLine != vga.draw.address_line) ||
+		(vga.changes.lastAddressAdd != vga.draw.address_add) ||
+		(vga.changes.lastSplit != vga.draw.split_line) ||
+		(vga.changes.lastMask != vga.draw.linear_mask);
+	vga.changes.redraw = false;
+	vga.changes.lastAddress = vga.draw.address;
+	vga.changes.lastAddressLine = vga.draw.address_line;
+	vga.changes.lastAddressAdd = vga.draw.address_add;
+	vga.changes.lastSplit = vga.draw.split_line;
+	vga.changes.lastMask = vga.draw.linear_mask;
+
+	vga.changes.active = !redraw;
+	vga.changes.checkFrame = vga.changes.drawnFrame;
 	vga.changes.frame++;
-	vga.changes.writeMask = 1 << (vga.changes.frame & 7);
 }
+//--End of modifications
 #endif
 
 static void VGA_VertInterrupt(Bitu /*val*/) {
@@ -767,15 +919,19 @@ static void VGA_PanningLatch(Bitu /*val*/) {
 
 static void VGA_VerticalTimer(Bitu /*val*/) {
 	vga.draw.delay.framestart = PIC_FullIndex();
-	PIC_AddEvent( VGA_VerticalTimer, (float)vga.draw.delay.vtotal );
+	//--Modified 2026-10-17 to keep the events' handles
+	vga.draw.events.vertical_timer=PIC_AddEvent( VGA_VerticalTimer, (float)vga.draw.delay.vtotal );
+	//--End of modifications
 	
 	switch(machine) {
 	case MCH_PCJR:
 	case MCH_TANDY:
 		// PCJr: Vsync is directly connected to the IRQ controller
 		// Some earlier Tandy models are said to have a vsync interrupt too
-		PIC_AddEvent(VGA_Other_VertInterrupt, (float)vga.draw.delay.vrstart, 1);
-		PIC_AddEvent(VGA_Other_VertInterrupt, (float)vga.draw.delay.vrend, 0);
+		//--Modified 2026-10-17 to keep the events' handles
+		vga.draw.events.other_vert_interrupt[1]=PIC_AddEvent(VGA_Other_VertInterrupt, (float)vga.draw.delay.vrstart, 1);
+		vga.draw.events.other_vert_interrupt[0]=PIC_AddEvent(VGA_Other_VertInterrupt, (float)vga.draw.delay.vrend, 0);
+		//--End of modifications
 		// fall-through
 	case MCH_CGA:
 	case MCH_HERC:
@@ -785,8 +941,10 @@ static void VGA_VerticalTimer(Bitu /*val*/) {
 		break;
 	case MCH_VGA:
 	case MCH_EGA:
-		PIC_AddEvent(VGA_DisplayStartLatch, (float)vga.draw.delay.vrstart);
-		PIC_AddEvent(VGA_PanningLatch, (float)vga.draw.delay.vrend);
+		//--Modified 2026-10-17 to keep the events' handles
+		vga.draw.events.display_start_latch=PIC_AddEvent(VGA_DisplayStartLatch, (float)vga.draw.delay.vrstart);
+		vga.draw.events.panning_latch=PIC_AddEvent(VGA_PanningLatch, (float)vga.draw.delay.vrend);
+		//--End of modifications
 		// EGA: 82c435 datasheet: interrupt happens at display end
 		// VGA: checked with scope; however disabled by default by jumper on VGA boards
 		// add a little amount of time to make sure the last drawpart has already fired
@@ -864,6 +1022,9 @@ static void VGA_VerticalTimer(Bitu /*val*/) {
 		/* check for blinking and blinking change delay */
 		FontMask[1]=(vga.draw.blinking & (vga.draw.cursor.count >> 4)) ?
 			0 : 0xffffffff;
+		//--Added 2026-10-17 for per-cell text rendering
+		VGA_TEXT_CheckCells();
+		//--End of modifications
 		break;
 	case M_HERC_GFX:
 		break;
@@ -880,6 +1041,9 @@ static void VGA_VerticalTimer(Bitu /*val*/) {
 	if (GCC_UNLIKELY(vga.draw.split_line==0)) VGA_ProcessSplit();
 #ifdef VGA_KEEP_CHANGES
 	if (startaddr_changed) VGA_ChangesStart();
+	//--Added 2026-10-17 for VRAM write tracking
+	else vga.changes.active = false;
+	//--End of modifications
 #endif
 
 	// check if some lines at the top off the screen are blanked
@@ -894,22 +1058,30 @@ static void VGA_VerticalTimer(Bitu /*val*/) {
 	case PART:
 		if (GCC_UNLIKELY(vga.draw.parts_left)) {
 			LOG(LOG_VGAMISC,LOG_NORMAL)( "Parts left: %d", vga.draw.parts_left );
-			PIC_RemoveEvents(VGA_DrawPart);
+			//--Modified 2026-10-17 to cancel the event by handle
+			PIC_RemoveEvent(vga.draw.events.draw);
+			//--End of modifications
 			RENDER_EndUpdate(true);
 		}
 		vga.draw.lines_done = 0;
 		vga.draw.parts_left = vga.draw.parts_total;
-		PIC_AddEvent(VGA_DrawPart,(float)vga.draw.delay.parts + draw_skip,vga.draw.parts_lines);
+		//--Modified 2026-10-17 to keep the event's handle
+		vga.draw.events.draw=PIC_AddEvent(VGA_DrawPart,(float)vga.draw.delay.parts + draw_skip,vga.draw.parts_lines);
+		//--End of modifications
 		break;
 	case LINE:
 		if (GCC_UNLIKELY(vga.draw.lines_done < vga.draw.lines_total)) {
 			LOG(LOG_VGAMISC,LOG_NORMAL)( "Lines left: %d", 
 				vga.draw.lines_total-vga.draw.lines_done);
-			PIC_RemoveEvents(VGA_DrawSingleLine);
+			//--Modified 2026-10-17 to cancel the event by handle
+			PIC_RemoveEvent(vga.draw.events.draw);
+			//--End of modifications
 			RENDER_EndUpdate(true);
 		}
 		vga.draw.lines_done = 0;
-		PIC_AddEvent(VGA_DrawSingleLine,(float)(vga.draw.delay.htotal/4.0 + draw_skip));
+		//--Modified 2026-10-17 to keep the event's handle
+		vga.draw.events.draw=PIC_AddEvent(VGA_DrawSingleLine,(float)(vga.draw.delay.htotal/4.0 + draw_skip));
+		//--End of modifications
 		break;
 	//case EGALINE:
 	}
@@ -984,9 +1156,11 @@ void VGA_ActivateHardwareCursor(void) {
 
 void VGA_SetupDrawing(Bitu /*val*/) {
 	if (vga.mode==M_ERROR) {
-		PIC_RemoveEvents(VGA_VerticalTimer);
-		PIC_RemoveEvents(VGA_PanningLatch);
-		PIC_RemoveEvents(VGA_DisplayStartLatch);
+		//--Modified 2026-10-17 to cancel the events by handle
+		PIC_RemoveEvent(vga.draw.events.vertical_timer);
+		PIC_RemoveEvent(vga.draw.events.panning_latch);
+		PIC_RemoveEvent(vga.draw.events.display_start_latch);
+		//--End of modifications
 		return;
 	}
 	// set the drawing mode
@@ -1441,9 +1615,10 @@ void VGA_SetupDrawing(Bitu /*val*/) {
 	vga.draw.parts_lines=vga.draw.lines_total/vga.draw.parts_total;
 	vga.draw.line_length = width * ((bpp + 1) / 8);
 #ifdef VGA_KEEP_CHANGES
+	//--Modified 2026-10-17 for VRAM write tracking
 	vga.changes.active = false;
-	vga.changes.frame = 0;
-	vga.changes.writeMask = 1;
+	vga.changes.redraw = true;
+	//--End of modifications
 #endif
     /* 
 	   Cheap hack to just make all > 640x480 modes have 4:3 aspect ratio
@@ -1457,10 +1632,13 @@ void VGA_SetupDrawing(Bitu /*val*/) {
 	if (fabs(vga.draw.delay.vtotal - 1000.0 / fps) > 0.0001) {
 		vga.draw.delay.vtotal = 1000.0 / fps;
 		VGA_KillDrawing();
-		PIC_RemoveEvents(VGA_Other_VertInterrupt);
-		PIC_RemoveEvents(VGA_VerticalTimer);
-		PIC_RemoveEvents(VGA_PanningLatch);
-		PIC_RemoveEvents(VGA_DisplayStartLatch);
+		//--Modified 2026-10-17 to cancel the events by handle
+		PIC_RemoveEvent(vga.draw.events.other_vert_interrupt[0]);
+		PIC_RemoveEvent(vga.draw.events.other_vert_interrupt[1]);
+		PIC_RemoveEvent(vga.draw.events.vertical_timer);
+		PIC_RemoveEvent(vga.draw.events.panning_latch);
+		PIC_RemoveEvent(vga.draw.events.display_start_latch);
+		//--End of modifications
 		VGA_VerticalTimer(0);
 	}
 
@@ -1503,8 +1681,9 @@ void VGA_SetupDrawing(Bitu /*val*/) {
 }
 
 void VGA_KillDrawing(void) {
-	PIC_RemoveEvents(VGA_DrawPart);
-	PIC_RemoveEvents(VGA_DrawSingleLine);
+	//--Modified 2026-10-17 to cancel the event by handle
+	PIC_RemoveEvent(vga.draw.events.draw);
+	//--End of modifications
 	vga.draw.parts_left = 0;
 	vga.draw.lines_done = ~0;
 	RENDER_EndUpdate(true);
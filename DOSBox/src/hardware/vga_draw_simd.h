@@ -0,0 +1,122 @@
+/*
+ *  Copyright (C) 2002-2010  The DOSBox Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+//Pixel expansion for the packed 2 and 4 bits per pixel line handlers in vga_draw.cpp.
+//Each reads bytes from base at (vidstart+n) & mask and draws the pixels in them into draw,
+//one byte per pixel. The _C versions are the loops those line handlers have always used.
+//The SSE2 versions of the 4 bits per pixel expansions expand 16 bytes at a time wherever
+//those bytes don't wrap around the mask, and use the _C versions for the rest: they are used
+//whenever the compiler targets SSE2, which every x86-64 CPU has. This needs vga.h for the CGA palette tables.
+
+#include <CoreFoundation/CFByteOrder.h>
+
+#if defined(__SSE2__)
+#define VGA_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/* Two bytes a block, each a pair of 4 bit pixels: high nibble first */
+static void VGA_Expand4BPP_C(Bit32u *draw, const Bit8u *base, Bitu vidstart, Bitu mask, Bitu blocks) {
+	for (Bitu x=0;x<blocks;x++) {
+		Bitu val1 = base[vidstart & mask];
+		++vidstart;
+		Bitu val2 = base[vidstart & mask];
+		++vidstart;
+
+		*draw++=CFSwapInt32HostToLittle((val1 & 0x0f) << 8  |
+				(val1 & 0xf0) >> 4  |
+				(val2 & 0x0f) << 24 |
+				(val2 & 0xf0) << 12);
+	}
+}
+
+/* One byte a block, each 4 bit pixel doubled */
+static void VGA_Expand4BPPDouble_C(Bit32u *draw, const Bit8u *base, Bitu vidstart, Bitu mask, Bitu blocks) {
+	for (Bitu x=0;x<blocks;x++) {
+		Bitu val = base[vidstart & mask];
+		++vidstart;
+
+		*draw++=CFSwapInt32HostToLittle((val & 0xf0) >> 4  |
+				(val & 0xf0) << 4  |
+				(val & 0x0f) << 16 |
+				(val & 0x0f) << 24);
+	}
+}
+
+/* One byte a block of four 2 bit pixels, looked up in the CGA palette */
+static void VGA_Expand2BPP_C(Bit32u *draw, const Bit8u *base, Bitu vidstart, Bitu mask, Bitu blocks) {
+	for (Bitu x=0;x<blocks;x++) {
+		Bitu val = base[vidstart & mask];
+		vidstart++;
+		*draw++=CGA_4_Table[val];
+	}
+}
+
+#if defined(VGA_SIMD_SSE2)
+//Whether the 16 bytes from vidstart can be read without wrapping around the mask.
+#define VGA_SIMD_CONTIGUOUS(_START,_MASK) ((((_START) & (_MASK)) + 16) <= (_MASK) + 1)
+
+/* Splits each byte into its high and low nibbles, in that order */
+static INLINE void VGA_SplitNibbles_SSE2(__m128i v, __m128i &lo, __m128i &hi) {
+	const __m128i nibble = _mm_set1_epi8(0x0f);
+	__m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+	__m128i low = _mm_and_si128(v, nibble);
+	lo = _mm_unpacklo_epi8(high, low);
+	hi = _mm_unpackhi_epi8(high, low);
+}
+
+static void VGA_Expand4BPP_SSE2(Bit32u *draw, const Bit8u *base, Bitu vidstart, Bitu mask, Bitu blocks) {
+	for (;blocks >= 8; blocks -= 8, vidstart += 16, draw += 8) {
+		if (!VGA_SIMD_CONTIGUOUS(vidstart, mask)) {
+			VGA_Expand4BPP_C(draw, base, vidstart, mask, 8);
+			continue;
+		}
+		__m128i lo, hi;
+		VGA_SplitNibbles_SSE2(_mm_loadu_si128((const __m128i *)&base[vidstart & mask]), lo, hi);
+		_mm_storeu_si128((__m128i *)draw, lo);
+		_mm_storeu_si128((__m128i *)(draw + 4), hi);
+	}
+	VGA_Expand4BPP_C(draw, base, vidstart, mask, blocks);
+}
+
+static void VGA_Expand4BPPDouble_SSE2(Bit32u *draw, const Bit8u *base, Bitu vidstart, Bitu mask, Bitu blocks) {
+	for (;blocks >= 16; blocks -= 16, vidstart += 16, draw += 16) {
+		if (!VGA_SIMD_CONTIGUOUS(vidstart, mask)) {
+			VGA_Expand4BPPDouble_C(draw, base, vidstart, mask, 16);
+			continue;
+		}
+		__m128i lo, hi;
+		VGA_SplitNibbles_SSE2(_mm_loadu_si128((const __m128i *)&base[vidstart & mask]), lo, hi);
+		_mm_storeu_si128((__m128i *)draw, _mm_unpacklo_epi8(lo, lo));
+		_mm_storeu_si128((__m128i *)(draw + 4), _mm_unpackhi_epi8(lo, lo));
+		_mm_storeu_si128((__m128i *)(draw + 8), _mm_unpacklo_epi8(hi, hi));
+		_mm_storeu_si128((__m128i *)(draw + 12), _mm_unpackhi_epi8(hi, hi));
+	}
+	VGA_Expand4BPPDouble_C(draw, base, vidstart, mask, blocks);
+}
+
+#define VGA_Expand4BPP			VGA_Expand4BPP_SSE2
+#define VGA_Expand4BPPDouble	VGA_Expand4BPPDouble_SSE2
+#else
+#define VGA_Expand4BPP			VGA_Expand4BPP_C
+#define VGA_Expand4BPPDouble	VGA_Expand4BPPDouble_C
+#endif
+
+//A byte-at-a-time lookup in CGA_4_Table draws four pixels with one load and one store,
+//which picking the palette entries with SSE2 compares doesn't beat.
+#define VGA_Expand2BPP			VGA_Expand2BPP_C
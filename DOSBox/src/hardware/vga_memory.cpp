@@ -48,7 +48,9 @@
 
 
 #ifdef VGA_KEEP_CHANGES
-#define MEM_CHANGED( _MEM ) vga.changes.map[ (_MEM) >> VGA_CHANGE_SHIFT ] |= vga.changes.writeMask;
+//--Modified 2026-10-17 for VRAM write tracking
+#define MEM_CHANGED( _MEM ) VGA_MarkChanged( _MEM );
+//--End of modifications
 //#define MEM_CHANGED( _MEM ) vga.changes.map[ (_MEM) >> VGA_CHANGE_SHIFT ] = 1;
 #else
 #define MEM_CHANGED( _MEM ) 
@@ -216,14 +218,20 @@ public:
 		addr = PAGING_GetPhysicalAddress(addr) & vgapages.mask;
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED(addr);
-		MEM_CHANGED( addr << 3);
+		//--Modified 2026-10-17 for VRAM write tracking: the pixels are at this offset in fastmem
+		MEM_CHANGED( (addr & ~3) << 1 );
+		//--End of modifications
 		writeHandler(addr+0,(Bit8u)(val >> 0));
 	}
 	void writew(PhysPt addr,Bitu val) {
 		addr = PAGING_GetPhysicalAddress(addr) & vgapages.mask;
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED(addr);
-		MEM_CHANGED( addr << 3);
+		//--Modified 2026-10-17 for VRAM write tracking: the pixels are at this offset in fastmem,
+		//and the last byte written may be in the next block
+		MEM_CHANGED( (addr & ~3) << 1 );
+		MEM_CHANGED( ((addr+1) & ~3) << 1 );
+		//--End of modifications
 		writeHandler(addr+0,(Bit8u)(val >> 0));
 		writeHandler(addr+1,(Bit8u)(val >> 8));
 	}
@@ -231,7 +239,11 @@ public:
 		addr = PAGING_GetPhysicalAddress(addr) & vgapages.mask;
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED(addr);
-		MEM_CHANGED( addr << 3);
+		//--Modified 2026-10-17 for VRAM write tracking: the pixels are at this offset in fastmem,
+		//and the last byte written may be in the next block
+		MEM_CHANGED( (addr & ~3) << 1 );
+		MEM_CHANGED( ((addr+3) & ~3) << 1 );
+		//--End of modifications
 		writeHandler(addr+0,(Bit8u)(val >> 0));
 		writeHandler(addr+1,(Bit8u)(val >> 8));
 		writeHandler(addr+2,(Bit8u)(val >> 16));
@@ -308,6 +320,9 @@ public:
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED2(addr);
 		MEM_CHANGED( addr << 3);
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( (addr+1) << 3 );
+		//--End of modifications
 		writeHandler<true>(addr+0,(Bit8u)(val >> 0));
 		writeHandler<true>(addr+1,(Bit8u)(val >> 8));
 	}
@@ -316,6 +331,9 @@ public:
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED2(addr);
 		MEM_CHANGED( addr << 3);
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( (addr+3) << 3 );
+		//--End of modifications
 		writeHandler<true>(addr+0,(Bit8u)(val >> 0));
 		writeHandler<true>(addr+1,(Bit8u)(val >> 8));
 		writeHandler<true>(addr+2,(Bit8u)(val >> 16));
@@ -389,7 +407,9 @@ public:
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED(addr);
 		MEM_CHANGED( addr );
-//		MEM_CHANGED( addr + 1);
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( addr + 1 );
+		//--End of modifications
 		if (GCC_UNLIKELY(addr & 1)) {
 			writeHandler<Bit8u>( addr+0, val >> 0 );
 			writeHandler<Bit8u>( addr+1, val >> 8 );
@@ -403,7 +423,9 @@ public:
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED(addr);
 		MEM_CHANGED( addr );
-//		MEM_CHANGED( addr + 3);
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( addr + 3 );
+		//--End of modifications
 		if (GCC_UNLIKELY(addr & 3)) {
 			writeHandler<Bit8u>( addr+0, val >> 0 );
 			writeHandler<Bit8u>( addr+1, val >> 8 );
@@ -444,6 +466,9 @@ public:
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED2(addr);
 		MEM_CHANGED( addr << 2);
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( (addr+1) << 2 );
+		//--End of modifications
 		writeHandler(addr+0,(Bit8u)(val >> 0));
 		writeHandler(addr+1,(Bit8u)(val >> 8));
 	}
@@ -452,6 +477,9 @@ public:
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED2(addr);
 		MEM_CHANGED( addr << 2);
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( (addr+3) << 2 );
+		//--End of modifications
 		writeHandler(addr+0,(Bit8u)(val >> 0));
 		writeHandler(addr+1,(Bit8u)(val >> 8));
 		writeHandler(addr+2,(Bit8u)(val >> 16));
@@ -472,6 +500,9 @@ public:
 		addr = PAGING_GetPhysicalAddress(addr) & vgapages.mask;
 		if (vga.seq.map_mask & 0x4) {
 			vga.draw.font[addr]=(Bit8u)val;
+			//--Added 2026-10-17 for per-cell text rendering
+			vga.draw.cell_changes++;
+			//--End of modifications
 		}
 	}
 };
@@ -526,13 +557,19 @@ public:
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED(addr);
 		MEM_CHANGED( addr );
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( addr+1 );
+		//--End of modifications
 		hostWrite<Bit16u>( &vga.mem.linear[addr], val );
 	}
 	void writed(PhysPt addr,Bitu val) {
 		addr = PAGING_GetPhysicalAddress(addr) & vgapages.mask;
 		addr += vga.svga.bank_write_full;
 		addr = CHECKED(addr);
-		MEM_CHANGED( addr );	
+		MEM_CHANGED( addr );
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( addr+3 );
+		//--End of modifications	
 		hostWrite<Bit32u>( &vga.mem.linear[addr], val );
 	}
 };
@@ -552,6 +589,9 @@ public:
 		addr = vga.svga.bank_write_full + (PAGING_GetPhysicalAddress(addr) & 0xffff);
 		addr = CHECKED4(addr);
 		MEM_CHANGED( addr << 3 );
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( (addr+1) << 3 );
+		//--End of modifications
 		writeHandler<false>(addr+0,(Bit8u)(val >> 0));
 		writeHandler<false>(addr+1,(Bit8u)(val >> 8));
 	}
@@ -559,6 +599,9 @@ public:
 		addr = vga.svga.bank_write_full + (PAGING_GetPhysicalAddress(addr) & 0xffff);
 		addr = CHECKED4(addr);
 		MEM_CHANGED( addr << 3 );
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( (addr+3) << 3 );
+		//--End of modifications
 		writeHandler<false>(addr+0,(Bit8u)(val >> 0));
 		writeHandler<false>(addr+1,(Bit8u)(val >> 8));
 		writeHandler<false>(addr+2,(Bit8u)(val >> 16));
@@ -619,12 +662,18 @@ public:
 		addr = CHECKED(addr);
 		hostWrite<Bit16u>( &vga.mem.linear[addr], val );
 		MEM_CHANGED( addr );
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( addr+1 );
+		//--End of modifications
 	}
 	void writed(PhysPt addr,Bitu val) {
 		addr = PAGING_GetPhysicalAddress(addr) - vga.lfb.addr;
 		addr = CHECKED(addr);
 		hostWrite<Bit32u>( &vga.mem.linear[addr], val );
 		MEM_CHANGED( addr );
+		//--Added 2026-10-17 for VRAM write tracking: the last byte written may be in the next block
+		MEM_CHANGED( addr+3 );
+		//--End of modifications
 	}
 };
 
@@ -931,9 +980,16 @@ void VGA_SetupMemory(Section* sec) {
 
 #ifdef VGA_KEEP_CHANGES
 	memset( &vga.changes, 0, sizeof( vga.changes ));
-	int changesMapSize = (vga.vmemsize >> VGA_CHANGE_SHIFT) + 32;
-	vga.changes.map = new Bit8u[changesMapSize];
-	memset(vga.changes.map, 0, changesMapSize);
+	//--Modified 2026-10-17 for VRAM write tracking: the map covers fastmem, which is twice as big
+	//as video memory, rounded up so that offsets can be wrapped to it
+	vga.changes.mask = (1 << VGA_CHANGE_SHIFT) - 1;
+	while (vga.changes.mask < (vga.vmemsize << 1) - 1) vga.changes.mask = (vga.changes.mask << 1) | 1;
+	int changesMapSize = (vga.changes.mask >> VGA_CHANGE_SHIFT) + 1;
+	vga.changes.map = new Bit32u[changesMapSize];
+	memset(vga.changes.map, 0, changesMapSize * sizeof(Bit32u));
+	vga.changes.frame = 1;
+	vga.changes.redraw = true;
+	//--End of modifications
 #endif
 	vga.svga.bank_read = vga.svga.bank_write = 0;
 	vga.svga.bank_read_full = vga.svga.bank_write_full = 0;
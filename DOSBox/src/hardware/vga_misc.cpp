@@ -22,6 +22,9 @@
 #include "inout.h"
 #include "pic.h"
 #include "vga.h"
+#include "cpu.h"
+#include "regs.h"
+#include "paging.h"
 #include <math.h>
 
 
@@ -30,6 +33,87 @@ Bitu vga_read_p3d4(Bitu port,Bitu iolen);
 void vga_write_p3d5(Bitu port,Bitu val,Bitu iolen);
 Bitu vga_read_p3d5(Bitu port,Bitu iolen);
 
+//--Added 2026-10-17 for host-idle detection.
+//Programs waiting for retrace read the status register in a tight loop until the bit they
+//want changes. Once the same value has been read back-to-back enough times by the same
+//instruction, and that instruction is in a loop that does nothing else, we skip ahead to the
+//next point in the frame at which any status bit changes, since nothing the guest can do will
+//change it sooner. Loops that might be doing anything else, such as counting how long the
+//wait takes to time the CPU, only let the host rest.
+#define VGA_IDLE_POLL_CYCLES 32		//Most cycles (besides IO delay) between reads of a tight loop
+#define VGA_IDLE_POLL_COUNT 4		//Back-to-back reads before we skip ahead
+
+static struct {
+	PhysPt ip;
+	Bit64s stamp;
+	Bitu count;
+	Bit8u value;
+} p3da_poll;
+
+//Whether the code at CS:IP is a loop that does nothing but read the status register until
+//a bit of it changes, i.e.  l: [mov dx,3dah] / in al,dx / test al,imm (or and al,imm) / jz l (or jnz l).
+//Depending on the core, CS:IP is either the in itself or the start of the loop.
+static bool VGA_IsStatusPollLoop(void) {
+	Bit32u mask=cpu.code.big ? 0xffffffff : 0xffff;
+	Bit8u code[8];
+	for (Bitu i=0;i<2;i++) {
+		Bit32u head=(reg_eip-(i?3:0))&mask;
+		for (Bitu b=0;b<sizeof(code);b++) {
+			if (mem_readb_checked(SegPhys(cs)+((head+b)&mask),&code[b])) return false;
+		}
+		/* mov dx,imm16 is only that short in 16-bit code */
+		Bitu in=(!cpu.code.big && code[0]==0xba && code[1]==0xda && code[2]==0x03) ? 3 : 0;
+		if (i && !in) continue;
+		if (code[in]!=0xec) continue;
+		if (code[in+1]!=0xa8 && code[in+1]!=0x24) continue;
+		if (code[in+3]!=0x74 && code[in+3]!=0x75) continue;
+		if (((head+in+5+(Bit8s)code[in+4])&mask)==head) return true;
+	}
+	return false;
+}
+
+static double VGA_NextStatusChange(double timeInFrame) {
+	double next = vga.draw.delay.vtotal;
+	if (timeInFrame < vga.draw.delay.vrstart && vga.draw.delay.vrstart < next) next = vga.draw.delay.vrstart;
+	if (timeInFrame <= vga.draw.delay.vrend && vga.draw.delay.vrend < next) next = vga.draw.delay.vrend;
+	if (timeInFrame < vga.draw.delay.vdend) {
+		if (vga.draw.delay.vdend < next) next = vga.draw.delay.vdend;
+		double lineStart = timeInFrame - fmod(timeInFrame,vga.draw.delay.htotal);
+		double edges[3] = {
+			lineStart + vga.draw.delay.hblkstart,
+			lineStart + vga.draw.delay.hblkend,
+			lineStart + vga.draw.delay.htotal
+		};
+		for (Bitu i=0;i<3;i++) {
+			if (edges[i] >= timeInFrame && edges[i] < next) next = edges[i];
+		}
+	}
+	return next;
+}
+
+static void VGA_IdleOnRepeatedStatusRead(double timeInFrame,Bit8u value) {
+	if (!CPU_IdleSkip) return;
+	Bit64s now = (Bit64s)PIC_Ticks * CPU_CycleMax + PIC_TickIndexND();
+	Bit64s threshold = VGA_IDLE_POLL_CYCLES + CPU_CycleMax/1024;
+	PhysPt ip = SegPhys(cs) + reg_eip;
+	if (value == p3da_poll.value && ip == p3da_poll.ip && now >= p3da_poll.stamp && now - p3da_poll.stamp <= threshold) {
+		if (++p3da_poll.count >= VGA_IDLE_POLL_COUNT) {
+			if (VGA_IsStatusPollLoop()) {
+				double delay = VGA_NextStatusChange(timeInFrame) - timeInFrame;
+				if (delay > 0) CPU_SkipIdleCycles(PIC_MakeCycles(delay) + 1);
+			} else {
+				CPU_IdleHost();
+			}
+		}
+	} else {
+		p3da_poll.count = 0;
+	}
+	p3da_poll.ip = ip;
+	p3da_poll.value = value;
+	p3da_poll.stamp = now;
+}
+//--End of modifications
+
 Bitu vga_read_p3da(Bitu port,Bitu iolen) {
 	Bit8u retval=0;
 	double timeInFrame = PIC_FullIndex()-vga.draw.delay.framestart;
@@ -53,6 +137,9 @@ Bitu vga_read_p3da(Bitu port,Bitu iolen) {
 			retval |= 1;
 		}
 	}
+	//--Added 2026-10-17 for host-idle detection
+	VGA_IdleOnRepeatedStatusRead(timeInFrame,retval);
+	//--End of modifications
 	return retval;
 }
 
@@ -161,6 +161,11 @@ void XGA_DrawPoint(Bitu x, Bitu y, Bitu c) {
 		default:
 			break;
 	}
+	//--Added 2026-10-17 for VRAM write tracking
+#ifdef VGA_KEEP_CHANGES
+	VGA_MarkChanged(memaddr * ((XGA_COLOR_MODE == M_LIN8) ? 1 : ((XGA_COLOR_MODE == M_LIN32) ? 4 : 2)));
+#endif
+	//--End of modifications
 
 }
 
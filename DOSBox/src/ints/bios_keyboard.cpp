@@ -26,6 +26,9 @@
 #include "regs.h"
 #include "inout.h"
 #include "dos_inc.h"
+#include "cpu.h"
+#include "pic.h"
+#include "paging.h"
 #include "SDL.h"
 
 /* SDL by default treats numlock and scrolllock different from all other keys.
@@ -532,6 +535,58 @@ static bool IsEnhancedKey(Bit16u &key) {
 	return false;
 }
 
+//--Added 2026-10-17 for host-idle detection.
+//Programs that wait for a keystroke by polling for one in a tight loop (e.g. while (!kbhit());)
+//spin the CPU for nothing until the next keyboard interrupt. When the same caller polls over and
+//over with next to nothing in between, and the caller is a loop that does nothing but poll, treat
+//it like a blocking read and skip ahead to the next event. Callers that might be doing anything
+//else in between, such as counting, only let the host rest.
+#define INT16_IDLE_POLL_CYCLES 64	//Most cycles between polls of a tight loop
+#define INT16_IDLE_POLL_COUNT 8		//Back-to-back empty polls before we skip ahead
+
+static struct {
+	Bit32u caller;
+	Bit64s stamp;
+	Bitu count;
+} int16_poll;
+
+//Whether the caller is a loop that does nothing but poll, i.e.  l: [mov ah,1] / int 16h / jz l
+//(or mov ah,11h, or mov ax,imm16 instead). Only real and virtual 8086 mode callers are checked.
+static bool INT16_IsPollLoop(Bit32u caller) {
+	if (cpu.pmode && !GETFLAG(VM)) return false;
+	Bit16u ip=(Bit16u)caller;
+	PhysPt base=(caller >> 16) << 4;
+	Bit8u code[7];
+	for (Bitu b=0;b<sizeof(code);b++) {
+		if (mem_readb_checked(base+(Bit16u)(ip-5+b),&code[b])) return false;
+	}
+	if (code[3]!=0xcd || code[4]!=0x16 || code[5]!=0x74) return false;
+	Bit16u target=(Bit16u)(ip+2+(Bit8s)code[6]);
+	if (target==(Bit16u)(ip-2)) return true;
+	if (target==(Bit16u)(ip-4)) return code[1]==0xb4 && (code[2]==0x01 || code[2]==0x11);
+	if (target==(Bit16u)(ip-5)) return code[0]==0xb8 && (code[2]==0x01 || code[2]==0x11);
+	return false;
+}
+
+static void INT16_IdleOnRepeatedPoll(void) {
+	if (!CPU_IdleSkip) return;
+	/* The caller's return address, as pushed by the INT instruction */
+	PhysPt sp=SegPhys(ss)+(reg_esp & cpu.stack.mask);
+	Bit32u caller=((Bit32u)mem_readw(sp+2) << 16) | mem_readw(sp);
+	Bit64s now=(Bit64s)PIC_Ticks*CPU_CycleMax+PIC_TickIndexND();
+	if (caller==int16_poll.caller && now>=int16_poll.stamp && now-int16_poll.stamp<=INT16_IDLE_POLL_CYCLES) {
+		if (++int16_poll.count>=INT16_IDLE_POLL_COUNT) {
+			if (INT16_IsPollLoop(caller)) CPU_SkipIdleCycles();
+			else CPU_IdleHost();
+		}
+	} else {
+		int16_poll.count=0;
+	}
+	int16_poll.caller=caller;
+	int16_poll.stamp=now;
+}
+//--End of modifications
+
 static Bitu INT16_Handler(void) {
 	Bit16u temp=0;
     
@@ -550,6 +605,9 @@ static Bitu INT16_Handler(void) {
 		} else {
 			/* enter small idle loop to allow for irqs to happen */
 			reg_ip+=1;
+			//--Added 2026-10-17 for host-idle detection: nothing but an interrupt can end the wait
+			CPU_SkipIdleCycles();
+			//--End of modifications
 		}
 		break;
 	case 0x10: /* GET KEYSTROKE (enhanced keyboards only) */
@@ -562,6 +620,9 @@ static Bitu INT16_Handler(void) {
 		} else {
 			/* enter small idle loop to allow for irqs to happen */
 			reg_ip+=1;
+			//--Added 2026-10-17 for host-idle detection: nothing but an interrupt can end the wait
+			CPU_SkipIdleCycles();
+			//--End of modifications
 		}
 		break;
 	case 0x01: /* CHECK FOR KEYSTROKE */
@@ -581,6 +642,9 @@ static Bitu INT16_Handler(void) {
 			} else {
 				/* no key available */
 				CALLBACK_SZF(true);
+				//--Added 2026-10-17 for host-idle detection
+				INT16_IdleOnRepeatedPoll();
+				//--End of modifications
 				break;
 			}
 //			CALLBACK_Idle();
@@ -589,6 +653,9 @@ static Bitu INT16_Handler(void) {
 	case 0x11: /* CHECK FOR KEYSTROKE (enhanced keyboards only) */
 		if (!check_key(temp)) {
 			CALLBACK_SZF(true);
+			//--Added 2026-10-17 for host-idle detection
+			INT16_IdleOnRepeatedPoll();
+			//--End of modifications
 		} else {
 			CALLBACK_SZF(false);
 			if (((temp&0xff)==0xf0) && (temp>>8)) {
@@ -400,6 +400,11 @@ static void FinishSetMode(bool clearmem) {
 			/* Hack we just acess the memory directly */
 			memset(vga.mem.linear,0,vga.vmemsize);
 			memset(vga.fastmem, 0, vga.vmemsize<<1);
+			//--Added 2026-10-17 for VRAM write tracking
+#ifdef VGA_KEEP_CHANGES
+			vga.changes.redraw = true;
+#endif
+			//--End of modifications
 		}
 	}
 	/* Setup the BIOS */
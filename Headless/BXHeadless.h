@@ -0,0 +1,122 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//BXHeadless defines the state shared between the parts of boxer-headless, a windowless host
+//for DOSBox's emulation core. boxer-headless implements every Coalface hook with null or
+//file-backed stand-ins, so that the core can be run and benchmarked without a GUI session
+//(and without OS X).
+
+
+#ifndef BOXER_HEADLESS_H
+#define BOXER_HEADLESS_H
+
+#include "config.h"
+#include <stdio.h>
+#include <string>
+#include <deque>
+#include <vector>
+
+
+#pragma mark - Settings
+
+typedef struct {
+    //How many milliseconds of emulated time to run for before shutting down.
+    Bitu emulatedMilliseconds;
+
+    //Whether to run the emulation unthrottled, as fast as the host can manage
+    //(equivalent to DOSBox's fast-forward) rather than pacing it to realtime.
+    bool unthrottled;
+
+    //Whether to echo DOSBox's log messages to stderr.
+    bool verbose;
+
+    //DOS commands to execute in order at the DOS prompt, once the autoexec has finished.
+    std::deque<std::string> commandQueue;
+
+    //BIOS keycodes (scancode << 8 | ASCII) to feed to programs reading from the keyboard.
+    std::deque<Bit16u> keyBuffer;
+
+    //Where to write the mixed audio output, as raw 16-bit stereo native-endian PCM.
+    //Mixed audio is discarded if this is NULL.
+    FILE *audioOutput;
+
+    //Where to write the final rendered frame as a PPM image once emulation finishes.
+    //No image will be written if this is empty.
+    std::string screenshotPath;
+
+    //Where to write files captured by DOSBox (e.g. WAV, MIDI and image captures).
+    //Captures will be discarded if this is empty.
+    std::string capturePath;
+} BXHeadlessSettings;
+
+extern BXHeadlessSettings headlessSettings;
+
+
+#pragma mark - Statistics
+
+typedef struct {
+    //The total number of CPU cycles DOSBox scheduled over the run.
+    Bit64u emulatedCycles;
+
+    //The number of milliseconds of emulated time that passed over the run.
+    Bitu emulatedMilliseconds;
+
+    //The number of frames DOSBox handed off to boxer_finishFrame, and how
+    //many of those contained changed lines.
+    Bit64u frames;
+    Bit64u changedFrames;
+
+    //How many of the frames had the same generation as the frame before them:
+    //frames that were drawn again without anything visible changing.
+    Bit64u duplicateFrames;
+
+    //The number of output tiles those changed frames had drawn into, out of
+    //the total number of tiles in them: how much of each frame a partial
+    //upload would have needed to send.
+    Bit64u dirtyTiles;
+    Bit64u totalTiles;
+
+    //The number of stereo sample frames pulled from the mixer.
+    Bit64u mixerSamples;
+
+    //The realtime and host CPU time spent running the emulation, in seconds.
+    double wallTime;
+    double hostCPUTime;
+} BXHeadlessStats;
+
+extern BXHeadlessStats headlessStats;
+
+
+#pragma mark - Runloop
+
+//Called once DOSBox has finished initializing its modules, just before emulation starts.
+void headless_didInitialize();
+
+//Called once DOSBox has finished emulating, to finalize statistics.
+void headless_didFinish();
+
+//Whether emulation has been cancelled, either because the emulated time limit
+//has been reached or because DOSBox has asked to shut down.
+bool headless_isCancelled();
+
+//Writes the most recently rendered frame to the specified path as a PPM image.
+//Returns false if there was no frame to write or the file could not be written.
+bool headless_writeScreenshot(const char *path);
+
+
+#pragma mark - Audio
+
+//Defined in BXHeadlessSDL.cpp: pulls the specified number of sample frames
+//from DOSBox's audio callback, as if an audio device had consumed them, and
+//writes them to output if provided. Returns the number of sample frames pulled,
+//which will be 0 if DOSBox has not opened (or has paused) the audio device.
+Bitu headless_pullAudio(Bitu numSampleFrames, FILE *output);
+
+//The sample rate at which DOSBox opened the audio device, or 0 if it is not open.
+Bitu headless_audioSampleRate();
+
+#endif
@@ -0,0 +1,551 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Headless implementations of the Coalface hooks declared in BXCoalface.h and BXCoalfaceAudio.h.
+//Where BXCoalface.mm hands off to BXEmulator, these either do nothing, talk directly to the
+//local filesystem, or record what happened for boxer-headless's benchmark report.
+
+
+#include "BXHeadless.h"
+#include "BXCoalface.h"
+#include "BXCoalfaceAudio.h"
+#include "dosbox.h"
+#include "control.h"
+#include "shell.h"
+#include "mapper.h"
+#include "cross.h"
+#include "pic.h"
+#include "cpu.h"
+#include "timer.h"
+#include "hardware.h"
+#include "render.h"
+
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <stdexcept>
+
+
+BXHeadlessSettings headlessSettings;
+BXHeadlessStats headlessStats;
+
+static bool _initialized = false;
+static bool _cancelled = false;
+static bool _waitingForCommandInput = false;
+
+static Bitu _startTicks = 0;
+static Bit64u _pulledSampleFrames = 0;
+static double _startWallTime = 0;
+static double _startCPUTime = 0;
+
+static GFX_CallBack_t _frameCallback = NULL;
+static std::vector<Bit8u> _frameBuffer;
+static Bitu _frameWidth = 0;
+static Bitu _frameHeight = 0;
+static bool _frameInProgress = false;
+static bool _hasFinishedFrame = false;
+static Bitu _lastFrameGeneration = 0;
+
+static unsigned int _captureCount = 0;
+
+
+#pragma mark - Runloop state functions
+
+static double _wallTime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + (now.tv_nsec / 1e9);
+}
+
+static double _hostCPUTime()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + (usage.ru_utime.tv_usec / 1e6) +
+           usage.ru_stime.tv_sec + (usage.ru_stime.tv_usec / 1e6);
+}
+
+//Tallies up the cycles DOSBox has scheduled for each emulated millisecond.
+static void _countCycles()
+{
+    headlessStats.emulatedCycles += CPU_CycleMax;
+}
+
+static void _cancel()
+{
+    if (_cancelled) return;
+
+    //Tells DOSBox to close the current shell at the end of the commandline input loop
+    if (currentShell) currentShell->exit = true;
+    _cancelled = true;
+}
+
+//Keeps our statistics and our pretend audio device in step with emulated time,
+//and stops emulation once we've run for as long as we were asked to.
+static void _syncWithEmulatedTime()
+{
+    headlessStats.emulatedMilliseconds = PIC_Ticks - _startTicks;
+
+    Bitu sampleRate = headless_audioSampleRate();
+    if (sampleRate)
+    {
+        Bit64u sampleFramesDue = ((Bit64u)headlessStats.emulatedMilliseconds * sampleRate) / 1000;
+        if (sampleFramesDue > _pulledSampleFrames)
+        {
+            _pulledSampleFrames += headless_pullAudio(sampleFramesDue - _pulledSampleFrames, headlessSettings.audioOutput);
+            headlessStats.mixerSamples = _pulledSampleFrames;
+        }
+    }
+
+    if (headlessStats.emulatedMilliseconds >= headlessSettings.emulatedMilliseconds)
+        _cancel();
+}
+
+void headless_didInitialize()
+{
+    //Equivalent to holding down DOSBox's fast-forward key for the whole run.
+    extern bool ticksLocked;
+    ticksLocked = headlessSettings.unthrottled;
+
+    TIMER_AddTickHandler(_countCycles);
+
+    _startTicks = PIC_Ticks;
+    _startWallTime = _wallTime();
+    _startCPUTime = _hostCPUTime();
+    _initialized = true;
+}
+
+void headless_didFinish()
+{
+    _syncWithEmulatedTime();
+    headlessStats.wallTime = _wallTime() - _startWallTime;
+    headlessStats.hostCPUTime = _hostCPUTime() - _startCPUTime;
+
+    //Let the render thread finish any frames it has been handed before we look at them.
+    RENDER_WaitForFrames();
+    if (_frameInProgress) boxer_finishFrame(NULL);
+    if (_frameCallback) _frameCallback(GFX_CallBackStop);
+}
+
+bool headless_isCancelled()
+{
+    return _cancelled;
+}
+
+void boxer_processEvents()
+{
+    _syncWithEmulatedTime();
+}
+
+void boxer_runLoopWillStartWithContextInfo(void **contextInfo)
+{
+    if (contextInfo) *contextInfo = NULL;
+}
+
+void boxer_runLoopDidFinishWithContextInfo(void *contextInfo) {}
+
+bool boxer_runLoopShouldContinue()
+{
+	//TWEAK: as in BXEmulator, it's only safe to break out once initialization is done,
+	//since some of DOSBox's initialization routines rely on running tasks on the run loop.
+    return !(_cancelled && _initialized);
+}
+
+void boxer_handleDOSBoxTitleChange(Bit32s newCycles, Bits newFrameskip, bool newPaused) {}
+
+
+#pragma mark - Rendering functions
+
+void boxer_applyRenderingStrategy() {}
+
+Bitu boxer_prepareForFrameSize(Bitu width, Bitu height, Bitu gfx_flags, double scalex, double scaley, GFX_CallBack_t callback)
+{
+    _frameInProgress = false;
+    _hasFinishedFrame = false;
+    _frameCallback = callback;
+
+    _frameWidth = width;
+    _frameHeight = height;
+    _frameBuffer.assign(width * height * 4, 0);
+
+    return GFX_CAN_32 | GFX_SCALING;
+}
+
+Bitu boxer_idealOutputMode(Bitu flags)
+{
+    return GFX_CAN_32 | GFX_SCALING;
+}
+
+bool boxer_startFrame(Bit8u **frameBuffer, Bitu *pitch)
+{
+    if (_frameInProgress || _frameBuffer.empty()) return false;
+
+    *frameBuffer = &_frameBuffer[0];
+    *pitch = _frameWidth * 4;
+
+    _frameInProgress = true;
+    return true;
+}
+
+void boxer_finishFrame(const uint16_t *dirtyBlocks)
+{
+    if (_frameInProgress)
+    {
+        headlessStats.frames++;
+
+        Bitu generation = RENDER_GetFrameGeneration(NULL);
+        if (generation == _lastFrameGeneration) headlessStats.duplicateFrames++;
+        _lastFrameGeneration = generation;
+
+        if (dirtyBlocks)
+        {
+            headlessStats.changedFrames++;
+
+            Bitu across, down, tileSize;
+            const Bit8u *tiles = RENDER_GetDirtyTiles(&across, &down, &tileSize);
+            for (Bitu i=0; tiles && i < across * down; i++)
+            {
+                if (tiles[i]) headlessStats.dirtyTiles++;
+            }
+            headlessStats.totalTiles += across * down;
+        }
+        _hasFinishedFrame = true;
+    }
+    _frameInProgress = false;
+}
+
+Bitu boxer_getRGBPaletteEntry(Bit8u red, Bit8u green, Bit8u blue)
+{
+    //Same layout as BXVideoHandler.
+    return ((blue << 0) | (green << 8) | (red << 16)) | (255U << 24);
+}
+
+void boxer_setPalette(Bitu start,Bitu count,GFX_PalEntry * entries) {}
+
+bool headless_writeScreenshot(const char *path)
+{
+    if (!_hasFinishedFrame) return false;
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    fprintf(file, "P6\n%lu %lu\n255\n", (unsigned long)_frameWidth, (unsigned long)_frameHeight);
+    for (Bitu i=0; i < _frameWidth * _frameHeight; i++)
+    {
+        Bit32u pixel = *(Bit32u *)&_frameBuffer[i * 4];
+        Bit8u rgb[3] = { (Bit8u)(pixel >> 16), (Bit8u)(pixel >> 8), (Bit8u)(pixel) };
+        fwrite(rgb, 1, 3, file);
+    }
+    bool succeeded = !ferror(file);
+    fclose(file);
+    return succeeded;
+}
+
+
+#pragma mark - Shell-related functions
+
+void boxer_shellWillStart(DOS_Shell *shell) {}
+void boxer_shellDidFinish(DOS_Shell *shell) {}
+
+bool boxer_shellShouldContinue(DOS_Shell *shell)
+{
+    return !_cancelled;
+}
+
+bool boxer_shellShouldRunCommand(DOS_Shell *shell, char* cmd, char* args)
+{
+    //Swallow Boxer's own shell commands (e.g. boxer_preflight and boxer_launch
+    //from Boxer's configuration files), since there's no Boxer here to run them.
+    return strncasecmp(cmd, "boxer_", 6) != 0;
+}
+
+bool boxer_handleShellCommandInput(DOS_Shell *shell, char *cmd, Bitu *cursorPosition, bool *executeImmediately)
+{
+    //If we have any pending commands, ignore the current command input and break
+    //out of command processing immediately.
+    if (boxer_hasPendingCommandsForShell(shell))
+    {
+        *executeImmediately = true;
+        return true;
+    }
+    return false;
+}
+
+bool boxer_hasPendingCommandsForShell(DOS_Shell *shell)
+{
+    //Hold off on our own commands until any batchfile (including the autoexec)
+    //has finished, so that scripted commands always run in order at the prompt.
+    return !_cancelled && !headlessSettings.commandQueue.empty() && shell->bf == NULL;
+}
+
+bool boxer_executeNextPendingCommandForShell(DOS_Shell *shell)
+{
+    if (headlessSettings.commandQueue.empty()) return false;
+
+    //Copy the command and pop it off the queue before we execute it,
+    //since it may block and execute nested commands.
+    std::string command = headlessSettings.commandQueue.front();
+    headlessSettings.commandQueue.pop_front();
+
+    char encodedCommand[CMD_MAXLINE];
+    safe_strncpy(encodedCommand, command.c_str(), CMD_MAXLINE);
+    shell->ParseLine(encodedCommand);
+    return true;
+}
+
+void boxer_shellWillReadCommandInputFromHandle(DOS_Shell *shell, Bit16u handle)
+{
+    if (handle == STDIN) _waitingForCommandInput = true;
+}
+
+void boxer_shellDidReadCommandInputFromHandle(DOS_Shell *shell, Bit16u handle)
+{
+    if (handle == STDIN) _waitingForCommandInput = false;
+}
+
+void boxer_didReturnToShell(DOS_Shell *shell) {}
+void boxer_shellWillStartAutoexec(DOS_Shell *shell) {}
+void boxer_shellWillExecuteFileAtDOSPath(DOS_Shell *shell, const char *path, const char *arguments) {}
+void boxer_shellDidExecuteFileAtDOSPath(DOS_Shell *shell, const char *path) {}
+void boxer_shellWillBeginBatchFile(DOS_Shell *shell, const char *path, const char *arguments) {}
+void boxer_shellDidEndBatchFile(DOS_Shell *shell, const char *canonicalPath) {}
+
+bool boxer_shellShouldDisplayStartupMessages(DOS_Shell *shell)
+{
+    return false;
+}
+
+
+#pragma mark - Filesystem functions
+
+FILE *boxer_openCaptureFile(const char *typeDescription, const char *fileExtension)
+{
+    if (headlessSettings.capturePath.empty()) return NULL;
+
+    char path[CROSS_LEN];
+    snprintf(path, CROSS_LEN, "%s/capture%03u%s", headlessSettings.capturePath.c_str(), _captureCount++, fileExtension);
+    return fopen(path, "wb");
+}
+
+bool boxer_shouldMountPath(const char *path)                                    { return true; }
+bool boxer_shouldShowFileWithName(const char *name)                             { return true; }
+bool boxer_shouldAllowWriteAccessToPath(const char *path, DOS_Drive *dosboxDrive)  { return true; }
+
+void boxer_driveDidMount(Bit8u driveIndex) {}
+void boxer_driveDidUnmount(Bit8u driveIndex) {}
+void boxer_didCreateLocalFile(const char *path, DOS_Drive *dosboxDrive) {}
+void boxer_didRemoveLocalFile(const char *path, DOS_Drive *dosboxDrive) {}
+
+FILE * boxer_openLocalFile(const char *path, DOS_Drive *drive, const char *mode)
+{
+    return fopen(path, mode);
+}
+
+bool boxer_removeLocalFile(const char *path, DOS_Drive *drive)
+{
+    return unlink(path) == 0;
+}
+
+bool boxer_moveLocalFile(const char *fromPath, const char *toPath, DOS_Drive *drive)
+{
+    return rename(fromPath, toPath) == 0;
+}
+
+bool boxer_createLocalDir(const char *path, DOS_Drive *drive)
+{
+    return mkdir(path, 0700) == 0;
+}
+
+bool boxer_removeLocalDir(const char *path, DOS_Drive *drive)
+{
+    return rmdir(path) == 0;
+}
+
+bool boxer_getLocalPathStats(const char *path, DOS_Drive *drive, struct stat *outStatus)
+{
+    return stat(path, outStatus) == 0;
+}
+
+bool boxer_localDirectoryExists(const char *path, DOS_Drive *drive)
+{
+    struct stat status;
+    return stat(path, &status) == 0 && S_ISDIR(status.st_mode);
+}
+
+bool boxer_localFileExists(const char *path, DOS_Drive *drive)
+{
+    struct stat status;
+    return stat(path, &status) == 0 && S_ISREG(status.st_mode);
+}
+
+
+#pragma mark Directory enumeration
+
+typedef struct {
+    DIR *directory;
+    std::string path;
+} BXHeadlessDirectoryEnumerator;
+
+void *boxer_openLocalDirectory(const char *path, DOS_Drive *drive)
+{
+    DIR *directory = opendir(path);
+    if (!directory) return NULL;
+
+    //The enumerator will be deleted when the calling context calls boxer_closeLocalDirectory().
+    BXHeadlessDirectoryEnumerator *enumerator = new BXHeadlessDirectoryEnumerator;
+    enumerator->directory = directory;
+    enumerator->path = path;
+    return enumerator;
+}
+
+void boxer_closeLocalDirectory(void *handle)
+{
+    BXHeadlessDirectoryEnumerator *enumerator = (BXHeadlessDirectoryEnumerator *)handle;
+    if (!enumerator) return;
+
+    closedir(enumerator->directory);
+    delete enumerator;
+}
+
+bool boxer_getNextDirectoryEntry(void *handle, char *outName, bool &isDirectory)
+{
+    BXHeadlessDirectoryEnumerator *enumerator = (BXHeadlessDirectoryEnumerator *)handle;
+    if (!enumerator) return false;
+
+    struct dirent *entry = readdir(enumerator->directory);
+    if (!entry) return false;
+
+    safe_strncpy(outName, entry->d_name, CROSS_LEN);
+
+    if (entry->d_type != DT_UNKNOWN && entry->d_type != DT_LNK)
+    {
+        isDirectory = (entry->d_type == DT_DIR);
+    }
+    else
+    {
+        std::string fullPath = enumerator->path + "/" + entry->d_name;
+        struct stat status;
+        isDirectory = (stat(fullPath.c_str(), &status) == 0) && S_ISDIR(status.st_mode);
+    }
+    return true;
+}
+
+
+#pragma mark - Input functions
+
+const char * boxer_preferredKeyboardLayout()
+{
+    return NULL;
+}
+
+Bitu boxer_numKeyCodesInPasteBuffer()
+{
+    return headlessSettings.keyBuffer.size();
+}
+
+bool boxer_continueListeningForKeyEvents()
+{
+    if (_cancelled || (_waitingForCommandInput && !headlessSettings.commandQueue.empty()))
+    {
+        return false;
+    }
+    return true;
+}
+
+bool boxer_getNextKeyCodeInPasteBuffer(Bit16u *outKeyCode, bool consumeKey)
+{
+    if (headlessSettings.keyBuffer.empty()) return false;
+
+    *outKeyCode = headlessSettings.keyBuffer.front();
+    if (consumeKey) headlessSettings.keyBuffer.pop_front();
+    return true;
+}
+
+void boxer_setMouseActive(bool mouseActive) {}
+void boxer_setJoystickActive(bool joystickActive) {}
+void boxer_mouseMovedToPoint(float x, float y) {}
+void boxer_setCapsLockActive(bool active) {}
+void boxer_setNumLockActive(bool active) {}
+void boxer_setScrollLockActive(bool active) {}
+
+
+#pragma mark - Printer functions
+
+//There's no printer attached: report a ready printer with nothing to say,
+//and let DOS programs print into the void.
+static Bitu _printerData = 0;
+static Bitu _printerControl = 0;
+
+Bitu boxer_PRINTER_readdata(Bitu port,Bitu iolen)               { return _printerData; }
+void boxer_PRINTER_writedata(Bitu port,Bitu val,Bitu iolen)     { _printerData = val; }
+Bitu boxer_PRINTER_readstatus(Bitu port,Bitu iolen)             { return 0xDF; }
+void boxer_PRINTER_writecontrol(Bitu port,Bitu val, Bitu iolen) { _printerControl = val; }
+Bitu boxer_PRINTER_readcontrol(Bitu port,Bitu iolen)            { return _printerControl; }
+bool boxer_PRINTER_isInited(Bitu port)                          { return false; }
+
+
+#pragma mark - Audio functions
+
+void boxer_suggestMIDIHandler(const char *handlerName, const char *configParams) {}
+bool boxer_MIDIAvailable()                          { return false; }
+void boxer_sendMIDIMessage(Bit8u *msg) {}
+void boxer_sendMIDISysex(Bit8u *msg, Bitu len) {}
+
+float boxer_masterVolume(BXAudioChannel channel)
+{
+    return 1.0f;
+}
+
+
+#pragma mark - Helper functions
+
+const char * boxer_localizedStringForKey(char const *keyStr)
+{
+    //Matches Boxer's behaviour for keys that are missing from its string tables.
+    return "";
+}
+
+void boxer_log(char const* format,...)
+{
+    if (!headlessSettings.verbose) return;
+
+	va_list params;
+	va_start(params, format);
+	vfprintf(stderr, format, params);
+	va_end(params);
+    fputc('\n', stderr);
+}
+
+void boxer_die(const char *functionName, const char *fileName, int lineNumber, const char * format,...)
+{
+    char errorReason[1024];
+	va_list params;
+	va_start(params, format);
+	vsnprintf(errorReason, sizeof(errorReason), format, params);
+	va_end(params);
+
+    char description[1536];
+    snprintf(description, sizeof(description), "%s (%s:%d, %s)", errorReason, fileName, lineNumber, functionName);
+    throw std::runtime_error(description);
+}
+
+
+#pragma mark - No-ops
+
+//These used to be defined in sdl_mapper.cpp, which we no longer include in Boxer.
+void MAPPER_AddHandler(MAPPER_Handler * handler,MapKeys key,Bitu mods,char const * const eventname,char const * const buttonname) {}
+void MAPPER_Init(void) {}
+void MAPPER_StartUp(Section * sec) {}
+void MAPPER_Run(bool pressed) {}
+void MAPPER_RunInternal() {}
+void MAPPER_LosingFocus(void) {}
@@ -0,0 +1,292 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Implementations for the SDL stand-in declared in include/SDL: these cover the subset of SDL
+//that DOSBox's emulation core uses, backed by POSIX timing and threading.
+//There is no audio device: instead, the host pulls audio from DOSBox's callback at the pace of
+//emulated time (see headless_pullAudio), which keeps runs deterministic regardless of host speed.
+
+
+#include "SDL.h"
+#include "BXHeadless.h"
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#pragma mark - Initialization
+
+static char _lastError[256] = "";
+
+int SDL_Init(Uint32 flags)
+{
+    return SDL_InitSubSystem(flags);
+}
+
+int SDL_InitSubSystem(Uint32 flags)
+{
+    SDL_GetTicks(); //Starts the tick counter
+    return 0;
+}
+
+void SDL_QuitSubSystem(Uint32 flags) {}
+
+void SDL_Quit(void)
+{
+    SDL_CloseAudio();
+}
+
+char *SDL_GetError(void)
+{
+    return _lastError;
+}
+
+
+#pragma mark - Timing
+
+static struct timespec _startTime;
+static bool _startedTicks = false;
+
+Uint32 SDL_GetTicks(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (!_startedTicks)
+    {
+        _startTime = now;
+        _startedTicks = true;
+    }
+
+    Bit64s milliseconds = (Bit64s)(now.tv_sec - _startTime.tv_sec) * 1000;
+    milliseconds += (now.tv_nsec - _startTime.tv_nsec) / 1000000;
+    return (Uint32)milliseconds;
+}
+
+void SDL_Delay(Uint32 ms)
+{
+    struct timespec delay;
+    delay.tv_sec = ms / 1000;
+    delay.tv_nsec = (ms % 1000) * 1000000;
+    while (nanosleep(&delay, &delay) == -1 && errno == EINTR);
+}
+
+
+#pragma mark - Audio
+
+static SDL_AudioSpec _audioSpec;
+static bool _audioOpen = false;
+static bool _audioPaused = true;
+static pthread_mutex_t _audioLock = PTHREAD_MUTEX_INITIALIZER;
+
+int SDL_OpenAudio(SDL_AudioSpec *desired, SDL_AudioSpec *obtained)
+{
+    if (_audioOpen)
+    {
+        strncpy(_lastError, "Audio device is already opened", sizeof(_lastError));
+        return -1;
+    }
+    if (desired->format != AUDIO_S16SYS || desired->channels != 2)
+    {
+        strncpy(_lastError, "Only 16-bit stereo audio is supported", sizeof(_lastError));
+        return -1;
+    }
+
+    _audioSpec = *desired;
+    _audioSpec.silence = 0;
+    _audioSpec.size = _audioSpec.samples * _audioSpec.channels * sizeof(Sint16);
+    if (obtained) *obtained = _audioSpec;
+
+    _audioOpen = true;
+    _audioPaused = true;
+    return 0;
+}
+
+void SDL_PauseAudio(int pause_on)
+{
+    _audioPaused = (pause_on != 0);
+}
+
+void SDL_LockAudio(void)
+{
+    pthread_mutex_lock(&_audioLock);
+}
+
+void SDL_UnlockAudio(void)
+{
+    pthread_mutex_unlock(&_audioLock);
+}
+
+void SDL_CloseAudio(void)
+{
+    _audioOpen = false;
+    _audioPaused = true;
+}
+
+Bitu headless_audioSampleRate()
+{
+    return _audioOpen ? _audioSpec.freq : 0;
+}
+
+Bitu headless_pullAudio(Bitu numSampleFrames, FILE *output)
+{
+    if (!_audioOpen || _audioPaused || !_audioSpec.callback) return 0;
+
+    const Bitu bytesPerFrame = _audioSpec.channels * sizeof(Sint16);
+    std::vector<Uint8> buffer(_audioSpec.samples * bytesPerFrame);
+
+    //Pull audio in chunks no larger than the blocksize DOSBox asked for,
+    //as a real audio device would.
+    Bitu remaining = numSampleFrames;
+    while (remaining)
+    {
+        Bitu chunkFrames = (remaining < _audioSpec.samples) ? remaining : _audioSpec.samples;
+        int chunkLength = (int)(chunkFrames * bytesPerFrame);
+
+        SDL_LockAudio();
+        _audioSpec.callback(_audioSpec.userdata, &buffer[0], chunkLength);
+        SDL_UnlockAudio();
+
+        if (output) fwrite(&buffer[0], 1, chunkLength, output);
+
+        remaining -= chunkFrames;
+    }
+    return numSampleFrames;
+}
+
+
+#pragma mark - Threading
+
+struct SDL_mutex {
+    pthread_mutex_t mutex;
+};
+
+SDL_mutex *SDL_CreateMutex(void)
+{
+    SDL_mutex *mutex = new SDL_mutex;
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&mutex->mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    return mutex;
+}
+
+void SDL_DestroyMutex(SDL_mutex *mutex)
+{
+    if (!mutex) return;
+    pthread_mutex_destroy(&mutex->mutex);
+    delete mutex;
+}
+
+int SDL_mutexP(SDL_mutex *mutex)
+{
+    return mutex ? pthread_mutex_lock(&mutex->mutex) : -1;
+}
+
+int SDL_mutexV(SDL_mutex *mutex)
+{
+    return mutex ? pthread_mutex_unlock(&mutex->mutex) : -1;
+}
+
+//Built on a mutex and condition, as Darwin has no unnamed POSIX semaphores.
+struct SDL_sem {
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    Uint32 count;
+};
+
+SDL_sem *SDL_CreateSemaphore(Uint32 initial_value)
+{
+    SDL_sem *sem = new SDL_sem;
+    pthread_mutex_init(&sem->mutex, NULL);
+    pthread_cond_init(&sem->condition, NULL);
+    sem->count = initial_value;
+    return sem;
+}
+
+void SDL_DestroySemaphore(SDL_sem *sem)
+{
+    if (!sem) return;
+    pthread_cond_destroy(&sem->condition);
+    pthread_mutex_destroy(&sem->mutex);
+    delete sem;
+}
+
+int SDL_SemWait(SDL_sem *sem)
+{
+    if (!sem) return -1;
+    pthread_mutex_lock(&sem->mutex);
+    while (!sem->count) pthread_cond_wait(&sem->condition, &sem->mutex);
+    sem->count--;
+    pthread_mutex_unlock(&sem->mutex);
+    return 0;
+}
+
+int SDL_SemPost(SDL_sem *sem)
+{
+    if (!sem) return -1;
+    pthread_mutex_lock(&sem->mutex);
+    sem->count++;
+    pthread_cond_signal(&sem->condition);
+    pthread_mutex_unlock(&sem->mutex);
+    return 0;
+}
+
+struct SDL_Thread {
+    pthread_t thread;
+    int (*function)(void *);
+    void *data;
+    int status;
+};
+
+static void *_runThread(void *context)
+{
+    SDL_Thread *thread = (SDL_Thread *)context;
+    thread->status = thread->function(thread->data);
+    return NULL;
+}
+
+SDL_Thread *SDL_CreateThread(int (*fn)(void *), void *data)
+{
+    SDL_Thread *thread = new SDL_Thread;
+    thread->function = fn;
+    thread->data = data;
+    thread->status = 0;
+    if (pthread_create(&thread->thread, NULL, _runThread, thread) != 0)
+    {
+        delete thread;
+        return NULL;
+    }
+    return thread;
+}
+
+void SDL_WaitThread(SDL_Thread *thread, int *status)
+{
+    if (!thread) return;
+    pthread_join(thread->thread, NULL);
+    if (status) *status = thread->status;
+    delete thread;
+}
+
+
+#pragma mark - CD-ROM
+
+//The headless host has no physical drives: DOSBox will fall back
+//on its image-based CD-ROM emulation for any CD-ROM mounts.
+
+int SDL_CDNumDrives(void)                           { return 0; }
+const char *SDL_CDName(int drive)                   { return NULL; }
+SDL_CD *SDL_CDOpen(int drive)                       { return NULL; }
+CDstatus SDL_CDStatus(SDL_CD *cdrom)                { return CD_ERROR; }
+int SDL_CDPlay(SDL_CD *cdrom, int start, int length){ return -1; }
+int SDL_CDPause(SDL_CD *cdrom)                      { return -1; }
+int SDL_CDResume(SDL_CD *cdrom)                     { return -1; }
+int SDL_CDStop(SDL_CD *cdrom)                       { return -1; }
+int SDL_CDEject(SDL_CD *cdrom)                      { return -1; }
+void SDL_CDClose(SDL_CD *cdrom)                     {}
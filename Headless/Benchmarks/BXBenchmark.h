@@ -0,0 +1,42 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//BXBenchmark holds the helpers every microbenchmark in Benchmarks/ uses: a random number
+//generator that gives the same numbers on every run and host, so that runs can be compared,
+//and a clock to time with.
+
+
+#ifndef BOXER_BENCHMARK_H
+#define BOXER_BENCHMARK_H
+
+#include "dosbox.h"
+#include <time.h>
+
+
+static Bit32u randomSeed = 1;
+
+//Starts the random numbers over from seed, for benchmarks that need the same ones for each run.
+static inline void _seedRandom(Bit32u seed)
+{
+    randomSeed = seed;
+}
+
+static inline Bit32u _random(void)
+{
+    randomSeed = randomSeed * 1103515245 + 12345;
+    return randomSeed >> 8;
+}
+
+//Returns the time in seconds on a clock that only ever counts up, to time with.
+static inline double _seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+#endif
@@ -0,0 +1,378 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Microbenchmark for DOSBox's CPU cores. This runs a set of small real-mode kernels, each
+//exercising a different mix of instructions, through every CPU core in the build, checks
+//that the cores all leave the same registers and memory behind, and reports the time each
+//core took per emulated instruction.
+//To compare the normal core's dispatch modes, build the benchmarks twice:
+//make benchmarks && make BUILDDIR=build-goto CORE_NORMAL_GOTO=1 benchmarks
+
+
+#include "dosbox.h"
+#include "control.h"
+#include "cpu.h"
+#include "regs.h"
+#include "mem.h"
+#include "fpu.h"
+#include "../src/cpu/lazyflags.h"
+#include "BXBenchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//Defined in cpu.cpp.
+#if (C_DYNAMIC_X86)
+void CPU_Core_Dyn_X86_Cache_Init(bool enable_cache);
+#endif
+#if (C_DYNREC)
+void CPU_Core_Dynrec_Cache_Init(bool enable_cache);
+#endif
+
+
+#pragma mark - Kernels
+
+//Each kernel is loaded at 2000:0100 with DS, ES and SS at 3000, and repeats its inner loop
+//of 1000 iterations BP times before halting. Assembled from 16-bit GNU as sources.
+
+static const Bit8u _aluKernel[] = {
+    0xb9, 0xe8, 0x03,                        //0000  movw $0x3e8,%cx
+    0x01, 0xd8,                              //0003  addw %bx,%ax
+    0x11, 0xd6,                              //0005  adcw %dx,%si
+    0x31, 0xc7,                              //0007  xorw %ax,%di
+    0xd1, 0xe3,                              //0009  shlw %bx
+    0xd1, 0xda,                              //000B  rcrw %dx
+    0x29, 0xcb,                              //000D  subw %cx,%bx
+    0x46,                                    //000F  incw %si
+    0x4f,                                    //0010  decw %di
+    0x25, 0xff, 0x7f,                        //0011  andw $0x7fff,%ax
+    0x09, 0xf3,                              //0014  orw %si,%bx
+    0x39, 0xc3,                              //0016  cmpw %ax,%bx
+    0xe2, 0xe9,                              //0018  loopw 3
+    0x4d,                                    //001A  decw %bp
+    0x75, 0xe3,                              //001B  jne 0
+    0xf4,                                    //001D  hlt
+};
+
+static const Bit8u _branchKernel[] = {
+    0xb8, 0xe1, 0xac,                        //0000  movw $0xace1,%ax
+    0xb9, 0xe8, 0x03,                        //0003  movw $0x3e8,%cx
+    0xd1, 0xe8,                              //0006  shrw %ax
+    0x73, 0x03,                              //0008  jae d
+    0x35, 0x00, 0xb4,                        //000A  xorw $0xb400,%ax
+    0xa8, 0x01,                              //000D  testb $0x1,%al
+    0x74, 0x03,                              //000F  je 14
+    0x43,                                    //0011  incw %bx
+    0xeb, 0x01,                              //0012  jmp 15
+    0x4a,                                    //0014  decw %dx
+    0x39, 0xda,                              //0015  cmpw %bx,%dx
+    0x7c, 0x02,                              //0017  jl 1b
+    0x01, 0xce,                              //0019  addw %cx,%si
+    0xf6, 0xc4, 0x04,                        //001B  testb $0x4,%ah
+    0x75, 0x02,                              //001E  jne 22
+    0x29, 0xcf,                              //0020  subw %cx,%di
+    0xe2, 0xe2,                              //0022  loopw 6
+    0x4d,                                    //0024  decw %bp
+    0x75, 0xdc,                              //0025  jne 3
+    0xf4,                                    //0027  hlt
+};
+
+static const Bit8u _memoryKernel[] = {
+    0xb9, 0xe8, 0x03,                        //0000  movw $0x3e8,%cx
+    0x31, 0xf6,                              //0003  xorw %si,%si
+    0xbb, 0x00, 0x01,                        //0005  movw $0x100,%bx
+    0xbf, 0x00, 0x20,                        //0008  movw $0x2000,%di
+    0x8b, 0x00,                              //000B  movw (%bx,%si),%ax
+    0x01, 0x40, 0x02,                        //000D  addw %ax,0x2(%bx,%si)
+    0x89, 0x4f, 0x04,                        //0010  movw %cx,0x4(%bx)
+    0x50,                                    //0013  pushw %ax
+    0xe8, 0x10, 0x00,                        //0014  callw 27
+    0x5a,                                    //0017  popw %dx
+    0x31, 0x15,                              //0018  xorw %dx,(%di)
+    0x83, 0xc6, 0x02,                        //001A  addw $0x2,%si
+    0x81, 0xe6, 0xfe, 0x3f,                  //001D  andw $0x3ffe,%si
+    0xe2, 0xe8,                              //0021  loopw b
+    0x4d,                                    //0023  decw %bp
+    0x75, 0xda,                              //0024  jne 0
+    0xf4,                                    //0026  hlt
+    0x03, 0x3c,                              //0027  addw (%si),%di
+    0x81, 0xe7, 0xfe, 0x3f,                  //0029  andw $0x3ffe,%di
+    0xc3,                                    //002D  retw
+};
+
+static const Bit8u _stringKernel[] = {
+    0xfc,                                    //0000  cld
+    0x31, 0xf6,                              //0001  xorw %si,%si
+    0xbf, 0x00, 0x40,                        //0003  movw $0x4000,%di
+    0xb9, 0x00, 0x01,                        //0006  movw $0x100,%cx
+    0xf3, 0xa5,                              //0009  rep movsw %ds:(%si),%es:(%di)
+    0xbf, 0x00, 0x80,                        //000B  movw $0x8000,%di
+    0xb9, 0x80, 0x00,                        //000E  movw $0x80,%cx
+    0xf3, 0xab,                              //0011  rep stosw %ax,%es:(%di)
+    0x31, 0xf6,                              //0013  xorw %si,%si
+    0xbf, 0x00, 0x40,                        //0015  movw $0x4000,%di
+    0xb9, 0x00, 0x02,                        //0018  movw $0x200,%cx
+    0xf3, 0xa6,                              //001B  repz cmpsb %es:(%di),%ds:(%si)
+    0x31, 0xf6,                              //001D  xorw %si,%si
+    0xb9, 0x40, 0x00,                        //001F  movw $0x40,%cx
+    0xac,                                    //0022  lodsb %ds:(%si),%al
+    0x00, 0xc3,                              //0023  addb %al,%bl
+    0xe2, 0xfb,                              //0025  loopw 22
+    0x40,                                    //0027  incw %ax
+    0x4d,                                    //0028  decw %bp
+    0x75, 0xd5,                              //0029  jne 0
+    0xf4,                                    //002B  hlt
+};
+
+static const Bit8u _dwordKernel[] = {
+    0xb9, 0xe8, 0x03,                        //0000  movw $0x3e8,%cx
+    0x66, 0x01, 0xd8,                        //0003  addl %ebx,%eax
+    0x66, 0x0f, 0xaf, 0xc6,                  //0006  imull %esi,%eax
+    0x66, 0x0f, 0xb6, 0xd0,                  //000A  movzbl %al,%edx
+    0x66, 0x0f, 0xa4, 0xc3, 0x03,            //000E  shldl $0x3,%eax,%ebx
+    0x66, 0x0f, 0xa3, 0xc8,                  //0013  btl %ecx,%eax
+    0x0f, 0x92, 0xc2,                        //0017  setb %dl
+    0x66, 0x01, 0xd6,                        //001A  addl %edx,%esi
+    0x66, 0xc1, 0xc8, 0x05,                  //001D  rorl $0x5,%eax
+    0x67, 0x66, 0x8d, 0x7c, 0x5e, 0x01,      //0021  leal 0x1(%esi,%ebx,2),%edi
+    0x66, 0x31, 0xfb,                        //0027  xorl %edi,%ebx
+    0xe2, 0xd7,                              //002A  loopw 3
+    0x4d,                                    //002C  decw %bp
+    0x75, 0xd1,                              //002D  jne 0
+    0xf4,                                    //002F  hlt
+};
+
+static const Bit8u _muldivKernel[] = {
+    0xbf, 0x01, 0x00,                        //0000  movw $0x1,%di
+    0xb9, 0xe8, 0x03,                        //0003  movw $0x3e8,%cx
+    0x89, 0xc8,                              //0006  movw %cx,%ax
+    0xf7, 0xe7,                              //0008  mulw %di
+    0x01, 0xc6,                              //000A  addw %ax,%si
+    0x89, 0xf0,                              //000C  movw %si,%ax
+    0x31, 0xd2,                              //000E  xorw %dx,%dx
+    0xf7, 0xf1,                              //0010  divw %cx
+    0x01, 0xd7,                              //0012  addw %dx,%di
+    0x66, 0x89, 0xf8,                        //0014  movl %edi,%eax
+    0x66, 0x0f, 0xaf, 0xc0,                  //0017  imull %eax,%eax
+    0x66, 0x31, 0xd2,                        //001B  xorl %edx,%edx
+    0x66, 0xf7, 0xf1,                        //001E  divl %ecx
+    0x66, 0x01, 0xc3,                        //0021  addl %eax,%ebx
+    0xe2, 0xe0,                              //0024  loopw 6
+    0x4d,                                    //0026  decw %bp
+    0x75, 0xda,                              //0027  jne 3
+    0xf4,                                    //0029  hlt
+};
+
+static const Bit8u _fpuKernel[] = {
+    0xdb, 0xe3,                              //0000  fninit
+    0xd9, 0xe8,                              //0002  fld1
+    0xd9, 0xee,                              //0004  fldz
+    0xb9, 0xe8, 0x03,                        //0006  movw $0x3e8,%cx
+    0x89, 0x0e, 0x00, 0x01,                  //0009  movw %cx,0x100
+    0xde, 0x06, 0x00, 0x01,                  //000D  fiadds 0x100
+    0xd8, 0xc9,                              //0011  fmul %st(1),%st
+    0xd9, 0xfa,                              //0013  fsqrt
+    0xd8, 0xc1,                              //0015  fadd %st(1),%st
+    0xdd, 0x16, 0x08, 0x01,                  //0017  fstl 0x108
+    0xde, 0x36, 0x04, 0x01,                  //001B  fidivs 0x104
+    0xd9, 0xc0,                              //001F  fld %st(0)
+    0xde, 0xc9,                              //0021  fmulp %st,%st(1)
+    0xd8, 0xe1,                              //0023  fsub %st(1),%st
+    0xd9, 0xe1,                              //0025  fabs
+    0xe2, 0xe0,                              //0027  loopw 9
+    0x4d,                                    //0029  decw %bp
+    0x75, 0xda,                              //002A  jne 6
+    0xf4,                                    //002C  hlt
+};
+
+typedef struct {
+    const char *name;
+    const Bit8u *code;
+    Bitu length;
+} BXCPUKernel;
+
+#define BXCPUKernelMake(name) { #name, _ ## name ## Kernel, sizeof(_ ## name ## Kernel) }
+
+static const BXCPUKernel kernels[] = {
+    BXCPUKernelMake(alu),
+    BXCPUKernelMake(branch),
+    BXCPUKernelMake(memory),
+    BXCPUKernelMake(string),
+    BXCPUKernelMake(dword),
+    BXCPUKernelMake(muldiv),
+    BXCPUKernelMake(fpu),
+};
+
+#define BXCPUCodeSegment 0x2000
+#define BXCPUDataSegment 0x3000
+
+
+#pragma mark - Cores
+
+typedef struct {
+    const char *name;
+    CPU_Decoder *run;
+} BXCPUCore;
+
+static const BXCPUCore cores[] = {
+#if (C_CORE_NORMAL_GOTO) && defined(__GNUC__)
+    { "normal(goto)",   CPU_Core_Normal_Run },
+#else
+    { "normal(switch)", CPU_Core_Normal_Run },
+#endif
+    { "simple",         CPU_Core_Simple_Run },
+    { "full",           CPU_Core_Full_Run },
+#if (C_DYNAMIC_X86)
+    { "dynamic",        CPU_Core_Dyn_X86_Run },
+#elif (C_DYNREC)
+    { "dynamic",        CPU_Core_Dynrec_Run },
+#endif
+};
+
+#define BXCPUCoreCount (sizeof(cores) / sizeof(cores[0]))
+
+
+#pragma mark - Running kernels
+
+//The state a kernel leaves behind, which should be the same whichever core ran it.
+typedef struct {
+    Bit32u regs[8];
+    Bit32u eip;
+    Bit32u flags;
+    Bit32u memoryHash;
+    Bit64u fpuHash;
+} BXCPUState;
+
+static void _loadKernel(const BXCPUKernel &kernel, Bitu repeats)
+{
+    //Fill the data segment with the same pseudorandom words before each run.
+    Bit32u seed = 1;
+    for (Bitu offset=0; offset < 0x10000; offset += 2)
+    {
+        seed = seed * 1103515245 + 12345;
+        mem_writew((BXCPUDataSegment << 4) + offset, (Bit16u)((seed >> 16) | 1));
+    }
+    MEM_BlockWrite((BXCPUCodeSegment << 4) + 0x100, kernel.code, kernel.length);
+
+    for (Bitu i=0; i < 8; i++) cpu_regs.regs[i].dword[DW_INDEX] = 0;
+    reg_ebp = (Bit32u)repeats;
+    reg_esp = 0xFFFE;
+    reg_eip = 0x100;
+    SegSet16(cs, BXCPUCodeSegment);
+    SegSet16(ds, BXCPUDataSegment);
+    SegSet16(es, BXCPUDataSegment);
+    SegSet16(ss, BXCPUDataSegment);
+    //Interrupts stay disabled so that the kernel runs uninterrupted.
+    CPU_SetFlags(0, FMASK_ALL);
+    lflags.type = t_UNKNOWN;
+    FPU_SetTag(0xFFFF);
+}
+
+static void _captureState(BXCPUState *state)
+{
+    for (Bitu i=0; i < 8; i++) state->regs[i] = cpu_regs.regs[i].dword[DW_INDEX];
+    state->eip = reg_eip;
+    state->flags = reg_flags & FMASK_TEST;
+
+    Bit32u hash = 2166136261U;
+    for (Bitu offset=0; offset < 0x10000; offset++)
+        hash = (hash ^ mem_readb((BXCPUDataSegment << 4) + offset)) * 16777619U;
+    state->memoryHash = hash;
+
+    Bit64u fpuHash = TOP;
+    for (Bitu i=0; i < 8; i++) fpuHash = fpuHash * 31 + *(Bit64u *)&fpu.regs[i].d;
+    state->fpuHash = fpuHash;
+}
+
+//Runs the kernel to completion on the specified core and returns the time it took.
+//instructions is set to the number of cycles the core counted along the way.
+static double _run(const BXCPUCore &core, const BXCPUKernel &kernel, Bitu repeats, Bit64u *instructions, BXCPUState *state)
+{
+    const Bits slice = 100000;
+    _loadKernel(kernel, repeats);
+    cpudecoder = core.run;
+    *instructions = 0;
+
+    double start = _seconds();
+
+    //The kernel ends with HLT, which switches cpudecoder over to the HLT decoder.
+    //The dynamic cores hand some instructions to the normal core with CPU_Cycles set to 1,
+    //parking the rest of the slice in CPU_CycleLeft: this refills from there as the PIC does.
+    CPU_Cycles = 0;
+    CPU_CycleLeft = 0;
+    while (cpudecoder == core.run)
+    {
+        if (CPU_Cycles <= 0)
+        {
+            CPU_Cycles = (CPU_CycleLeft > 0) ? CPU_CycleLeft : slice;
+            CPU_CycleLeft = 0;
+        }
+        Bits budget = CPU_Cycles + CPU_CycleLeft;
+        Bit64s halted = CPU_HaltedCyclesSkipped;
+        (*cpudecoder)();
+        *instructions += budget - (CPU_Cycles + CPU_CycleLeft) - (CPU_HaltedCyclesSkipped - halted);
+    }
+
+    double seconds = _seconds() - start;
+    _captureState(state);
+    return seconds;
+}
+
+
+int main(int argc, char *argv[])
+{
+    Bitu repeats = (argc > 1) ? atoi(argv[1]) : 2000;
+
+    //Set up DOSBox's modules with their default settings, without starting the shell.
+    char const *emptyArgv[1] = { NULL };
+    CommandLine commandLine(0, emptyArgv);
+    Config configuration(&commandLine);
+    control = &configuration;
+    DOSBOX_Init();
+    control->Init();
+
+#if (C_DYNAMIC_X86)
+    CPU_Core_Dyn_X86_Cache_Init(true);
+#elif (C_DYNREC)
+    CPU_Core_Dynrec_Cache_Init(true);
+#endif
+
+    bool allMatched = true;
+    printf("%-8s %12s", "kernel", "instructions");
+    for (Bitu c=0; c < BXCPUCoreCount; c++) printf(" %15s", cores[c].name);
+    printf(" %s\n", "state");
+
+    for (unsigned int k=0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+        double nanoseconds[BXCPUCoreCount];
+        BXCPUState states[BXCPUCoreCount];
+        Bit64u referenceInstructions = 0;
+        bool matched = true;
+
+        for (Bitu c=0; c < BXCPUCoreCount; c++)
+        {
+            Bit64u instructions;
+            double time = _run(cores[c], kernels[k], repeats, &instructions, &states[c]);
+
+            //Timings are per instruction as counted by the first core: the dynamic cores
+            //count cycles per block, which doesn't always match the instruction count.
+            if (!c) referenceInstructions = instructions ? instructions : 1;
+            nanoseconds[c] = time * 1e9 / referenceInstructions;
+            if (c && memcmp(&states[c], &states[0], sizeof(BXCPUState))) matched = false;
+        }
+        allMatched &= matched;
+
+        printf("%-8s %12llu", kernels[k].name, (unsigned long long)referenceInstructions);
+        for (Bitu c=0; c < BXCPUCoreCount; c++) printf(" %12.2f ns", nanoseconds[c]);
+        printf(" %s\n", matched ? "match" : "DIFFER");
+    }
+
+    control = NULL;
+    return allMatched ? EXIT_SUCCESS : EXIT_FAILURE;
+}
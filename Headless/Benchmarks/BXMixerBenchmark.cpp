@@ -0,0 +1,174 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Differential test and microbenchmark for the sample conversion, resampling and clipping
+//mixer.cpp does for its channels. This mixes blocks of random samples in every format the
+//channels use, at random rates and volumes and at random places in the mix buffer (including
+//ones that wrap around the end of it), with both the plain C and the vector versions, checks
+//that they mix exactly the same samples and leave the channel in the same state, and reports
+//the time each took.
+
+
+#include "dosbox.h"
+#include "mem.h"
+#include "mixer.h"
+#include "mixer_simd.h"
+#include "BXMixerFormats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define BXMixerChecks 4000
+
+
+#pragma mark - Formats
+
+//The state a channel carries from one block to the next.
+typedef struct {
+    Bits last[2];
+    Bitu freqIndex;
+} BXMixerState;
+
+typedef Bitu (*BXMixerFunction)(Bit32s (*work)[2], Bitu mixpos, Bitu len, const Bit8u *data,
+                                Bits *last, Bitu &freq_index, Bitu freq_add, const Bit32s *volmul);
+
+typedef struct {
+    const char *name;
+    BXMixerFunction reference;
+    BXMixerFunction vector;
+} BXMixerFormat;
+
+//Calls the version of the mixer for a format with untyped source data.
+template<class Type,bool stereo,bool signeddata,bool nativeorder,bool vector>
+static Bitu _mix(Bit32s (*work)[2], Bitu mixpos, Bitu len, const Bit8u *data,
+                 Bits *last, Bitu &freq_index, Bitu freq_add, const Bit32s *volmul)
+{
+    if (vector) return MIXER_AddSamples<Type,stereo,signeddata,nativeorder>(work, mixpos, len, (const Type *)data, last, freq_index, freq_add, volmul);
+    else return MIXER_AddSamples_C<Type,stereo,signeddata,nativeorder>(work, mixpos, len, (const Type *)data, last, freq_index, freq_add, volmul);
+}
+
+typedef void (*BXMixerClipper)(Bit16s (*dest)[2], const Bit32s (*src)[2], Bitu count);
+
+#define BXMixerFormat(_NAME, _TYPE, _STEREO, _SIGNED, _NATIVE) \
+    { _NAME, _mix<_TYPE,_STEREO,_SIGNED,_NATIVE,false>, _mix<_TYPE,_STEREO,_SIGNED,_NATIVE,true> }
+
+static const BXMixerFormat formats[] = { BXMixerFormats(BXMixerFormat) };
+
+
+#pragma mark - Checking and timing
+
+//Mixes random blocks with both versions and returns whether they all matched.
+static bool _check(const BXMixerFormat &format)
+{
+    for (Bitu i=0; i < BXMixerChecks; i++)
+    {
+        BXMixerBlock block = _randomBlock(i);
+
+        BXMixerState start;
+        start.last[0] = (Bit16s)_random();
+        start.last[1] = (Bit16s)_random();
+        start.freqIndex = _random();
+        BXMixerState reference = start, vector = start;
+
+        Bitu referenceDone = format.reference(referenceWork, block.mixpos, block.len, source, reference.last, reference.freqIndex, block.freqAdd, block.volmul);
+        Bitu vectorDone = format.vector(vectorWork, block.mixpos, block.len, source, vector.last, vector.freqIndex, block.freqAdd, block.volmul);
+
+        bool stateMatches = reference.last[0] == vector.last[0] && reference.last[1] == vector.last[1] &&
+            reference.freqIndex == vector.freqIndex;
+        if (!_blockMatches(format.name, block, referenceDone, vectorDone, stateMatches)) return false;
+    }
+    return true;
+}
+
+static bool _checkClip(void)
+{
+    static Bit16s reference[BXMixerMaxSamples + 1][2], vector[BXMixerMaxSamples + 1][2];
+
+    for (Bitu i=0; i < BXMixerChecks; i++)
+    {
+        Bitu count = _random() % BXMixerMaxSamples;
+        for (Bitu s=0; s < count; s++)
+        {
+            //Mostly in range, with the odd one well outside it.
+            Bitu spread = (_random() & 15) ? 0xfffffff : 0xffffffff;
+            referenceWork[s][0] = (Bit32s)(_random() * 511 & spread) - (Bit32s)(spread >> 1);
+            referenceWork[s][1] = (Bit32s)(_random() * 511 & spread) - (Bit32s)(spread >> 1);
+        }
+        //Fill one past the end to catch either version clipping too much.
+        memset(reference, 0xAA, sizeof(reference));
+        memset(vector, 0xAA, sizeof(vector));
+        MIXER_Clip_C(reference, referenceWork, count);
+        MIXER_Clip(vector, referenceWork, count);
+        if (memcmp(reference, vector, sizeof(reference)))
+        {
+            printf("clip differs at count %lu\n", (unsigned long)count);
+            return false;
+        }
+    }
+    return true;
+}
+
+//Returns the average time in microseconds to mix ten ticks' worth of samples from a 22kHz channel.
+static double _time(BXMixerFunction mix, Bitu repeats)
+{
+    const Bitu rate = 22050;
+    const Bitu freqAdd = (rate << MIXER_SHIFT) / BXMixerRate;
+    const Bitu len = (BXMixerTickSamples * rate) / BXMixerRate;
+    const Bit32s volmul[2] = { 1 << MIXER_VOLSHIFT, 1 << MIXER_VOLSHIFT };
+    BXMixerState state = { { 0, 0 }, 0 };
+    Bitu mixpos = 0;
+
+    double start = _seconds();
+    for (Bitu i=0; i < repeats; i++)
+    {
+        mixpos += mix(vectorWork, mixpos, len, source, state.last, state.freqIndex, freqAdd, volmul);
+    }
+    return (_seconds() - start) * 1e6 / repeats;
+}
+
+static double _timeClip(BXMixerClipper clip, Bitu repeats)
+{
+    static Bit16s output[BXMixerTickSamples][2];
+    double start = _seconds();
+    for (Bitu i=0; i < repeats; i++)
+    {
+        clip(output, &vectorWork[(i * BXMixerTickSamples) & (MIXER_BUFMASK & ~1023)], BXMixerTickSamples);
+    }
+    return (_seconds() - start) * 1e6 / repeats;
+}
+
+
+int main(int argc, char *argv[])
+{
+    Bitu repeats = (argc > 1) ? atoi(argv[1]) : 100000;
+
+    _fillSource();
+
+    printf("%-8s %10s %10s %s\n", "format", "c", "vector", "output");
+
+    bool allMatched = true;
+    for (unsigned int f=0; f < sizeof(formats) / sizeof(formats[0]); f++)
+    {
+        const BXMixerFormat &format = formats[f];
+        bool matched = _check(format);
+        allMatched &= matched;
+
+        double reference = _time(format.reference, repeats);
+        double vector = _time(format.vector, repeats);
+        printf("%-8s %7.3f us %7.3f us %s\n", format.name, reference, vector, matched ? "match" : "DIFFER");
+    }
+
+    bool matched = _checkClip();
+    allMatched &= matched;
+    double reference = _timeClip(MIXER_Clip_C, repeats);
+    double vector = _timeClip(MIXER_Clip, repeats);
+    printf("%-8s %7.3f us %7.3f us %s\n", "clip", reference, vector, matched ? "match" : "DIFFER");
+
+    return allMatched ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,107 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//BXMixerFormats holds what the mixer and resampler benchmarks share: the sample formats and
+//rates the mixer channels play at, the random source samples and mix buffers, and the random
+//blocks that both the plain C and the vector versions of a function get mixed in.
+
+
+#ifndef BOXER_MIXER_FORMATS_H
+#define BOXER_MIXER_FORMATS_H
+
+#include "BXBenchmark.h"
+#include "mixer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define BXMixerMaxSamples 2048
+
+//The rate the mixer runs at, and ten ticks' worth of mixing at it.
+#define BXMixerRate 44100
+#define BXMixerTickSamples 441
+
+
+static Bit8u source[BXMixerMaxSamples * 2 * 4];
+static Bit32s referenceWork[MIXER_BUFSIZE][2], vectorWork[MIXER_BUFSIZE][2];
+
+
+#pragma mark - Formats
+
+//The formats MixerChannel::AddSamples_* mix. Each benchmark defines _FORMAT to make its own
+//table entry from the name, sample type, and whether the samples are stereo, signed and in the
+//host's byte order.
+#define BXMixerFormats(_FORMAT) \
+    _FORMAT("m8",         Bit8u,  false,  false,  true), \
+    _FORMAT("s8",         Bit8u,  true,   false,  true), \
+    _FORMAT("m8s",        Bit8s,  false,  true,   true), \
+    _FORMAT("s8s",        Bit8s,  true,   true,   true), \
+    _FORMAT("m16",        Bit16s, false,  true,   true), \
+    _FORMAT("s16",        Bit16s, true,   true,   true), \
+    _FORMAT("m16u",       Bit16u, false,  false,  true), \
+    _FORMAT("s16u",       Bit16u, true,   false,  true), \
+    _FORMAT("m32",        Bit32s, false,  true,   true), \
+    _FORMAT("s32",        Bit32s, true,   true,   true), \
+    _FORMAT("m16_nn",     Bit16s, false,  true,   false), \
+    _FORMAT("s16_nn",     Bit16s, true,   true,   false), \
+    _FORMAT("m16u_nn",    Bit16u, false,  false,  false), \
+    _FORMAT("s16u_nn",    Bit16u, true,   false,  false)
+
+//The rates channels play at: the Sound Blaster's, the GUS's, the OPL's and the mixer's own.
+static const Bitu rates[] = { 4000, 11025, 22050, 32000, 44100, 48000, 49716, 88200 };
+
+
+#pragma mark - Checking
+
+//A random block of samples to mix with both versions.
+typedef struct {
+    Bitu rate;
+    Bitu freqAdd;
+    Bitu len;
+    Bitu mixpos;
+    Bit32s volmul[2];
+} BXMixerBlock;
+
+static void _fillSource(void)
+{
+    for (Bitu i=0; i < sizeof(source); i++) source[i] = _random();
+}
+
+//Picks the block for the ith check, and fills both mix buffers with the same random samples.
+static BXMixerBlock _randomBlock(Bitu i)
+{
+    BXMixerBlock block;
+    block.rate = (i & 3) ? rates[_random() % (sizeof(rates) / sizeof(rates[0]))] : 1000 + _random() % 90000;
+    block.freqAdd = (block.rate << MIXER_SHIFT) / BXMixerRate;
+    block.len = _random() % BXMixerMaxSamples;
+    //Start close to the end of the mix buffer often enough to test wrapping around it.
+    block.mixpos = (i & 1) ? MIXER_BUFSIZE - (_random() % 64) : _random();
+    //Volumes well past 100% too, as the MIXER command allows.
+    block.volmul[0] = (Bit32s)(_random() % 65536);
+    block.volmul[1] = (Bit32s)(_random() % 8193);
+
+    for (Bitu s=0; s < MIXER_BUFSIZE; s++)
+    {
+        referenceWork[s][0] = vectorWork[s][0] = _random();
+        referenceWork[s][1] = vectorWork[s][1] = _random();
+    }
+    return block;
+}
+
+//Returns whether both versions mixed the block into the same samples, and reports it if not.
+static bool _blockMatches(const char *name, const BXMixerBlock &block, Bitu referenceDone, Bitu vectorDone, bool stateMatches)
+{
+    if (referenceDone == vectorDone && stateMatches && !memcmp(referenceWork, vectorWork, sizeof(referenceWork)))
+        return true;
+
+    printf("%s differs at rate %lu len %lu mixpos %lu\n", name,
+           (unsigned long)block.rate, (unsigned long)block.len, (unsigned long)block.mixpos);
+    return false;
+}
+
+#endif
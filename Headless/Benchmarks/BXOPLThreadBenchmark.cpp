@@ -0,0 +1,340 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Differential test and microbenchmark for the OPL synthesis thread that oplthread turns on.
+//This plays the same random register writes, made at the start of each tick or at random
+//cycles within it, through the DBOPL handler that synthesises on the emulation thread and
+//through the threaded one in dbopl_thread.h. It checks that the threaded output is exactly
+//what the plain chip renders with every write landed on the sample it was stamped with, and
+//reports how far it matches the emulation-thread handler, which lands every write at the start
+//of the tick it was made in, once both are lined up for the thread's latency. It also reports
+//the time the emulation thread spent on each.
+
+
+#include <math.h>
+#include "dosbox.h"
+#include "pic.h"
+#include "SDL.h"
+#include "dbopl.h"
+#include "dbopl_thread.h"
+#include "BXBenchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+
+//The cycles per tick the writes are spread over.
+#define BXOPLCyclesPerTick 20000
+
+
+#pragma mark - Register writes
+
+typedef struct {
+    Bitu tick;
+    Bits cycle;
+    Bit32u reg;
+    Bit8u val;
+} BXOPLWrite;
+
+typedef struct {
+    const char *name;
+    Bitu rate;
+    bool opl3;
+    bool timestamped;
+} BXOPLMix;
+
+static std::vector<BXOPLWrite> writes;
+
+//Queues writes for one tick, at the start of it or at random cycles in order through it.
+static void _addWrites(bool timestamped, Bitu tick, const BXOPLWrite *tickWrites, Bitu count)
+{
+    std::vector<Bits> cycles(count, 0);
+    if (timestamped)
+    {
+        for (Bitu i=0; i < count; i++) cycles[i] = _random() % BXOPLCyclesPerTick;
+        std::sort(cycles.begin(), cycles.end());
+    }
+    for (Bitu i=0; i < count; i++)
+    {
+        BXOPLWrite write = tickWrites[i];
+        write.tick = tick;
+        write.cycle = cycles[i];
+        writes.push_back(write);
+    }
+}
+
+//Sets up an instrument on every channel at the start of the first tick, then keys notes on and
+//off, changes their volumes and plays the rhythm section at random for as many ticks as asked.
+static void _makeWrites(const BXOPLMix &mix, Bitu ticks)
+{
+    writes.clear();
+    _seedRandom(1);
+
+    std::vector<BXOPLWrite> setup;
+    BXOPLWrite write = { 0, 0, 0, 0 };
+    if (mix.opl3)
+    {
+        write.reg = 0x105; write.val = 1; setup.push_back(write);
+    }
+    write.reg = 0x01; write.val = 0x20; setup.push_back(write);
+    for (Bitu bank=0; bank <= (mix.opl3 ? 0x100u : 0u); bank += 0x100)
+    {
+        for (Bitu channel=0; channel < 9; channel++)
+        {
+            Bitu slot = (channel / 3) * 8 + (channel % 3);
+            for (Bitu op=0; op < 2; op++, slot += 3)
+            {
+                write.reg = bank + 0x20 + slot; write.val = _random(); setup.push_back(write);
+                write.reg = bank + 0x40 + slot; write.val = _random() % 48; setup.push_back(write);
+                write.reg = bank + 0x60 + slot; write.val = 0x80 | _random(); setup.push_back(write);
+                write.reg = bank + 0x80 + slot; write.val = _random(); setup.push_back(write);
+                write.reg = bank + 0xe0 + slot; write.val = _random() % (mix.opl3 ? 8 : 4); setup.push_back(write);
+            }
+            write.reg = bank + 0xc0 + channel; write.val = 0x30 | (_random() & 0x0f); setup.push_back(write);
+        }
+    }
+    _addWrites(false, 0, &setup[0], setup.size());
+
+    for (Bitu tick=1; tick < ticks; tick++)
+    {
+        if (_random() % 8) continue;
+
+        BXOPLWrite tickWrites[6];
+        Bitu count = 1 + _random() % 3;
+        Bitu used = 0;
+        for (Bitu i=0; i < count; i++)
+        {
+            Bitu bank = (mix.opl3 && (_random() & 1)) ? 0x100 : 0;
+            Bitu channel = _random() % 9;
+            switch (_random() % 8)
+            {
+                case 0: case 1: case 2: case 3:
+                    tickWrites[used].reg = bank + 0xa0 + channel; tickWrites[used++].val = _random();
+                    tickWrites[used].reg = bank + 0xb0 + channel; tickWrites[used++].val = 0x20 | (_random() & 0x1f);
+                    break;
+                case 4: case 5:
+                    tickWrites[used].reg = bank + 0xb0 + channel; tickWrites[used++].val = _random() & 0x1f;
+                    break;
+                case 6:
+                    tickWrites[used].reg = bank + 0x43 + (channel / 3) * 8 + (channel % 3); tickWrites[used++].val = _random() % 64;
+                    break;
+                default:
+                    tickWrites[used].reg = 0xbd; tickWrites[used++].val = _random();
+                    break;
+            }
+        }
+        _addWrites(mix.timestamped, tick, tickWrites, used);
+    }
+}
+
+//Sets the CPU up as the emulation thread would be when making a write.
+static void _setCycle(Bits cycle)
+{
+    CPU_CycleMax = BXOPLCyclesPerTick;
+    CPU_CycleLeft = BXOPLCyclesPerTick - cycle;
+    CPU_Cycles = 0;
+}
+
+static Bitu _tickSamples(const BXOPLMix &mix, Bitu tick)
+{
+    return ((tick + 1) * mix.rate) / 1000 - (tick * mix.rate) / 1000;
+}
+
+
+#pragma mark - Synthesis
+
+//Renders samples from the chip as the synthesis thread does, doubling opl2 output up into stereo.
+static void _render(DBOPL::Chip &chip, Bitu samples, Bit32s (*output)[2])
+{
+    Bit32s mono[OPL_BLOCK];
+    while (samples)
+    {
+        Bitu todo = (samples > OPL_BLOCK) ? OPL_BLOCK : samples;
+        if (chip.opl3Active) chip.GenerateBlock3(todo, output[0]);
+        else
+        {
+            chip.GenerateBlock2(todo, mono);
+            for (Bitu i=0; i < todo; i++) output[i][0] = output[i][1] = mono[i];
+        }
+        output += todo;
+        samples -= todo;
+    }
+}
+
+//Plays the writes through the emulation-thread handler, landing each at the start of its tick.
+//The chip first renders latency samples that are thrown away, as the thread's does before the
+//first writes land, so that their free-running tremolo, vibrato and noise line up.
+static double _runHandler(const BXOPLMix &mix, Bitu ticks, Bitu latency, std::vector<Bit32s> &output)
+{
+    DBOPL::Handler *handler = new DBOPL::Handler();
+    handler->Init(mix.rate);
+    std::vector<Bit32s> unheard(latency * 2 + 2);
+    _render(handler->chip, latency, (Bit32s (*)[2])&unheard[0]);
+
+    double start = _seconds();
+    Bitu next = 0, pos = 0;
+    for (Bitu tick=0; tick < ticks; tick++)
+    {
+        for (; next < writes.size() && writes[next].tick == tick; next++)
+        {
+            _setCycle(writes[next].cycle);
+            handler->WriteReg(writes[next].reg, writes[next].val);
+        }
+        Bitu samples = _tickSamples(mix, tick);
+        _render(handler->chip, samples, (Bit32s (*)[2])&output[pos * 2]);
+        pos += samples;
+    }
+    double time = _seconds() - start;
+
+    delete handler;
+    return time;
+}
+
+//Plays the writes through the threaded handler, taking each tick's samples as the mixer would.
+static double _runThreaded(const BXOPLMix &mix, Bitu ticks, std::vector<Bit32s> &output, Bitu &latency)
+{
+    DBOPL::ThreadedHandler *handler = new DBOPL::ThreadedHandler();
+    handler->Init(mix.rate);
+    latency = handler->latency;
+
+    double start = _seconds();
+    Bitu next = 0, pos = 0;
+    for (Bitu tick=0; tick < ticks; tick++)
+    {
+        for (; next < writes.size() && writes[next].tick == tick; next++)
+        {
+            _setCycle(writes[next].cycle);
+            handler->WriteReg(writes[next].reg, writes[next].val);
+        }
+        Bitu samples = _tickSamples(mix, tick);
+        handler->Take(samples, (Bit32s (*)[2])&output[pos * 2]);
+        pos += samples;
+    }
+    double time = _seconds() - start;
+
+    delete handler;
+    return time;
+}
+
+//Renders the chip up to the sample given, or no earlier than the last one.
+static void _renderTo(DBOPL::Chip &chip, Bitu stamp, Bitu &pos, Bitu &lastStamp, std::vector<Bit32s> &output)
+{
+    if (stamp < lastStamp) stamp = lastStamp;
+    lastStamp = stamp;
+    if (stamp > output.size() / 2) stamp = output.size() / 2;
+
+    _render(chip, stamp - pos, (Bit32s (*)[2])&output[pos * 2]);
+    pos = stamp;
+}
+
+//Renders what the threaded handler should: the writes landed on exactly the samples it stamps
+//them with, latency samples after the start of the tick they were made in plus as far into the
+//tick as they were made, in blocks that end latency samples after each tick's do.
+static void _runExact(const BXOPLMix &mix, Bitu ticks, Bitu latency, std::vector<Bit32s> &output)
+{
+    DBOPL::Handler *handler = new DBOPL::Handler();
+    handler->Init(mix.rate);
+
+    double tickSamples = mix.rate / 1000.0;
+    Bitu next = 0, pos = 0, tickStart = 0, lastStamp = 0;
+    for (Bitu tick=0; tick < ticks; tick++)
+    {
+        for (; next < writes.size() && writes[next].tick == tick; next++)
+        {
+            _setCycle(writes[next].cycle);
+            _renderTo(handler->chip, tickStart + latency + (Bitu)(PIC_TickIndex() * tickSamples), pos, lastStamp, output);
+            handler->WriteReg(writes[next].reg, writes[next].val);
+        }
+        tickStart += _tickSamples(mix, tick);
+        _renderTo(handler->chip, tickStart + latency, pos, lastStamp, output);
+    }
+    _renderTo(handler->chip, output.size() / 2, pos, lastStamp, output);
+
+    delete handler;
+}
+
+//Returns the first sample at which the threaded output, lined up for its latency, differs from
+//the other, or how many samples there were if it never does.
+static Bitu _firstDifference(const std::vector<Bit32s> &threaded, const std::vector<Bit32s> &other, Bitu latency)
+{
+    Bitu total = threaded.size() / 2;
+    for (Bitu i=0; i + latency < total; i++)
+    {
+        if (threaded[(i + latency) * 2] != other[i * 2] || threaded[(i + latency) * 2 + 1] != other[i * 2 + 1])
+            return i;
+    }
+    return total;
+}
+
+
+int main(int argc, char *argv[])
+{
+    Bitu ticks = (argc > 1) ? atoi(argv[1]) : 30000;
+
+    const BXOPLMix mixes[] = {
+        { "opl2 at tick start",     44100,  false,  false },
+        { "opl2 timestamped",       44100,  false,  true  },
+        { "opl3 timestamped",       49716,  true,   true  },
+    };
+
+    bool allMatched = true;
+    printf("%-20s %9s %8s %12s %12s %18s %12s %12s\n", "mix", "samples", "latency", "exact", "tick start",
+           "first mid-tick", "handler ms", "threaded ms");
+    for (unsigned int i=0; i < sizeof(mixes) / sizeof(mixes[0]); i++)
+    {
+        const BXOPLMix &mix = mixes[i];
+        _makeWrites(mix, ticks);
+
+        Bitu total = (ticks * mix.rate) / 1000;
+        std::vector<Bit32s> handlerOutput(total * 2), threadedOutput(total * 2), exactOutput(total * 2);
+        Bitu latency = 0;
+        double threadedTime = _runThreaded(mix, ticks, threadedOutput, latency);
+        double handlerTime = _runHandler(mix, ticks, latency, handlerOutput);
+        _runExact(mix, ticks, latency, exactOutput);
+
+        //The threaded output has to be exactly what the chip renders with every write landed
+        //where it was stamped...
+        bool exact = !memcmp(&threadedOutput[0], &exactOutput[0], total * 2 * sizeof(Bit32s));
+
+        //...and the same as the emulation-thread handler's, lined up for the latency, until the
+        //first write that lands further into its tick than the start.
+        Bitu firstMidTick = total;
+        for (Bitu w=0; w < writes.size(); w++)
+        {
+            _setCycle(writes[w].cycle);
+            if ((Bitu)(PIC_TickIndex() * (mix.rate / 1000.0)))
+            {
+                firstMidTick = (writes[w].tick * mix.rate) / 1000;
+                break;
+            }
+        }
+        Bitu difference = _firstDifference(threadedOutput, handlerOutput, latency);
+        bool matched = exact && difference >= firstMidTick;
+        allMatched &= matched;
+
+        char tickStart[32];
+        if (difference + latency >= total) snprintf(tickStart, sizeof(tickStart), "match");
+        else snprintf(tickStart, sizeof(tickStart), "from %lu", (unsigned long)difference);
+        char midTick[32];
+        if (firstMidTick == total) snprintf(midTick, sizeof(midTick), "none");
+        else snprintf(midTick, sizeof(midTick), "tick at %lu", (unsigned long)firstMidTick);
+
+        printf("%-20s %9lu %8lu %12s %12s %18s %12.1f %12.1f\n",
+               mix.name,
+               (unsigned long)total,
+               (unsigned long)latency,
+               exact ? "match" : "DIFFER",
+               tickStart,
+               midTick,
+               handlerTime * 1e3,
+               threadedTime * 1e3);
+    }
+    return allMatched ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,391 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Microbenchmark for DOSBox's PIC event queue. This replays the same synthetic event mixes
+//through the queue in pic.cpp, which turns into a heap once it gets long, and through a copy
+//of the sorted linked list it replaced, checks that both fire the same events at the same cycles, and reports the time
+//each one took.
+
+
+#include "dosbox.h"
+#include "pic.h"
+#include "timer.h"
+#include "setup.h"
+#include "BXBenchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+
+//Defined in pic.cpp.
+void PIC_Init(Section* sec);
+
+//How many times each queue runs each mix.
+#define BXPICQueueRuns 3
+
+
+#pragma mark - Reference implementation
+
+//The event queue from DOSBox 0.74's pic.cpp, verbatim apart from naming.
+namespace ListQueue {
+    #define LIST_QUEUESIZE 512
+
+    struct PICEntry {
+        float index;
+        Bitu value;
+        PIC_EventHandler pic_event;
+        PICEntry * next;
+    };
+
+    static struct {
+        PICEntry entries[LIST_QUEUESIZE];
+        PICEntry * free_entry;
+        PICEntry * next_entry;
+    } pic_queue;
+
+    static bool InEventService = false;
+    static float srv_lag = 0;
+
+    static void Reset() {
+        for (Bitu i=0;i<LIST_QUEUESIZE-1;i++) {
+            pic_queue.entries[i].next=&pic_queue.entries[i+1];
+        }
+        pic_queue.entries[LIST_QUEUESIZE-1].next=0;
+        pic_queue.free_entry=&pic_queue.entries[0];
+        pic_queue.next_entry=0;
+        InEventService=false;
+        srv_lag=0;
+    }
+
+    static void AddEntry(PICEntry * entry) {
+        PICEntry * find_entry=pic_queue.next_entry;
+        if (GCC_UNLIKELY(find_entry ==0)) {
+            entry->next=0;
+            pic_queue.next_entry=entry;
+        } else if (find_entry->index>entry->index) {
+            pic_queue.next_entry=entry;
+            entry->next=find_entry;
+        } else while (find_entry) {
+            if (find_entry->next) {
+                if (find_entry->next->index > entry->index) {
+                    entry->next=find_entry->next;
+                    find_entry->next=entry;
+                    break;
+                } else {
+                    find_entry=find_entry->next;
+                }
+            } else {
+                entry->next=find_entry->next;
+                find_entry->next=entry;
+                break;
+            }
+        }
+        Bits cycles=PIC_MakeCycles(pic_queue.next_entry->index-PIC_TickIndex());
+        if (cycles<CPU_Cycles) {
+            CPU_CycleLeft+=CPU_Cycles;
+            CPU_Cycles=0;
+        }
+    }
+
+    static PIC_EventHandle AddEvent(PIC_EventHandler handler,float delay,Bitu val) {
+        if (GCC_UNLIKELY(!pic_queue.free_entry)) return PIC_NOEVENT;
+        PICEntry * entry=pic_queue.free_entry;
+        if(InEventService) entry->index = delay + srv_lag;
+        else entry->index = delay + PIC_TickIndex();
+
+        entry->pic_event=handler;
+        entry->value=val;
+        pic_queue.free_entry=pic_queue.free_entry->next;
+        AddEntry(entry);
+        return 0;
+    }
+
+    static void RemoveMatchingEvents(PIC_EventHandler handler,bool match_value,Bitu val) {
+        PICEntry * entry=pic_queue.next_entry;
+        PICEntry * prev_entry=0;
+        while (entry) {
+            if (GCC_UNLIKELY(entry->pic_event==handler) && (!match_value || entry->value==val)) {
+                if (prev_entry) {
+                    prev_entry->next=entry->next;
+                    entry->next=pic_queue.free_entry;
+                    pic_queue.free_entry=entry;
+                    entry=prev_entry->next;
+                    continue;
+                } else {
+                    pic_queue.next_entry=entry->next;
+                    entry->next=pic_queue.free_entry;
+                    pic_queue.free_entry=entry;
+                    entry=pic_queue.next_entry;
+                    continue;
+                }
+            }
+            prev_entry=entry;
+            entry=entry->next;
+        }
+    }
+
+    static void RemoveEvents(PIC_EventHandler handler) {
+        RemoveMatchingEvents(handler,false,0);
+    }
+
+    static void RemoveSpecificEvents(PIC_EventHandler handler,Bitu val) {
+        RemoveMatchingEvents(handler,true,val);
+    }
+
+    static bool RunQueue(void) {
+        CPU_CycleLeft+=CPU_Cycles;
+        CPU_Cycles=0;
+        if (CPU_CycleLeft<=0) {
+            return false;
+        }
+        Bits index_nd=PIC_TickIndexND();
+        InEventService = true;
+        while (pic_queue.next_entry && (pic_queue.next_entry->index*CPU_CycleMax<=index_nd)) {
+            PICEntry * entry=pic_queue.next_entry;
+            pic_queue.next_entry=entry->next;
+
+            srv_lag = entry->index;
+            (entry->pic_event)(entry->value);
+
+            entry->next=pic_queue.free_entry;
+            pic_queue.free_entry=entry;
+        }
+        InEventService = false;
+
+        if (pic_queue.next_entry) {
+            Bits cycles=(Bits)(pic_queue.next_entry->index*CPU_CycleMax-index_nd);
+            if (GCC_UNLIKELY(!cycles)) cycles=1;
+            if (cycles<CPU_CycleLeft) {
+                CPU_Cycles=cycles;
+            } else {
+                CPU_Cycles=CPU_CycleLeft;
+            }
+        } else CPU_Cycles=CPU_CycleLeft;
+        CPU_CycleLeft-=CPU_Cycles;
+        return true;
+    }
+
+    static void AddTick(void) {
+        CPU_CycleLeft=CPU_CycleMax;
+        CPU_Cycles=0;
+        PIC_Ticks++;
+        PICEntry * entry=pic_queue.next_entry;
+        while (entry) {
+            entry->index -= 1.0f;
+            entry=entry->next;
+        }
+    }
+}
+
+
+#pragma mark - Queue interface
+
+typedef struct {
+    const char *name;
+    void (*reset)(void);
+    PIC_EventHandle (*addEvent)(PIC_EventHandler handler, float delay, Bitu val);
+    bool (*removeEvent)(PIC_EventHandle handle);
+    void (*removeEvents)(PIC_EventHandler handler);
+    void (*removeSpecificEvents)(PIC_EventHandler handler, Bitu val);
+    bool (*runQueue)(void);
+    void (*addTick)(void);
+} BXPICQueue;
+
+static void _resetHeapQueue()
+{
+    //Recreating the PIC module resets its event queue. The section is leaked deliberately:
+    //deleting it would destroy the PIC module along with it.
+    PIC_Init(new Section_prop("pic"));
+}
+
+static const BXPICQueue heapQueue = {
+    "heap", _resetHeapQueue, PIC_AddEvent, PIC_RemoveEvent, PIC_RemoveEvents, PIC_RemoveSpecificEvents, PIC_RunQueue, TIMER_AddTick
+};
+
+static const BXPICQueue listQueue = {
+    "list", ListQueue::Reset, ListQueue::AddEvent, NULL, ListQueue::RemoveEvents, ListQueue::RemoveSpecificEvents, ListQueue::RunQueue, ListQueue::AddTick
+};
+
+static const BXPICQueue *queue = NULL;
+
+//The SB and VGA cancel their events by handle, but had to cancel every event with the same
+//handler on the old queue, which has no handles.
+static void _removeEvent(PIC_EventHandler handler, PIC_EventHandle handle)
+{
+    if (queue->removeEvent) queue->removeEvent(handle);
+    else queue->removeEvents(handler);
+}
+
+
+#pragma mark - Event mix
+
+//Each handler models the scheduling pattern of a real DOSBox device.
+//Every event that fires is appended to the trace so that the runs can be compared.
+
+typedef struct {
+    Bit32u handlerID;
+    Bit32u value;
+    Bit32u ticks;
+    Bit32s tickIndex;
+} BXPICTraceEntry;
+
+static std::vector<BXPICTraceEntry> trace;
+
+static void _record(Bit32u handlerID, Bitu value)
+{
+    BXPICTraceEntry entry = { handlerID, (Bit32u)value, (Bit32u)PIC_Ticks, (Bit32s)PIC_TickIndexND() };
+    trace.push_back(entry);
+}
+
+//Like PIT0_Event: a fixed-rate timer that reschedules itself.
+static void _timerEvent(Bitu val)
+{
+    _record(0, val);
+    queue->addEvent(_timerEvent, 0.8381f, val);
+}
+
+//Like VGA_VerticalTimer: once per frame, schedules the retrace latches and the line drawing for that frame.
+static PIC_EventHandle latchEvents[3], drawPartEvent, DMAEvent;
+
+static void _drawPartEvent(Bitu val);
+static void _latchEvent(Bitu val)
+{
+    _record(2, val);
+}
+
+static void _verticalTimerEvent(Bitu val)
+{
+    _record(1, val);
+    for (Bitu i=0; i < 3; i++) _removeEvent(_latchEvent, latchEvents[i]);
+    _removeEvent(_drawPartEvent, drawPartEvent);
+
+    queue->addEvent(_verticalTimerEvent, 14.2857f, 0);
+    latchEvents[0] = queue->addEvent(_latchEvent, 12.1f, 0);
+    latchEvents[1] = queue->addEvent(_latchEvent, 12.3f, 1);
+    latchEvents[2] = queue->addEvent(_latchEvent, 11.9f, 2);
+    drawPartEvent = queue->addEvent(_drawPartEvent, 0.5f, 4);
+}
+
+//Like VGA_DrawPart: draws the frame in parts, rescheduling itself until the frame is done.
+static void _drawPartEvent(Bitu val)
+{
+    _record(3, val);
+    if (val > 0) drawPartEvent = queue->addEvent(_drawPartEvent, 2.8f, val - 1);
+}
+
+//Like END_DMA_Event in sblaster.cpp: cancels and reschedules the end of each DMA block.
+static void _DMAEvent(Bitu val)
+{
+    _record(4, val);
+    _removeEvent(_DMAEvent, DMAEvent);
+    DMAEvent = queue->addEvent(_DMAEvent, 1.0f + (_random() % 64) / 16.0f, val + 1);
+}
+
+//Like the GUS and serial port events: many events with the same handler, distinguished by
+//value and cancelled individually with PIC_RemoveSpecificEvents before being rescheduled.
+static void _voiceEvent(Bitu val)
+{
+    _record(5, val);
+    Bitu voice = (val + 7) % 32;
+    queue->removeSpecificEvents(_voiceEvent, voice);
+    queue->addEvent(_voiceEvent, 0.05f + (_random() % 100) / 50.0f, voice);
+    queue->addEvent(_voiceEvent, 0.05f + (_random() % 100) / 50.0f, val);
+}
+
+typedef struct {
+    const char *name;
+    bool voices;
+    bool dma;
+} BXPICEventMix;
+
+static void _scheduleInitialEvents(const BXPICEventMix &mix)
+{
+    for (Bitu i=0; i < 3; i++) latchEvents[i] = PIC_NOEVENT;
+    drawPartEvent = DMAEvent = PIC_NOEVENT;
+
+    queue->addEvent(_timerEvent, 0.8381f, 0);
+    queue->addEvent(_verticalTimerEvent, 14.2857f, 0);
+    if (mix.dma) DMAEvent = queue->addEvent(_DMAEvent, 2.0f, 0);
+    if (mix.voices)
+    {
+        for (Bitu voice=0; voice < 32; voice++)
+            queue->addEvent(_voiceEvent, 0.05f + (_random() % 100) / 50.0f, voice);
+    }
+}
+
+static double _run(const BXPICQueue *runQueue, const BXPICEventMix &mix, Bitu milliseconds, Bits cyclesPerTick)
+{
+    queue = runQueue;
+    trace.clear();
+    _seedRandom(1);
+
+    CPU_CycleMax = cyclesPerTick;
+    CPU_CycleLeft = 0;
+    CPU_Cycles = 0;
+    queue->reset();
+    PIC_Ticks = 0;
+
+    _scheduleInitialEvents(mix);
+
+    double start = _seconds();
+
+    //Mirrors Normal_Loop, with a CPU core that runs for exactly as many cycles as it's given.
+    while (PIC_Ticks < milliseconds)
+    {
+        if (queue->runQueue()) CPU_Cycles = 0;
+        else queue->addTick();
+    }
+
+    return _seconds() - start;
+}
+
+
+int main(int argc, char *argv[])
+{
+    Bitu milliseconds = (argc > 1) ? atoi(argv[1]) : 60000;
+    const Bits cyclesPerTick = 20000;
+
+    const BXPICEventMix mixes[] = {
+        { "timer+vga",          false,  false },
+        { "timer+vga+sb",       false,  true  },
+        { "timer+vga+sb+voices",true,   true  },
+    };
+
+    bool allMatched = true;
+    printf("%-22s %10s %14s %14s %8s %s\n", "mix", "events", "list ns/event", "heap ns/event", "speedup", "traces");
+    for (unsigned int i=0; i < sizeof(mixes) / sizeof(mixes[0]); i++)
+    {
+        //The first run grows the trace, which would otherwise be timed along with whichever
+        //queue ran first. Then the queues take turns, and each keeps its best time.
+        _run(&listQueue, mixes[i], milliseconds, cyclesPerTick);
+        std::vector<BXPICTraceEntry> listTrace = trace;
+        double listTime = 0, heapTime = 0;
+        for (unsigned int run=0; run < BXPICQueueRuns; run++)
+        {
+            double time = _run(&listQueue, mixes[i], milliseconds, cyclesPerTick);
+            if (!run || time < listTime) listTime = time;
+            time = _run(&heapQueue, mixes[i], milliseconds, cyclesPerTick);
+            if (!run || time < heapTime) heapTime = time;
+        }
+
+        bool matched = (listTrace.size() == trace.size()) &&
+            (trace.empty() || !memcmp(&listTrace[0], &trace[0], trace.size() * sizeof(BXPICTraceEntry)));
+        allMatched &= matched;
+
+        double events = trace.size() ? trace.size() : 1;
+        printf("%-22s %10lu %14.1f %14.1f %7.2fx %s\n",
+               mixes[i].name,
+               (unsigned long)trace.size(),
+               listTime * 1e9 / events,
+               heapTime * 1e9 / events,
+               heapTime > 0 ? listTime / heapTime : 0,
+               matched ? "match" : "DIFFER");
+    }
+    return allMatched ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,124 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Differential test and microbenchmark for the pixel expansion used by the packed 4 bits per
+//pixel line handlers in vga_draw.cpp. This expands lines of random video memory at random
+//offsets, including ones that wrap around the end of it, with both the plain C and the vector
+//versions, checks that they draw exactly the same pixels, and reports the time each took.
+
+
+#include "dosbox.h"
+#include "vga.h"
+#include "vga_draw_simd.h"
+#include "BXBenchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define BXPixelMemorySize (32 * 1024)
+#define BXPixelMaxBlocks 1024
+#define BXPixelChecks 20000
+
+
+static Bit8u memory[BXPixelMemorySize];
+
+
+#pragma mark - Expanders
+
+typedef void (*BXExpander)(Bit32u *draw, const Bit8u *base, Bitu vidstart, Bitu mask, Bitu blocks);
+
+typedef struct {
+    const char *name;
+    BXExpander reference;
+    BXExpander vector;
+    //How many blocks a typical line has: 640 pixels at 4 or 2 pixels a block.
+    Bitu lineBlocks;
+} BXPixelExpander;
+
+#if defined(VGA_SIMD_SSE2)
+static const BXPixelExpander expanders[] = {
+    { "4BPP",       VGA_Expand4BPP_C,       VGA_Expand4BPP_SSE2,        160 },
+    { "4BPPDouble", VGA_Expand4BPPDouble_C, VGA_Expand4BPPDouble_SSE2,  80 },
+};
+#else
+static const BXPixelExpander expanders[] = {
+    { "4BPP",       VGA_Expand4BPP_C,       VGA_Expand4BPP_C,           160 },
+    { "4BPPDouble", VGA_Expand4BPPDouble_C, VGA_Expand4BPPDouble_C,     80 },
+};
+#endif
+
+//The address masks the CGA, Tandy and PCjr modes use.
+static const Bitu masks[] = { 0x1fff, 0x3fff, 0x7fff };
+
+
+#pragma mark - Checking and timing
+
+//Expands random lines with both versions and returns whether they all matched.
+static bool _check(const BXPixelExpander &expander)
+{
+    static Bit32u reference[BXPixelMaxBlocks + 1], vector[BXPixelMaxBlocks + 1];
+
+    for (Bitu i=0; i < BXPixelChecks; i++)
+    {
+        Bitu mask = masks[_random() % (sizeof(masks) / sizeof(masks[0]))];
+        Bitu blocks = _random() % BXPixelMaxBlocks;
+        //Start close to the end of memory often enough to test wrapping around it.
+        Bitu vidstart = (i & 1) ? mask - (_random() % 64) : _random();
+
+        //Fill one past the end to catch either version drawing too much.
+        memset(reference, 0xAA, sizeof(reference));
+        memset(vector, 0xAA, sizeof(vector));
+        expander.reference(reference, memory, vidstart, mask, blocks);
+        expander.vector(vector, memory, vidstart, mask, blocks);
+
+        if (memcmp(reference, vector, sizeof(reference)))
+        {
+            printf("%s differs at vidstart %lu mask %lx blocks %lu\n", expander.name,
+                   (unsigned long)vidstart, (unsigned long)mask, (unsigned long)blocks);
+            return false;
+        }
+    }
+    return true;
+}
+
+//Returns the average time in microseconds to expand a typical line.
+static double _time(BXExpander expand, Bitu blocks, Bitu repeats)
+{
+    static Bit32u line[BXPixelMaxBlocks];
+    double start = _seconds();
+    for (Bitu i=0; i < repeats; i++)
+    {
+        expand(line, memory, (i * blocks * 2) & 0x3fff, 0x3fff, blocks);
+    }
+    return (_seconds() - start) * 1e6 / repeats;
+}
+
+
+int main(int argc, char *argv[])
+{
+    Bitu repeats = (argc > 1) ? atoi(argv[1]) : 200000;
+
+    for (Bitu i=0; i < BXPixelMemorySize; i++) memory[i] = _random();
+
+    printf("%-11s %10s %10s %s\n", "expander", "c", "vector", "output");
+
+    bool allMatched = true;
+    for (unsigned int e=0; e < sizeof(expanders) / sizeof(expanders[0]); e++)
+    {
+        const BXPixelExpander &expander = expanders[e];
+        bool matched = _check(expander);
+        allMatched &= matched;
+
+        double reference = _time(expander.reference, expander.lineBlocks, repeats);
+        double vector = _time(expander.vector, expander.lineBlocks, repeats);
+        printf("%-11s %7.3f us %7.3f us %s\n", expander.name, reference, vector, matched ? "match" : "DIFFER");
+    }
+
+    return allMatched ? EXIT_SUCCESS : EXIT_FAILURE;
+}
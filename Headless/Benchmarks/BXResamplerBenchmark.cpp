@@ -0,0 +1,250 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Differential test, microbenchmark and quality comparison for the polyphase resampler in
+//mixer_polyphase.h. This resamples random blocks in every format the mixer channels use with
+//both the plain C and the vector filter and checks they mix exactly the same samples; times
+//the polyphase resampler against the linear interpolation channels use by default; and
+//resamples pure tones at the rates DOS sound devices play at with both, reporting how far
+//each strays from a pure tone at the mixer's rate, and how much of a tone that the mixer's
+//rate can't represent leaks through as an alias.
+
+
+#include "dosbox.h"
+#include "mem.h"
+#include "mixer.h"
+#include "mixer_simd.h"
+#include "mixer_polyphase.h"
+#include "BXMixerFormats.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define BXResamplerChecks 1000
+
+//How long each tone plays for in the quality comparison, in output samples.
+#define BXResamplerToneSamples 44100
+
+
+static MixerFIR referenceFIR, vectorFIR;
+
+
+#pragma mark - Formats
+
+typedef Bitu (*BXResamplerFunction)(Bit32s (*work)[2], Bitu mixpos, Bitu len, const Bit8u *data,
+                                    MixerFIR &fir, Bitu &freq_index, Bitu freq_add, const Bit32s *volmul);
+
+typedef struct {
+    const char *name;
+    BXResamplerFunction reference;
+    BXResamplerFunction vector;
+} BXResamplerFormat;
+
+//Calls the version of the resampler for a format with untyped source data.
+template<class Type,bool stereo,bool signeddata,bool nativeorder,bool vector>
+static Bitu _resample(Bit32s (*work)[2], Bitu mixpos, Bitu len, const Bit8u *data,
+                      MixerFIR &fir, Bitu &freq_index, Bitu freq_add, const Bit32s *volmul)
+{
+    if (vector) return MIXER_AddSamplesFIR<Type,stereo,signeddata,nativeorder>(work, mixpos, len, (const Type *)data, fir, freq_index, freq_add, volmul);
+    else return MIXER_AddSamplesFIR_C<Type,stereo,signeddata,nativeorder>(work, mixpos, len, (const Type *)data, fir, freq_index, freq_add, volmul);
+}
+
+#define BXResamplerFormat(_NAME, _TYPE, _STEREO, _SIGNED, _NATIVE) \
+    { _NAME, _resample<_TYPE,_STEREO,_SIGNED,_NATIVE,false>, _resample<_TYPE,_STEREO,_SIGNED,_NATIVE,true> }
+
+static const BXResamplerFormat formats[] = { BXMixerFormats(BXResamplerFormat) };
+
+
+#pragma mark - Checking and timing
+
+//Resamples random blocks with both filters and returns whether they all matched.
+static bool _check(const BXResamplerFormat &format)
+{
+    for (Bitu i=0; i < BXResamplerChecks; i++)
+    {
+        BXMixerBlock block = _randomBlock(i);
+
+        referenceFIR.cutoff_add = 0;
+        MIXER_MakeFIR(referenceFIR, block.freqAdd);
+        for (Bitu s=0; s < MIXER_FIR_TAPS-1; s++)
+        {
+            referenceFIR.history[0][s] = _random();
+            referenceFIR.history[1][s] = _random();
+        }
+        vectorFIR = referenceFIR;
+        //Up to a few source samples into the block, as carried over from the last one
+        Bitu referenceIndex = _random() % (4 << MIXER_SHIFT), vectorIndex = referenceIndex;
+
+        Bitu referenceDone = format.reference(referenceWork, block.mixpos, block.len, source, referenceFIR, referenceIndex, block.freqAdd, block.volmul);
+        Bitu vectorDone = format.vector(vectorWork, block.mixpos, block.len, source, vectorFIR, vectorIndex, block.freqAdd, block.volmul);
+
+        bool stateMatches = !memcmp(referenceFIR.history, vectorFIR.history, sizeof(referenceFIR.history)) &&
+            referenceIndex == vectorIndex;
+        if (!_blockMatches(format.name, block, referenceDone, vectorDone, stateMatches)) return false;
+    }
+    return true;
+}
+
+//Returns the average time in microseconds to resample ten ticks' worth of samples from a channel,
+//with either the linear interpolation or the polyphase filter.
+template<class Type,bool stereo>
+static double _time(Bitu rate, bool polyphase, Bitu repeats)
+{
+    const Bitu freqAdd = (rate << MIXER_SHIFT) / BXMixerRate;
+    const Bitu len = (BXMixerTickSamples * rate) / BXMixerRate;
+    const Bit32s volmul[2] = { 1 << MIXER_VOLSHIFT, 1 << MIXER_VOLSHIFT };
+    const Type *data = (const Type *)source;
+    Bits last[2] = { 0, 0 };
+    Bitu freqIndex = 0, mixpos = 0;
+    vectorFIR.cutoff_add = 0;
+    MIXER_MakeFIR(vectorFIR, freqAdd);
+    MIXER_ClearFIR(vectorFIR);
+
+    double start = _seconds();
+    for (Bitu i=0; i < repeats; i++)
+    {
+        if (polyphase) mixpos += MIXER_AddSamplesFIR<Type,stereo,true,true>(vectorWork, mixpos, len, data, vectorFIR, freqIndex, freqAdd, volmul);
+        else mixpos += MIXER_AddSamples<Type,stereo,true,true>(vectorWork, mixpos, len, data, last, freqIndex, freqAdd, volmul);
+    }
+    return (_seconds() - start) * 1e6 / repeats;
+}
+
+
+#pragma mark - Quality
+
+static Bit16s tone[BXResamplerToneSamples * 3];
+static double output[BXResamplerToneSamples * 2];
+
+//Plays a tone at the given rate through either resampler a millisecond at a time, as the
+//mixer does, into output. Returns the number of output samples.
+static Bitu _resampleTone(Bitu rate, double frequency, bool polyphase)
+{
+    const Bitu freqAdd = (rate << MIXER_SHIFT) / BXMixerRate;
+    const Bit32s volmul[2] = { 1 << MIXER_VOLSHIFT, 1 << MIXER_VOLSHIFT };
+    const Bitu toneLength = (BXResamplerToneSamples * rate) / BXMixerRate;
+    for (Bitu i=0; i < toneLength; i++)
+        tone[i] = (Bit16s)floor(16384 * sin(2 * M_PI * frequency * i / rate) + 0.5);
+
+    Bits last[2] = { 0, 0 };
+    Bitu freqIndex = 0, done = 0;
+    vectorFIR.cutoff_add = 0;
+    MIXER_MakeFIR(vectorFIR, freqAdd);
+    MIXER_ClearFIR(vectorFIR);
+
+    for (Bitu pos=0; pos < toneLength; )
+    {
+        Bitu len = rate / 1000;
+        if (len > toneLength - pos) len = toneLength - pos;
+        memset(vectorWork, 0, sizeof(vectorWork));
+        Bitu count;
+        if (polyphase) count = MIXER_AddSamplesFIR<Bit16s,false,true,true>(vectorWork, 0, len, &tone[pos], vectorFIR, freqIndex, freqAdd, volmul);
+        else count = MIXER_AddSamples<Bit16s,false,true,true>(vectorWork, 0, len, &tone[pos], last, freqIndex, freqAdd, volmul);
+        for (Bitu i=0; i < count; i++) output[done + i] = vectorWork[i][0] >> MIXER_VOLSHIFT;
+        done += count;
+        pos += len;
+    }
+    return done;
+}
+
+//Fits the tone the output should be to it, skipping the start while the resampler settles,
+//and returns how far below the tone everything else in the output is in dB.
+static double _signalToNoise(Bitu count, double cyclesPerSample)
+{
+    double cc = 0, ss = 0, cs = 0, yc = 0, ys = 0;
+    const Bitu skip = 256;
+    for (Bitu i=skip; i < count; i++)
+    {
+        double c = cos(2 * M_PI * cyclesPerSample * i), s = sin(2 * M_PI * cyclesPerSample * i);
+        cc += c * c; ss += s * s; cs += c * s;
+        yc += output[i] * c; ys += output[i] * s;
+    }
+    double det = cc * ss - cs * cs;
+    double a = (yc * ss - ys * cs) / det, b = (ys * cc - yc * cs) / det;
+
+    double signal = 0, noise = 0;
+    for (Bitu i=skip; i < count; i++)
+    {
+        double fit = a * cos(2 * M_PI * cyclesPerSample * i) + b * sin(2 * M_PI * cyclesPerSample * i);
+        signal += fit * fit;
+        noise += (output[i] - fit) * (output[i] - fit);
+    }
+    return 10 * log10(signal / noise);
+}
+
+//Returns how loud the output is in dB, relative to the tone that went in.
+static double _leakage(Bitu count)
+{
+    double energy = 0;
+    const Bitu skip = 256;
+    for (Bitu i=skip; i < count; i++) energy += output[i] * output[i];
+    return 10 * log10(energy / (count - skip) / (16384.0 * 16384.0 / 2));
+}
+
+//A tone a channel might play at its rate. When leak is set it's above what the mixer's rate
+//can represent, so anything that comes out of the resampler is an alias.
+typedef struct {
+    Bitu rate;
+    double frequency;
+    bool leak;
+} BXResamplerTone;
+
+static const BXResamplerTone tones[] = {
+    { 22050,    1000,   false },
+    { 11025,    4000,   false },
+    { 22050,    9000,   false },
+    { 32000,    12000,  false },
+    { 48000,    18000,  false },
+    { 49716,    20000,  false },
+    { 48000,    23500,  true },
+    { 49716,    24000,  true },
+    { 88200,    30000,  true },
+};
+
+
+int main(int argc, char *argv[])
+{
+    Bitu repeats = (argc > 1) ? atoi(argv[1]) : 20000;
+
+    _fillSource();
+
+    printf("%-8s %s\n", "format", "output");
+    bool allMatched = true;
+    for (unsigned int f=0; f < sizeof(formats) / sizeof(formats[0]); f++)
+    {
+        const BXResamplerFormat &format = formats[f];
+        bool matched = _check(format);
+        allMatched &= matched;
+        printf("%-8s %s\n", format.name, matched ? "match" : "DIFFER");
+    }
+
+    printf("\n%-14s %10s %10s\n", "channel", "linear", "polyphase");
+    printf("%-14s %7.3f us %7.3f us\n", "s16 22050Hz", _time<Bit16s,true>(22050, false, repeats), _time<Bit16s,true>(22050, true, repeats));
+    printf("%-14s %7.3f us %7.3f us\n", "m8s 11025Hz", _time<Bit8s,false>(11025, false, repeats), _time<Bit8s,false>(11025, true, repeats));
+    printf("%-14s %7.3f us %7.3f us\n", "s16 49716Hz", _time<Bit16s,true>(49716, false, repeats), _time<Bit16s,true>(49716, true, repeats));
+
+    printf("\n%-14s %-9s %10s %10s\n", "tone", "measure", "linear", "polyphase");
+    for (unsigned int t=0; t < sizeof(tones) / sizeof(tones[0]); t++)
+    {
+        const BXResamplerTone &tone = tones[t];
+        //The tone's frequency at the mixer's rate, as the resampler actually steps through it
+        double cyclesPerSample = tone.frequency / tone.rate * (double)((tone.rate << MIXER_SHIFT) / BXMixerRate) / (1 << MIXER_SHIFT);
+        double results[2];
+        for (int polyphase=0; polyphase < 2; polyphase++)
+        {
+            Bitu count = _resampleTone(tone.rate, tone.frequency, polyphase);
+            results[polyphase] = tone.leak ? _leakage(count) : _signalToNoise(count, cyclesPerSample);
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "%luHz@%lu", (unsigned long)tone.frequency, (unsigned long)tone.rate);
+        printf("%-14s %-9s %7.1f dB %7.1f dB\n", name, tone.leak ? "alias" : "sinad", results[0], results[1]);
+    }
+
+    return allMatched ? EXIT_SUCCESS : EXIT_FAILURE;
+}
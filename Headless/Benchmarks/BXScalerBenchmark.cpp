@@ -0,0 +1,260 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Microbenchmark for DOSBox's simple scalers and HQ scalers. This feeds the same sequence of
+//frames through every simple scaler at every source and output depth, and through the HQ
+//scalers at the depths they support, once for each vector level this CPU supports, checks
+//that every level draws exactly the same output, and reports the time each level took per frame.
+
+
+#include "dosbox.h"
+#include "render.h"
+#include "BXBenchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+
+#define BXScalerWidth 640
+#define BXScalerHeight 400
+#define BXScalerFrameCount 4
+#define BXScalerMaxScale 3
+
+
+#pragma mark - Frames
+
+//Frame 0 and 2 are random, frame 1 changes short runs of frame 0 as a game's moving sprites
+//would, and frame 3 repeats frame 2 so that nothing changes at all.
+static Bit8u frames[BXScalerFrameCount][BXScalerHeight][BXScalerWidth * 4];
+
+static void _makeFrames()
+{
+    for (Bitu y=0; y < BXScalerHeight; y++)
+    {
+        for (Bitu x=0; x < BXScalerWidth * 4; x++)
+        {
+            frames[0][y][x] = _random();
+            frames[2][y][x] = _random();
+        }
+    }
+
+    memcpy(frames[1], frames[0], sizeof(frames[0]));
+    for (Bitu run=0; run < 2000; run++)
+    {
+        Bitu y = _random() % BXScalerHeight;
+        Bitu x = _random() % (BXScalerWidth * 4);
+        Bitu length = 1 + _random() % 64;
+        for (; length && x < BXScalerWidth * 4; length--, x++) frames[1][y][x] ^= 0x5A;
+    }
+    memcpy(frames[3], frames[2], sizeof(frames[2]));
+
+    for (Bitu i=0; i < 256; i++)
+    {
+        render.pal.lut.b32[i] = _random();
+    }
+    memset(render.pal.modified, 0, sizeof(render.pal.modified));
+}
+
+
+#pragma mark - Scalers
+
+typedef struct {
+    const char *name;
+    ScalerSimpleBlock_t *block;
+} BXScaler;
+
+static const BXScaler scalers[] = {
+    { "Normal1x",   &ScaleNormal1x },
+    { "NormalDw",   &ScaleNormalDw },
+    { "NormalDh",   &ScaleNormalDh },
+    { "Normal2x",   &ScaleNormal2x },
+    { "Normal3x",   &ScaleNormal3x },
+    { "TV2x",       &ScaleTV2x },
+    { "TV3x",       &ScaleTV3x },
+    { "RGB2x",      &ScaleRGB2x },
+    { "RGB3x",      &ScaleRGB3x },
+    { "Scan2x",     &ScaleScan2x },
+    { "Scan3x",     &ScaleScan3x },
+};
+
+//The complex scalers with vector versions of any of their parts.
+typedef struct {
+    const char *name;
+    ScalerComplexBlock_t *block;
+} BXComplexScaler;
+
+static const BXComplexScaler complexScalers[] = {
+    { "HQ2x",       &ScaleHQ2x },
+    { "HQ3x",       &ScaleHQ3x },
+};
+
+//Rows of a ScalerLineBlock_t, and the bytes per pixel of each.
+static const char *sourceNames[5] = { "8", "15", "16", "32", "8pal" };
+static const Bitu sourceBytes[5] = { 1, 2, 2, 4, 1 };
+//Columns of a ScalerLineBlock_t.
+static const char *outputNames[4] = { "8", "15", "16", "32" };
+
+static Bit8u output[BXScalerHeight * BXScalerMaxScale][BXScalerWidth * BXScalerMaxScale * 4];
+
+
+#pragma mark - Running scalers
+
+//Draws one frame through the scaler the same way as RENDER_StartUpdate and the VGA
+//code would, and returns a hash of the whole output buffer afterwards.
+static Bit32u _drawFrame(ScalerLineHandler_t handler, Bitu frame, Bitu source)
+{
+    render.src.width = BXScalerWidth;
+    render.scale.cacheRead = scalerSourceCache;
+    render.scale.cachePitch = BXScalerWidth * sourceBytes[source];
+    render.scale.outWrite = output[0];
+    render.scale.outPitch = sizeof(output[0]);
+    render.scale.inLine = 0;
+    render.scale.outLine = 0;
+    Scaler_ChangedLines[0] = 0;
+    Scaler_ChangedLineIndex = 0;
+    Scaler_ClearDirtyTiles();
+
+    for (Bitu y=0; y < BXScalerHeight; y++) handler(frames[frame][y]);
+
+    Bit32u hash = 2166136261U;
+    const Bit8u *bytes = output[0];
+    for (Bitu i=0; i < sizeof(output); i++) hash = (hash ^ bytes[i]) * 16777619U;
+    return hash;
+}
+
+//Starts from an empty output and a cache that doesn't match the first frame, as after
+//RENDER_ClearCacheHandler, and returns the combined hash of every frame drawn.
+static Bit32u _check(ScalerLineHandler_t handler, Bitu source)
+{
+    memset(output, 0, sizeof(output));
+    memset(scalerSourceCache, 0, BXScalerWidth * 4 * BXScalerHeight);
+    for (Bitu y=0; y < BXScalerHeight; y++)
+    {
+        for (Bitu x=0; x < BXScalerWidth * sourceBytes[source]; x++)
+            scalerSourceCache[y * BXScalerWidth * sourceBytes[source] + x] = ~frames[0][y][x];
+    }
+
+    Bit32u hash = 0;
+    for (Bitu frame=0; frame < BXScalerFrameCount; frame++)
+        hash = hash * 31 + _drawFrame(handler, frame, source);
+    return hash;
+}
+
+//Returns the average time in milliseconds to draw each frame.
+static double _time(ScalerLineHandler_t handler, Bitu source, Bitu repeats)
+{
+    double start = _seconds();
+    for (Bitu i=0; i < repeats; i++)
+    {
+        for (Bitu frame=0; frame < BXScalerFrameCount; frame++)
+        {
+            render.scale.cacheRead = scalerSourceCache;
+            render.scale.outWrite = output[0];
+            render.scale.inLine = 0;
+            render.scale.outLine = 0;
+            Scaler_ChangedLines[0] = 0;
+            Scaler_ChangedLineIndex = 0;
+            Scaler_ClearDirtyTiles();
+            for (Bitu y=0; y < BXScalerHeight; y++) handler(frames[frame][y]);
+        }
+    }
+    return (_seconds() - start) * 1000 / (repeats * BXScalerFrameCount);
+}
+
+
+//Times handler at every vector level, and prints whether they all drew the same output.
+static bool _compare(const char *name, ScalerLineHandler_t linear, ScalerLineHandler_t random,
+                     Bitu source, Bitu out, const std::vector<scalerSIMD_t> &levels, Bitu repeats)
+{
+    bool matched = true;
+    Bit32u linearHash = 0, randomHash = 0;
+    double milliseconds[scalerSIMDLast];
+    for (unsigned int l=0; l < levels.size(); l++)
+    {
+        Scaler_InitSIMD(levels[l]);
+        Bit32u thisRandomHash = _check(random, source);
+        Bit32u thisLinearHash = _check(linear, source);
+        milliseconds[l] = _time(linear, source, repeats);
+
+        if (!l)
+        {
+            linearHash = thisLinearHash;
+            randomHash = thisRandomHash;
+        }
+        else if (thisLinearHash != linearHash || thisRandomHash != randomHash)
+        {
+            matched = false;
+        }
+    }
+
+    printf("%-9s %-5s %-4s", name, sourceNames[source], outputNames[out]);
+    for (unsigned int l=0; l < levels.size(); l++) printf(" %7.3f ms", milliseconds[l]);
+    printf(" %s\n", matched ? "match" : "DIFFER");
+    return matched;
+}
+
+int main(int argc, char *argv[])
+{
+    Bitu repeats = (argc > 1) ? atoi(argv[1]) : 20;
+    static const char *levelNames[scalerSIMDLast] = { "none", "sse2", "avx2" };
+
+    _makeFrames();
+    Scaler_AllocateCaches(BXScalerWidth * 4, BXScalerHeight, 0, 4);
+    Scaler_SizeDirtyTiles(BXScalerWidth * BXScalerMaxScale, BXScalerHeight * BXScalerMaxScale, BXScalerMaxScale);
+
+    //Find out which vector levels this machine can run.
+    std::vector<scalerSIMD_t> levels;
+    for (unsigned int level=scalerSIMDNone; level < scalerSIMDLast; level++)
+    {
+        if (Scaler_InitSIMD((scalerSIMD_t)level) == level) levels.push_back((scalerSIMD_t)level);
+    }
+
+    printf("%-9s %-5s %-4s", "scaler", "in", "out");
+    for (unsigned int l=0; l < levels.size(); l++) printf(" %10s", levelNames[levels[l]]);
+    printf(" %s\n", "output");
+
+    bool allMatched = true;
+    for (unsigned int s=0; s < sizeof(scalers) / sizeof(scalers[0]); s++)
+    {
+        const ScalerSimpleBlock_t *block = scalers[s].block;
+        for (Bitu source=0; source < 5; source++)
+        {
+            for (Bitu out=0; out < 4; out++)
+            {
+                if (!block->Linear[source][out]) continue;
+
+                //Both the linear and random-aspect versions must match at every level,
+                //but only the linear ones are timed.
+                for (Bitu i=0; i < BXScalerHeight; i++) Scaler_Aspect[i] = block->yscale;
+                allMatched &= _compare(scalers[s].name, block->Linear[source][out], block->Random[source][out],
+                                       source, out, levels, repeats);
+            }
+        }
+    }
+
+    //The complex scalers are fed through ScalerCache's line handlers, which copy each line
+    //into the frame cache and call render.scale.complexHandler. They only scale to the same
+    //depth as their source, and only the linear versions are checked.
+    Scaler_AllocateCaches(BXScalerWidth * 4, BXScalerHeight, BXScalerWidth, 4);
+    render.scale.blocks = BXScalerWidth / SCALER_BLOCKSIZE;
+    render.scale.lastBlock = BXScalerWidth % SCALER_BLOCKSIZE;
+    render.scale.inHeight = BXScalerHeight;
+    for (unsigned int s=0; s < sizeof(complexScalers) / sizeof(complexScalers[0]); s++)
+    {
+        const ScalerComplexBlock_t *block = complexScalers[s].block;
+        for (Bitu depth=2; depth < 4; depth++)
+        {
+            render.scale.complexHandler = block->Linear[depth];
+            allMatched &= _compare(complexScalers[s].name, ScalerCache[depth][depth], ScalerCache[depth][depth],
+                                   depth, depth, levels, repeats);
+        }
+    }
+
+    return allMatched ? EXIT_SUCCESS : EXIT_FAILURE;
+}
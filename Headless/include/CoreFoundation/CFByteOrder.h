@@ -0,0 +1,22 @@
+/* 
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//A stand-in for the handful of CoreFoundation byte-swapping functions
+//that DOSBox's rendering code uses, for the headless Linux host.
+
+#ifndef BOXER_HEADLESS_CFBYTEORDER_H
+#define BOXER_HEADLESS_CFBYTEORDER_H
+
+#include <stdint.h>
+#include <endian.h>
+
+static inline uint16_t CFSwapInt16HostToLittle(uint16_t arg) { return htole16(arg); }
+static inline uint32_t CFSwapInt32HostToLittle(uint32_t arg) { return htole32(arg); }
+static inline uint16_t CFSwapInt16LittleToHost(uint16_t arg) { return le16toh(arg); }
+static inline uint32_t CFSwapInt32LittleToHost(uint32_t arg) { return le32toh(arg); }
+
+#endif
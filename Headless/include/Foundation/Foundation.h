@@ -0,0 +1,17 @@
+/* 
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//A stand-in for the sliver of Foundation needed by Boxer's pure-C++ Coalface sources
+//(e.g. BXCoalfaceDrives.mm), so that they can be compiled as-is in the headless Linux host.
+
+#ifndef BOXER_HEADLESS_FOUNDATION_H
+#define BOXER_HEADLESS_FOUNDATION_H
+
+typedef unsigned long NSUInteger;
+typedef long NSInteger;
+
+#endif
@@ -0,0 +1,142 @@
+/* 
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//A stand-in for the subset of the SDL 1.2 API that DOSBox's emulation core still uses
+//once Boxer's Coalface hooks have replaced sdlmain. This lets the headless Linux host
+//build the core without SDL: the implementations live in BXHeadlessSDL.cpp.
+
+#ifndef BOXER_HEADLESS_SDL_H
+#define BOXER_HEADLESS_SDL_H
+
+#include <stdint.h>
+#include "SDL_endian.h"
+#include "SDL_thread.h"
+
+typedef uint8_t     Uint8;
+typedef int8_t      Sint8;
+typedef uint16_t    Uint16;
+typedef int16_t     Sint16;
+typedef uint32_t    Uint32;
+typedef int32_t     Sint32;
+
+#define SDL_MAJOR_VERSION   1
+#define SDL_MINOR_VERSION   2
+#define SDL_PATCHLEVEL      15
+#define SDL_VERSIONNUM(X, Y, Z) ((X)*1000 + (Y)*100 + (Z))
+#define SDL_VERSION_ATLEAST(X, Y, Z) \
+    (SDL_VERSIONNUM(SDL_MAJOR_VERSION, SDL_MINOR_VERSION, SDL_PATCHLEVEL) >= SDL_VERSIONNUM(X, Y, Z))
+
+
+#pragma mark - Initialization
+
+#define SDL_INIT_TIMER          0x00000001
+#define SDL_INIT_AUDIO          0x00000010
+#define SDL_INIT_VIDEO          0x00000020
+#define SDL_INIT_CDROM          0x00000100
+#define SDL_INIT_JOYSTICK       0x00000200
+#define SDL_INIT_NOPARACHUTE    0x00100000
+
+int SDL_Init(Uint32 flags);
+int SDL_InitSubSystem(Uint32 flags);
+void SDL_QuitSubSystem(Uint32 flags);
+void SDL_Quit(void);
+char *SDL_GetError(void);
+
+
+#pragma mark - Timing
+
+Uint32 SDL_GetTicks(void);
+void SDL_Delay(Uint32 ms);
+
+
+#pragma mark - Audio
+
+#define AUDIO_U8        0x0008
+#define AUDIO_S16LSB    0x8010
+#define AUDIO_S16MSB    0x9010
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define AUDIO_S16SYS    AUDIO_S16LSB
+#else
+#define AUDIO_S16SYS    AUDIO_S16MSB
+#endif
+
+typedef struct SDL_AudioSpec {
+	int freq;
+	Uint16 format;
+	Uint8  channels;
+	Uint8  silence;
+	Uint16 samples;
+	Uint16 padding;
+	Uint32 size;
+	void (*callback)(void *userdata, Uint8 *stream, int len);
+	void  *userdata;
+} SDL_AudioSpec;
+
+int SDL_OpenAudio(SDL_AudioSpec *desired, SDL_AudioSpec *obtained);
+void SDL_PauseAudio(int pause_on);
+void SDL_LockAudio(void);
+void SDL_UnlockAudio(void);
+void SDL_CloseAudio(void);
+
+
+#pragma mark - CD-ROM
+
+//The headless host has no physical CD-ROM drives: these are only
+//provided so that DOSBox's SDL CD-ROM interface will compile.
+#define SDL_MAX_TRACKS  99
+#define SDL_AUDIO_TRACK 0x00
+#define SDL_DATA_TRACK  0x04
+#define CD_FPS          75
+
+typedef enum {
+	CD_TRAYEMPTY,
+	CD_STOPPED,
+	CD_PLAYING,
+	CD_PAUSED,
+	CD_ERROR = -1
+} CDstatus;
+
+#define CD_INDRIVE(status)  ((int)(status) > 0)
+#define FRAMES_TO_MSF(f, M,S,F) {       \
+	int value = f;                      \
+	*(F) = value%CD_FPS;                \
+	value /= CD_FPS;                    \
+	*(S) = value%60;                    \
+	value /= 60;                        \
+	*(M) = value;                       \
+}
+#define MSF_TO_FRAMES(M, S, F)  ((M)*60*CD_FPS+(S)*CD_FPS+(F))
+
+typedef struct SDL_CDtrack {
+	Uint8 id;
+	Uint8 type;
+	Uint16 unused;
+	Uint32 length;
+	Uint32 offset;
+} SDL_CDtrack;
+
+typedef struct SDL_CD {
+	int id;
+	CDstatus status;
+	int numtracks;
+	int cur_track;
+	int cur_frame;
+	SDL_CDtrack track[SDL_MAX_TRACKS+1];
+} SDL_CD;
+
+int SDL_CDNumDrives(void);
+const char *SDL_CDName(int drive);
+SDL_CD *SDL_CDOpen(int drive);
+CDstatus SDL_CDStatus(SDL_CD *cdrom);
+int SDL_CDPlay(SDL_CD *cdrom, int start, int length);
+int SDL_CDPause(SDL_CD *cdrom);
+int SDL_CDResume(SDL_CD *cdrom);
+int SDL_CDStop(SDL_CD *cdrom);
+int SDL_CDEject(SDL_CD *cdrom);
+void SDL_CDClose(SDL_CD *cdrom);
+
+#endif
@@ -0,0 +1,29 @@
+/* 
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Stand-in for SDL_endian.h in the headless Linux host: see SDL.h.
+
+#ifndef BOXER_HEADLESS_SDL_ENDIAN_H
+#define BOXER_HEADLESS_SDL_ENDIAN_H
+
+#include <endian.h>
+
+#define SDL_LIL_ENDIAN  1234
+#define SDL_BIG_ENDIAN  4321
+
+#if __BYTE_ORDER == __BIG_ENDIAN
+#define SDL_BYTEORDER   SDL_BIG_ENDIAN
+#else
+#define SDL_BYTEORDER   SDL_LIL_ENDIAN
+#endif
+
+#define SDL_SwapLE16(X) le16toh(X)
+#define SDL_SwapLE32(X) le32toh(X)
+#define SDL_SwapBE16(X) be16toh(X)
+#define SDL_SwapBE32(X) be32toh(X)
+
+#endif
@@ -0,0 +1,35 @@
+/* 
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Stand-in for SDL_thread.h and SDL_mutex.h in the headless Linux host: see SDL.h.
+
+#ifndef BOXER_HEADLESS_SDL_THREAD_H
+#define BOXER_HEADLESS_SDL_THREAD_H
+
+#include <stdint.h>
+
+typedef struct SDL_mutex SDL_mutex;
+typedef struct SDL_sem SDL_sem;
+typedef struct SDL_Thread SDL_Thread;
+
+SDL_mutex *SDL_CreateMutex(void);
+void SDL_DestroyMutex(SDL_mutex *mutex);
+int SDL_mutexP(SDL_mutex *mutex);
+int SDL_mutexV(SDL_mutex *mutex);
+
+#define SDL_LockMutex(m)    SDL_mutexP(m)
+#define SDL_UnlockMutex(m)  SDL_mutexV(m)
+
+SDL_sem *SDL_CreateSemaphore(uint32_t initial_value);
+void SDL_DestroySemaphore(SDL_sem *sem);
+int SDL_SemWait(SDL_sem *sem);
+int SDL_SemPost(SDL_sem *sem);
+
+SDL_Thread *SDL_CreateThread(int (*fn)(void *), void *data);
+void SDL_WaitThread(SDL_Thread *thread, int *status);
+
+#endif
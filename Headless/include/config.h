@@ -0,0 +1,34 @@
+/* 
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//This file wraps DOSBox's XCode-specific config.h for the headless Linux host.
+//It pulls in the original settings and then overrides the ones that depend on
+//OS X frameworks that aren't available (or aren't wanted) in a headless build.
+
+#ifndef BOXER_HEADLESS_CONFIG_H
+#define BOXER_HEADLESS_CONFIG_H
+
+#include "../../DOSBox/config.h"
+
+//We're not on OS X any more, Toto.
+#undef MACOSX
+#if defined(__linux__)
+    #define LINUX 1
+#endif
+
+//Networking requires SDL_net, which the headless host does not link against.
+#undef C_IPX
+#undef C_MODEM
+
+//CD audio decoding requires SDL_sound: CD images will still mount,
+//but compressed audio tracks will be unavailable.
+#undef C_SDL_SOUND
+
+//There's no display to render to.
+#undef C_OPENGL
+
+#endif
@@ -0,0 +1,296 @@
+/*
+ Copyright (c) 2013 Alun Bestor and contributors. All rights reserved.
+ This source file is released under the GNU General Public License 2.0. A full copy of this license
+ can be found in this XCode project at Resources/English.lproj/BoxerHelp/pages/legalese.html, or read
+ online at [http://www.gnu.org/licenses/gpl-2.0.txt].
+ */
+
+//Entry point for boxer-headless. This follows the same startup sequence as BXEmulator's
+//_startDOSBox, then prints a report of how fast the emulation ran.
+
+
+#include "BXHeadless.h"
+#include "dosbox.h"
+#include "control.h"
+#include "cpu.h"
+#include "mixer.h"
+#include "SDL.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <stdexcept>
+
+
+//Defined by the Makefile.
+#ifndef BXHeadlessConfigurationsPath
+#define BXHeadlessConfigurationsPath "../Resources/Configurations"
+#endif
+
+//Used when no -seconds argument is provided.
+#define BXHeadlessDefaultEmulatedSeconds 10
+
+
+static void _printUsage(const char *processName)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "Runs DOSBox without a window for a fixed amount of emulated time, then reports how fast it ran.\n"
+            "\n"
+            "  -conf FILE        Load a DOSBox configuration file. May be repeated.\n"
+            "  -nopreflight      Don't load Boxer's Preflight.conf before other configuration files.\n"
+            "  -c COMMAND        Run a DOS command once the autoexec finishes. May be repeated.\n"
+            "  -script FILE      Run each line of FILE as a DOS command, as with -c.\n"
+            "  -keys TEXT        Type TEXT into the keyboard buffer. \\n types Enter, \\e Escape, \\t Tab.\n"
+            "  -seconds N        Run for N seconds of emulated time (default: %d).\n"
+            "  -turbo            Run unthrottled instead of in realtime. Use with fixed cycles.\n"
+            "  -audio FILE       Write the mixed audio output to FILE as raw 16-bit stereo PCM.\n"
+            "  -screenshot FILE  Write the final frame to FILE as a PPM image.\n"
+            "  -capture DIR      Write DOSBox captures (WAV, MIDI, screenshots etc.) to DIR.\n"
+            "  -verbose          Echo DOSBox's log messages to stderr.\n",
+            processName, BXHeadlessDefaultEmulatedSeconds);
+}
+
+
+#pragma mark - Keyboard input
+
+//Returns the BIOS keycode (scancode << 8 | ASCII) for the specified character
+//on a US keyboard layout, or 0 if the character cannot be typed.
+static Bit16u _BIOSKeyCodeForCharacter(char character)
+{
+    static const char *unshiftedRows[] = {"1234567890-=", "qwertyuiop[]", "asdfghjkl;'`", "\\zxcvbnm,./"};
+    static const char *shiftedRows[]   = {"!@#$%^&*()_+", "QWERTYUIOP{}", "ASDFGHJKL:\"~", "|ZXCVBNM<>?"};
+    static const Bit8u rowScancodes[]  = {0x02, 0x10, 0x1E, 0x2B};
+
+    switch (character)
+    {
+        case ' ':   return 0x3920;
+        case '\n':
+        case '\r':  return 0x1C0D;
+        case '\t':  return 0x0F09;
+        case '\b':  return 0x0E08;
+        case 0x1B:  return 0x011B;
+    }
+
+    if (!character) return 0;
+    for (unsigned int row=0; row < 4; row++)
+    {
+        const char *rows[2] = { unshiftedRows[row], shiftedRows[row] };
+        for (unsigned int shifted=0; shifted < 2; shifted++)
+        {
+            const char *match = strchr(rows[shifted], character);
+            if (match)
+            {
+                Bit8u scancode = rowScancodes[row] + (match - rows[shifted]);
+                return (scancode << 8) | (Bit8u)character;
+            }
+        }
+    }
+    return 0;
+}
+
+static void _typeText(const char *text)
+{
+    for (const char *c = text; *c; c++)
+    {
+        char character = *c;
+        if (character == '\\' && c[1])
+        {
+            switch (*(++c))
+            {
+                case 'n':   character = '\n'; break;
+                case 'e':   character = 0x1B; break;
+                case 't':   character = '\t'; break;
+                default:    character = *c;
+            }
+        }
+
+        Bit16u keyCode = _BIOSKeyCodeForCharacter(character);
+        if (keyCode) headlessSettings.keyBuffer.push_back(keyCode);
+        else fprintf(stderr, "Cannot type character 0x%02X, skipping.\n", (Bit8u)character);
+    }
+}
+
+
+#pragma mark - Reporting
+
+static void _printReport()
+{
+    const BXHeadlessStats &stats = headlessStats;
+    double emulatedSeconds = stats.emulatedMilliseconds / 1000.0;
+
+    printf("emulated_seconds: %.3f\n", emulatedSeconds);
+    printf("wall_seconds: %.3f\n", stats.wallTime);
+    printf("host_cpu_seconds: %.3f\n", stats.hostCPUTime);
+    printf("speed_ratio: %.3f\n", stats.wallTime > 0 ? emulatedSeconds / stats.wallTime : 0);
+    printf("emulated_cycles: %llu\n", (unsigned long long)stats.emulatedCycles);
+    printf("cycles_per_emulated_second: %.0f\n", emulatedSeconds > 0 ? stats.emulatedCycles / emulatedSeconds : 0);
+    printf("cycles_per_wall_second: %.0f\n", stats.wallTime > 0 ? stats.emulatedCycles / stats.wallTime : 0);
+    printf("frames: %llu\n", (unsigned long long)stats.frames);
+    printf("changed_frames: %llu\n", (unsigned long long)stats.changedFrames);
+    printf("duplicate_frames: %llu\n", (unsigned long long)stats.duplicateFrames);
+    printf("dirty_tiles: %llu of %llu\n", (unsigned long long)stats.dirtyTiles, (unsigned long long)stats.totalTiles);
+    printf("mixer_sample_frames: %llu\n", (unsigned long long)stats.mixerSamples);
+
+    Bitu underruns, overruns;
+    MIXER_GetBufferStats(&underruns, &overruns);
+    printf("mixer_underruns: %llu\n", (unsigned long long)underruns);
+    printf("mixer_overruns: %llu\n", (unsigned long long)overruns);
+
+    CPU_GovernorState governor;
+    CPU_GetGovernorState(&governor);
+    if (governor.active)
+    {
+        printf("governor_target: %.3f\n", governor.target);
+        printf("governor_measured: %.3f\n", governor.measured);
+        printf("governor_error: %.3f\n", governor.error);
+        printf("governor_cycles: %d\n", (int)governor.cycles);
+        printf("governor_updates: %lu\n", (unsigned long)governor.updates);
+    }
+
+#if (C_DYNREC)
+    CPU_DynamicCacheStats dynamicCache;
+    CPU_GetDynamicCacheStats(&dynamicCache);
+    if (dynamicCache.size)
+    {
+        printf("dynamic_cache_size: %lu\n", (unsigned long)dynamicCache.size);
+        printf("dynamic_cache_pages: %lu\n", (unsigned long)dynamicCache.pages);
+        printf("dynamic_cache_translations: %llu\n", (unsigned long long)dynamicCache.translations);
+        printf("dynamic_cache_retranslations: %llu\n", (unsigned long long)dynamicCache.retranslations);
+        printf("dynamic_cache_evicted_blocks: %llu\n", (unsigned long long)dynamicCache.evicted_blocks);
+        printf("dynamic_cache_evicted_pages: %llu\n", (unsigned long long)dynamicCache.evicted_pages);
+        printf("dynamic_cache_superblocks: %llu\n", (unsigned long long)dynamicCache.superblocks);
+    }
+#endif
+}
+
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> configPaths;
+    bool usePreflight = true;
+
+    headlessSettings.emulatedMilliseconds = BXHeadlessDefaultEmulatedSeconds * 1000;
+    headlessSettings.unthrottled = false;
+    headlessSettings.verbose = false;
+    headlessSettings.audioOutput = NULL;
+
+    for (int i=1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *param = (i+1 < argc) ? argv[i+1] : NULL;
+        bool hasParam = true;
+
+        if      (!strcmp(arg, "-turbo"))        { headlessSettings.unthrottled = true; hasParam = false; }
+        else if (!strcmp(arg, "-verbose"))      { headlessSettings.verbose = true; hasParam = false; }
+        else if (!strcmp(arg, "-nopreflight"))  { usePreflight = false; hasParam = false; }
+        else if (!param)
+        {
+            _printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        else if (!strcmp(arg, "-conf"))         configPaths.push_back(param);
+        else if (!strcmp(arg, "-c"))            headlessSettings.commandQueue.push_back(param);
+        else if (!strcmp(arg, "-keys"))         _typeText(param);
+        else if (!strcmp(arg, "-screenshot"))   headlessSettings.screenshotPath = param;
+        else if (!strcmp(arg, "-capture"))      headlessSettings.capturePath = param;
+        else if (!strcmp(arg, "-seconds"))      headlessSettings.emulatedMilliseconds = (Bitu)(atof(param) * 1000);
+        else if (!strcmp(arg, "-script"))
+        {
+            std::ifstream script(param);
+            if (!script)
+            {
+                fprintf(stderr, "Could not open script %s.\n", param);
+                return EXIT_FAILURE;
+            }
+            std::string line;
+            while (std::getline(script, line))
+            {
+                if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+                if (!line.empty()) headlessSettings.commandQueue.push_back(line);
+            }
+        }
+        else if (!strcmp(arg, "-audio"))
+        {
+            headlessSettings.audioOutput = fopen(param, "wb");
+            if (!headlessSettings.audioOutput)
+            {
+                fprintf(stderr, "Could not open %s for writing.\n", param);
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            _printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        if (hasParam) i++;
+    }
+
+	//Initialize the SDL modules that DOSBox will need.
+	if (SDL_Init(SDL_INIT_AUDIO|SDL_INIT_TIMER|SDL_INIT_CDROM|SDL_INIT_NOPARACHUTE) != 0)
+    {
+        fprintf(stderr, "SDL failed to initialize with the following error: %s\n", SDL_GetError());
+        return EXIT_FAILURE;
+    }
+
+    int status = EXIT_SUCCESS;
+	try
+	{
+        //Create a new configuration instance and feed it an empty set of parameters.
+        char const *emptyArgv[1] = { NULL };
+        CommandLine commandLine(0, emptyArgv);
+        Config configuration(&commandLine);
+        control=&configuration;
+
+        //Sets up the vast swathes of DOSBox configuration file parameters,
+        //and registers the shell to start up when we finish initializing.
+        DOSBOX_Init();
+
+        if (usePreflight)
+            configPaths.insert(configPaths.begin(), BXHeadlessConfigurationsPath "/Preflight.conf");
+
+        for (std::vector<std::string>::const_iterator path = configPaths.begin(); path != configPaths.end(); ++path)
+        {
+            if (!control->ParseConfigFile(path->c_str()))
+                fprintf(stderr, "Could not load configuration file %s.\n", path->c_str());
+        }
+
+        //Initialise each DOSBox module based on the loaded configuration.
+        control->Init();
+
+        headless_didInitialize();
+
+		//Start up the main machine.
+		control->StartUp();
+	}
+	catch (char *errMessage)
+	{
+        fprintf(stderr, "DOSBox aborted with the following error: %s\n", errMessage);
+        status = EXIT_FAILURE;
+	}
+    catch (std::exception &e)
+    {
+        fprintf(stderr, "DOSBox aborted with the following error: %s\n", e.what());
+        status = EXIT_FAILURE;
+    }
+	catch (int)
+	{
+		//This means that something pressed the killswitch in DOSBox and we should shut down normally.
+	}
+
+    headless_didFinish();
+
+    if (!headlessSettings.screenshotPath.empty() && !headless_writeScreenshot(headlessSettings.screenshotPath.c_str()))
+        fprintf(stderr, "Could not write screenshot to %s.\n", headlessSettings.screenshotPath.c_str());
+
+	//Clean up after DOSBox finishes.
+	SDL_Quit();
+    control = NULL;
+
+    if (headlessSettings.audioOutput) fclose(headlessSettings.audioOutput);
+
+    _printReport();
+    return status;
+}